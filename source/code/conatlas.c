@@ -0,0 +1,1077 @@
+/* conatlas.c : pack a skyculture's constellation art into one texture.
+
+   Each of 'data/constellation/{arabic,chinese,hevelius,romanian}' holds
+a few dozen PNGs,  128 to 1024 pixels square.  Loaded one by one,  each
+is a separate RGBA texture :  4 bytes a pixel (plus a third again for
+mipmaps),  a file read and an upload apiece,  and switching skycultures
+means doing it all again.  This packs a whole directory,  offline,  into
+
+   atlas.dds     one block-compressed texture (BC1,  or BC3 if any
+                 image has alpha),  with a full mipmap chain
+   atlas.idx     where each image went,  one text line apiece
+
+so a viewer can read one file and make one upload per skyculture,  at
+half a byte a pixel (BC1) or one byte (BC3).  Astromifs itself doesn't
+read atlases yet :  its only constellation art is the tree views'
+thumbnails,  which 'uThumbnailCache.pas' decodes from the PNGs.  The PNG
+decoder and the name matching here are also what 'conchart' uses.
+
+   Usage:  conatlas [-m max_size] [-f bc1|bc3] [-n names_dir] [-v] directory
+
+   -m caps the atlas side (default 8192;  if the images don't fit,  the
+largest ones are halved until they do).  -f forces a format instead of
+picking one from the images' alpha.  -n gives the directory holding
+'ConstNames.dat' and 'ConstShortNames.dat' (default:  the parent of
+'directory').  -v lists where each image went.
+
+   The images are all power-of-two squares,  so packing is exact and
+needs no search :  sorted largest first and laid out in Morton (Z)
+order,  each lands on a block aligned to its own size,  and the blocks
+tile the atlas with no gaps.  The same alignment keeps the mipmaps
+clean :  a box filter never mixes two images until an image is down to
+a single pixel,  far below anything visible.  The atlas is square,  or
+twice as wide as high when that's enough.
+
+   Each line of 'atlas.idx' is
+
+   key x y width height file
+
+in pixels of the top level,  with y counted from the first row in the
+file (which is also t = 0 once uploaded;  compressed data isn't
+flipped).  The key is the abbreviation from 'ConstShortNames.dat' when
+the file is named by abbreviation ('And.png') or by Latin name
+('canes-venatici.png'),  and otherwise the file name without '.png'
+(asterisms,  the Romanian folk figures).  The first line is a comment
+giving the atlas size,  format and level count.
+
+   PNG decoding is built in (8-bit images of any colour type,  not
+interlaced,  which covers everything in 'data/constellation'),  so this
+needs only a C compiler. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <math.h>
+#include <dirent.h>
+
+#define MAX_IMAGES      256
+#define MAX_NAME        80
+
+typedef struct
+   {
+   char file[MAX_NAME], key[MAX_NAME];
+   int size, x, y;            /* square,  'size' pixels */
+   uint8_t *rgba;
+   int has_alpha;
+   } image_t;
+
+/* ---------------------------------------------------------------- */
+/* Inflate (RFC 1951),  the minimum PNG needs :  the whole stream is in */
+/* memory and so is the output buffer,  sized from the image header.    */
+
+typedef struct
+   {
+   const uint8_t *in;
+   size_t in_len, in_pos;
+   uint32_t bit_buf;
+   int bit_cnt;
+   uint8_t *out;
+   size_t out_len, out_pos;
+   } inflate_t;
+
+typedef struct
+   {
+   short count[16];           /* codes of each length */
+   short symbol[288];         /* symbols,  ordered by code */
+   } huffman_t;
+
+static int get_bits( inflate_t *s, const int n_bits)
+{
+   uint32_t rval;
+
+   while( s->bit_cnt < n_bits)
+      {
+      if( s->in_pos >= s->in_len)
+         return( -1);
+      s->bit_buf |= (uint32_t)s->in[s->in_pos++] << s->bit_cnt;
+      s->bit_cnt += 8;
+      }
+   rval = s->bit_buf & ((1u << n_bits) - 1u);
+   s->bit_buf >>= n_bits;
+   s->bit_cnt -= n_bits;
+   return( (int)rval);
+}
+
+static int build_huffman( huffman_t *h, const uint8_t *lengths, const int n)
+{
+   short offsets[16];
+   int i;
+
+   memset( h->count, 0, sizeof( h->count));
+   for( i = 0; i < n; i++)
+      h->count[lengths[i]]++;
+   h->count[0] = 0;
+   offsets[1] = 0;
+   for( i = 1; i < 15; i++)
+      offsets[i + 1] = (short)( offsets[i] + h->count[i]);
+   for( i = 0; i < n; i++)
+      if( lengths[i])
+         h->symbol[offsets[lengths[i]]++] = (short)i;
+   return( 0);
+}
+
+/* Canonical codes of each length are consecutive,  so the symbol can
+be found a bit at a time without any tables beyond the counts. */
+
+static int decode_symbol( inflate_t *s, const huffman_t *h)
+{
+   int code = 0, first = 0, index = 0, len;
+
+   for( len = 1; len < 16; len++)
+      {
+      const int bit = get_bits( s, 1);
+
+      if( bit < 0)
+         return( -1);
+      code |= bit;
+      if( code - h->count[len] < first)
+         return( h->symbol[index + (code - first)]);
+      index += h->count[len];
+      first += h->count[len];
+      first <<= 1;
+      code <<= 1;
+      }
+   return( -1);
+}
+
+static int inflate_codes( inflate_t *s, const huffman_t *lit,
+                          const huffman_t *dist)
+{
+   static const short len_base[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13,
+            15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131,
+            163, 195, 227, 258 };
+   static const short len_extra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+            1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+   static const short dist_base[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25,
+            33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537,
+            2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+   static const short dist_extra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3,
+            4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12,
+            13, 13 };
+
+   for( ;;)
+      {
+      int symbol = decode_symbol( s, lit), extra;
+      size_t len, distance;
+
+      if( symbol < 0)
+         return( -1);
+      if( symbol < 256)
+         {
+         if( s->out_pos >= s->out_len)
+            return( -1);
+         s->out[s->out_pos++] = (uint8_t)symbol;
+         continue;
+         }
+      if( symbol == 256)
+         return( 0);
+      symbol -= 257;
+      if( symbol >= 29 || (extra = get_bits( s, len_extra[symbol])) < 0)
+         return( -1);
+      len = (size_t)( len_base[symbol] + extra);
+      symbol = decode_symbol( s, dist);
+      if( symbol < 0 || symbol >= 30
+                  || (extra = get_bits( s, dist_extra[symbol])) < 0)
+         return( -1);
+      distance = (size_t)( dist_base[symbol] + extra);
+      if( distance > s->out_pos || len > s->out_len - s->out_pos)
+         return( -1);
+      while( len--)
+         {
+         s->out[s->out_pos] = s->out[s->out_pos - distance];
+         s->out_pos++;
+         }
+      }
+}
+
+static int inflate_dynamic( inflate_t *s)
+{
+   static const uint8_t order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5,
+                                      11, 4, 12, 3, 13, 2, 14, 1, 15 };
+   uint8_t lengths[320];
+   huffman_t lit, dist;
+   const int n_lit = get_bits( s, 5) + 257;
+   const int n_dist = get_bits( s, 5) + 1;
+   const int n_code = get_bits( s, 4) + 4;
+   int i;
+
+   if( n_lit > 286 || n_dist > 30 || n_code < 4)
+      return( -1);
+   memset( lengths, 0, sizeof( lengths));
+   for( i = 0; i < n_code; i++)
+      {
+      const int len = get_bits( s, 3);
+
+      if( len < 0)
+         return( -1);
+      lengths[order[i]] = (uint8_t)len;
+      }
+   build_huffman( &lit, lengths, 19);
+   for( i = 0; i < n_lit + n_dist; )
+      {
+      int symbol = decode_symbol( s, &lit), repeat;
+      uint8_t value = 0;
+
+      if( symbol < 0)
+         return( -1);
+      if( symbol < 16)
+         {
+         lengths[i++] = (uint8_t)symbol;
+         continue;
+         }
+      if( symbol == 16)
+         {
+         if( !i)
+            return( -1);
+         value = lengths[i - 1];
+         repeat = 3 + get_bits( s, 2);
+         }
+      else if( symbol == 17)
+         repeat = 3 + get_bits( s, 3);
+      else
+         repeat = 11 + get_bits( s, 7);
+      if( repeat < 3 || i + repeat > n_lit + n_dist)
+         return( -1);
+      while( repeat--)
+         lengths[i++] = value;
+      }
+   build_huffman( &lit, lengths, n_lit);
+   build_huffman( &dist, lengths + n_lit, n_dist);
+   return( inflate_codes( s, &lit, &dist));
+}
+
+static int inflate_fixed( inflate_t *s)
+{
+   static huffman_t lit, dist;
+   static int built = 0;
+
+   if( !built)
+      {
+      uint8_t lengths[288];
+      int i;
+
+      for( i = 0; i < 288; i++)
+         lengths[i] = (uint8_t)( i < 144 ? 8 : (i < 256 ? 9 : (i < 280 ? 7 : 8)));
+      build_huffman( &lit, lengths, 288);
+      for( i = 0; i < 30; i++)
+         lengths[i] = 5;
+      build_huffman( &dist, lengths, 30);
+      built = 1;
+      }
+   return( inflate_codes( s, &lit, &dist));
+}
+
+static int inflate_stored( inflate_t *s)
+{
+   size_t len;
+
+   s->bit_buf = 0;         /* skip to a byte boundary */
+   s->bit_cnt = 0;
+   if( s->in_pos + 4 > s->in_len)
+      return( -1);
+   len = s->in[s->in_pos] | (s->in[s->in_pos + 1] << 8);
+   s->in_pos += 4;         /* skip the length and its complement */
+   if( len > s->in_len - s->in_pos || len > s->out_len - s->out_pos)
+      return( -1);
+   memcpy( s->out + s->out_pos, s->in + s->in_pos, len);
+   s->in_pos += len;
+   s->out_pos += len;
+   return( 0);
+}
+
+/* Inflates a zlib stream (two byte header,  no dictionary) into exactly
+'out_len' bytes.  Returns 0 on success. */
+
+static int zlib_inflate( const uint8_t *in, const size_t in_len,
+                         uint8_t *out, const size_t out_len)
+{
+   inflate_t s;
+   int last = 0, rval = 0;
+
+   if( in_len < 2 || (in[0] & 0x0f) != 8 || (in[1] & 0x20))
+      return( -1);
+   memset( &s, 0, sizeof( s));
+   s.in = in + 2;
+   s.in_len = in_len - 2;
+   s.out = out;
+   s.out_len = out_len;
+   while( !last && !rval)
+      {
+      last = get_bits( &s, 1);
+      switch( get_bits( &s, 2))
+         {
+         case 0:
+            rval = inflate_stored( &s);
+            break;
+         case 1:
+            rval = inflate_fixed( &s);
+            break;
+         case 2:
+            rval = inflate_dynamic( &s);
+            break;
+         default:
+            rval = -1;
+            break;
+         }
+      }
+   return( rval || s.out_pos != out_len ? -1 : 0);
+}
+
+/* ---------------------------------------------------------------- */
+/* PNG                                                                */
+
+static uint32_t get_be32( const uint8_t *buff)
+{
+   return( ((uint32_t)buff[0] << 24) | ((uint32_t)buff[1] << 16)
+         | ((uint32_t)buff[2] << 8) | (uint32_t)buff[3]);
+}
+
+static int paeth( const int a, const int b, const int c)
+{
+   const int p = a + b - c;
+   const int pa = abs( p - a), pb = abs( p - b), pc = abs( p - c);
+
+   return( pa <= pb && pa <= pc ? a : (pb <= pc ? b : c));
+}
+
+/* Reads an 8-bit,  non-interlaced PNG as RGBA.  Returns NULL (after
+saying why) on failure. */
+
+static uint8_t *load_png( const char *filename, int *width, int *height)
+{
+   FILE *ifile = fopen( filename, "rb");
+   uint8_t *file_data = NULL, *idat = NULL, *raw = NULL, *rgba = NULL;
+   uint8_t palette[256][4];
+   const char *err = NULL;
+   size_t file_len, pos = 8, idat_len = 0;
+   int color_type = -1, channels = 0, x, y, has_trns = 0;
+   uint32_t w = 0, h = 0;
+   uint16_t trns_key[3] = { 0, 0, 0 };
+
+   if( !ifile)
+      {
+      perror( filename);
+      return( NULL);
+      }
+   fseek( ifile, 0L, SEEK_END);
+   file_len = (size_t)ftell( ifile);
+   fseek( ifile, 0L, SEEK_SET);
+   file_data = (uint8_t *)malloc( file_len);
+   idat = (uint8_t *)malloc( file_len);
+   if( !file_data || !idat || fread( file_data, 1, file_len, ifile) != file_len)
+      err = "couldn't read";
+   fclose( ifile);
+   if( !err && (file_len < 8 || memcmp( file_data, "\x89PNG\r\n\x1a\n", 8)))
+      err = "not a PNG";
+   memset( palette, 255, sizeof( palette));
+   while( !err && pos + 12 <= file_len)
+      {
+      const uint32_t len = get_be32( file_data + pos);
+      const uint8_t *type = file_data + pos + 4, *chunk = type + 4;
+
+      if( len > file_len - pos - 12)
+         err = "truncated";
+      else if( !memcmp( type, "IHDR", 4))
+         {
+         static const int n_channels[7] = { 1, 0, 3, 1, 2, 0, 4 };
+
+         w = get_be32( chunk);
+         h = get_be32( chunk + 4);
+         color_type = chunk[9];
+         if( chunk[8] != 8 || color_type > 6 || !n_channels[color_type])
+            err = "not an 8-bit image";
+         else if( chunk[12])
+            err = "interlaced";
+         else if( !w || !h || w > 16384 || h > 16384)
+            err = "bad size";
+         else
+            channels = n_channels[color_type];
+         }
+      else if( !memcmp( type, "PLTE", 4))
+         {
+         uint32_t i;
+
+         for( i = 0; i < len / 3 && i < 256; i++)
+            memcpy( palette[i], chunk + i * 3, 3);
+         }
+      else if( !memcmp( type, "tRNS", 4))
+         {
+         uint32_t i;
+
+         has_trns = 1;
+         if( color_type == 3)
+            for( i = 0; i < len && i < 256; i++)
+               palette[i][3] = chunk[i];
+         else
+            for( i = 0; i < 3 && i * 2 + 1 < len; i++)
+               trns_key[i] = (uint16_t)( (chunk[i * 2] << 8) | chunk[i * 2 + 1]);
+         }
+      else if( !memcmp( type, "IDAT", 4))
+         {
+         memcpy( idat + idat_len, chunk, len);
+         idat_len += len;
+         }
+      else if( !memcmp( type, "IEND", 4))
+         break;
+      pos += 12 + (size_t)len;
+      }
+   if( !err && !channels)
+      err = "no header";
+   if( !err)
+      {
+      const size_t stride = (size_t)w * channels;
+
+      raw = (uint8_t *)malloc( (stride + 1) * h);
+      rgba = (uint8_t *)malloc( (size_t)w * h * 4);
+      if( !raw || !rgba)
+         err = "out of memory";
+      else if( zlib_inflate( idat, idat_len, raw, (stride + 1) * h))
+         err = "bad image data";
+      for( y = 0; !err && y < (int)h; y++)
+         {
+         uint8_t *row = raw + y * (stride + 1) + 1;
+         const uint8_t *prev = (y ? row - stride - 1 : NULL);
+         const int filter = row[-1];
+         size_t i;
+
+         for( i = 0; i < stride; i++)
+            {
+            const int a = (i >= (size_t)channels ? row[i - channels] : 0);
+            const int b = (prev ? prev[i] : 0);
+            const int c = (prev && i >= (size_t)channels ? prev[i - channels] : 0);
+
+            switch( filter)
+               {
+               case 0:
+                  break;
+               case 1:
+                  row[i] = (uint8_t)( row[i] + a);
+                  break;
+               case 2:
+                  row[i] = (uint8_t)( row[i] + b);
+                  break;
+               case 3:
+                  row[i] = (uint8_t)( row[i] + (a + b) / 2);
+                  break;
+               case 4:
+                  row[i] = (uint8_t)( row[i] + paeth( a, b, c));
+                  break;
+               default:
+                  err = "bad filter";
+                  break;
+               }
+            }
+         for( x = 0; x < (int)w; x++)
+            {
+            const uint8_t *src = row + x * channels;
+            uint8_t *dest = rgba + ((size_t)y * w + x) * 4;
+
+            switch( color_type)
+               {
+               case 0:        /* grey */
+                  dest[0] = dest[1] = dest[2] = src[0];
+                  dest[3] = (has_trns && src[0] == trns_key[0] ? 0 : 255);
+                  break;
+               case 2:        /* RGB */
+                  memcpy( dest, src, 3);
+                  dest[3] = (has_trns && src[0] == trns_key[0]
+                          && src[1] == trns_key[1] && src[2] == trns_key[2]
+                          ? 0 : 255);
+                  break;
+               case 3:        /* palette */
+                  memcpy( dest, palette[src[0]], 4);
+                  break;
+               case 4:        /* grey + alpha */
+                  dest[0] = dest[1] = dest[2] = src[0];
+                  dest[3] = src[1];
+                  break;
+               default:       /* RGBA */
+                  memcpy( dest, src, 4);
+                  break;
+               }
+            }
+         }
+      }
+   free( file_data);
+   free( idat);
+   free( raw);
+   if( err)
+      {
+      fprintf( stderr, "%s: %s\n", filename, err);
+      free( rgba);
+      return( NULL);
+      }
+   *width = (int)w;
+   *height = (int)h;
+   return( rgba);
+}
+
+/* ---------------------------------------------------------------- */
+/* Block compression.  Colour endpoints come from the principal axis  */
+/* of the block's colours (a few power iterations on the covariance),  */
+/* then each pixel takes the nearest of the four palette entries.      */
+
+static uint16_t to_565( const double *rgb)
+{
+   int i, c[3];
+
+   for( i = 0; i < 3; i++)
+      {
+      const int max = (i == 1 ? 63 : 31);
+
+      c[i] = (int)( rgb[i] * max / 255. + .5);
+      c[i] = (c[i] < 0 ? 0 : (c[i] > max ? max : c[i]));
+      }
+   return( (uint16_t)( (c[0] << 11) | (c[1] << 5) | c[2]));
+}
+
+static void from_565( const uint16_t c, int *rgb)
+{
+   const int r = c >> 11, g = (c >> 5) & 63, b = c & 31;
+
+   rgb[0] = (r << 3) | (r >> 2);
+   rgb[1] = (g << 2) | (g >> 4);
+   rgb[2] = (b << 3) | (b >> 2);
+}
+
+static void put_le( uint8_t *buff, uint32_t value, int n_bytes)
+{
+   while( n_bytes--)
+      {
+      *buff++ = (uint8_t)value;
+      value >>= 8;
+      }
+}
+
+static void encode_color_block( const uint8_t *block, uint8_t *out)
+{
+   double mean[3] = { 0., 0., 0. }, cov[6] = { 0., 0., 0., 0., 0., 0. };
+   double axis[3] = { 1., 1., 1. }, lo = 1e+30, hi = -1e+30, end[2][3];
+   int i, j, palette[4][3];
+   uint16_t c0, c1;
+   uint32_t indices = 0;
+
+   for( i = 0; i < 16; i++)
+      for( j = 0; j < 3; j++)
+         mean[j] += block[i * 4 + j] / 16.;
+   for( i = 0; i < 16; i++)
+      {
+      const double r = block[i * 4] - mean[0];
+      const double g = block[i * 4 + 1] - mean[1];
+      const double b = block[i * 4 + 2] - mean[2];
+
+      cov[0] += r * r;
+      cov[1] += r * g;
+      cov[2] += r * b;
+      cov[3] += g * g;
+      cov[4] += g * b;
+      cov[5] += b * b;
+      }
+   for( i = 0; i < 8; i++)
+      {
+      const double x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+      const double y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+      const double z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+      double len = x * x + y * y + z * z;
+
+      if( len < 1e-12)     /* flat block:  any axis will do */
+         break;
+      len = 1. / sqrt( len);
+      axis[0] = x * len;
+      axis[1] = y * len;
+      axis[2] = z * len;
+      }
+   for( i = 0; i < 16; i++)
+      {
+      double t = 0.;
+
+      for( j = 0; j < 3; j++)
+         t += (block[i * 4 + j] - mean[j]) * axis[j];
+      if( lo > t)
+         lo = t;
+      if( hi < t)
+         hi = t;
+      }
+   for( j = 0; j < 3; j++)
+      {
+      end[0][j] = mean[j] + hi * axis[j];
+      end[1][j] = mean[j] + lo * axis[j];
+      }
+   c0 = to_565( end[0]);
+   c1 = to_565( end[1]);
+   if( c0 < c1)               /* c0 > c1 selects four-colour mode */
+      {
+      const uint16_t tval = c0;
+
+      c0 = c1;
+      c1 = tval;
+      }
+   from_565( c0, palette[0]);
+   from_565( c1, palette[1]);
+   for( j = 0; j < 3; j++)
+      {
+      palette[2][j] = (2 * palette[0][j] + palette[1][j]) / 3;
+      palette[3][j] = (palette[0][j] + 2 * palette[1][j]) / 3;
+      }
+   if( c0 != c1)        /* if equal,  index 0 everywhere is exact enough */
+      for( i = 15; i >= 0; i--)
+         {
+         int best = 0, best_dist = 1 << 30, k;
+
+         for( k = 0; k < 4; k++)
+            {
+            int dist = 0;
+
+            for( j = 0; j < 3; j++)
+               {
+               const int d = block[i * 4 + j] - palette[k][j];
+
+               dist += d * d;
+               }
+            if( best_dist > dist)
+               {
+               best_dist = dist;
+               best = k;
+               }
+            }
+         indices = (indices << 2) | (uint32_t)best;
+         }
+   put_le( out, c0, 2);
+   put_le( out + 2, c1, 2);
+   put_le( out + 4, indices, 4);
+}
+
+static void encode_alpha_block( const uint8_t *block, uint8_t *out)
+{
+   int a0 = 0, a1 = 255, i, k, palette[8];
+   uint64_t indices = 0;
+
+   for( i = 0; i < 16; i++)
+      {
+      if( a0 < block[i * 4 + 3])
+         a0 = block[i * 4 + 3];
+      if( a1 > block[i * 4 + 3])
+         a1 = block[i * 4 + 3];
+      }
+   palette[0] = a0;           /* a0 > a1:  six interpolated values */
+   palette[1] = a1;
+   for( k = 1; k < 7; k++)
+      palette[k + 1] = ((7 - k) * a0 + k * a1) / 7;
+   if( a0 != a1)
+      for( i = 15; i >= 0; i--)
+         {
+         int best = 0, best_dist = 256;
+
+         for( k = 0; k < 8; k++)
+            {
+            const int dist = abs( block[i * 4 + 3] - palette[k]);
+
+            if( best_dist > dist)
+               {
+               best_dist = dist;
+               best = k;
+               }
+            }
+         indices = (indices << 3) | (uint64_t)best;
+         }
+   out[0] = (uint8_t)a0;
+   out[1] = (uint8_t)a1;
+   put_le( out + 2, (uint32_t)indices, 4);
+   put_le( out + 6, (uint32_t)( indices >> 32), 2);
+}
+
+/* Compresses a whole level;  blocks past the edge of a level smaller
+than 4 pixels repeat its last row/column. */
+
+static void compress_level( const uint8_t *rgba, const int width,
+                            const int height, const int bc3, uint8_t *out)
+{
+   int bx, by, x, y;
+
+   for( by = 0; by < height; by += 4)
+      for( bx = 0; bx < width; bx += 4)
+         {
+         uint8_t block[64];
+
+         for( y = 0; y < 4; y++)
+            for( x = 0; x < 4; x++)
+               {
+               const int sx = (bx + x < width ? bx + x : width - 1);
+               const int sy = (by + y < height ? by + y : height - 1);
+
+               memcpy( block + (y * 4 + x) * 4,
+                       rgba + ((size_t)sy * width + sx) * 4, 4);
+               }
+         if( bc3)
+            {
+            encode_alpha_block( block, out);
+            out += 8;
+            }
+         encode_color_block( block, out);
+         out += 8;
+         }
+}
+
+/* ---------------------------------------------------------------- */
+
+static void halve( const uint8_t *src, const int width, const int height,
+                   uint8_t *dest)
+{
+   const int w2 = (width > 1 ? width / 2 : 1), h2 = (height > 1 ? height / 2 : 1);
+   const int dx = (width > 1 ? 4 : 0);
+   const size_t dy = (height > 1 ? (size_t)width * 4 : 0);
+   int x, y, i;
+
+   for( y = 0; y < h2; y++)
+      for( x = 0; x < w2; x++)
+         {
+         const uint8_t *p = src + ((size_t)y * 2 * width + x * 2) * 4;
+
+         for( i = 0; i < 4; i++)
+            *dest++ = (uint8_t)( (p[i] + p[i + dx] + p[i + dy]
+                                + p[i + dx + dy] + 2) / 4);
+         }
+}
+
+/* Spreads the bits of n over the even bits of the result,  and back. */
+
+static uint32_t compact_bits( uint64_t n)
+{
+   uint32_t rval = 0;
+   int bit;
+
+   for( bit = 0; bit < 32; bit++)
+      rval |= (uint32_t)( (n >> (2 * bit)) & 1) << bit;
+   return( rval);
+}
+
+static int compare_images( const void *a, const void *b)
+{
+   const image_t *ia = (const image_t *)a, *ib = (const image_t *)b;
+
+   if( ia->size != ib->size)
+      return( ib->size - ia->size);
+   return( strcmp( ia->key, ib->key));
+}
+
+static int compare_names( const void *a, const void *b)
+{
+   return( strcmp( (const char *)a, (const char *)b));
+}
+
+/* Other spellings in the art directories,  squashed as below. */
+
+static const char *aliases[][2] = {
+         { "horlogium", "horologium" },
+         { "piscisvolans", "volans" },
+         { "serpentarius", "ophiuchus" },
+         { "toucan", "tucana" },
+         { "triangulumaustrale", "triangulumaustralis" } };
+
+/* Lower case,  letters only:  'Canes Venatici' and 'canes-venatici'
+both become 'canesvenatici'. */
+
+static void squash_name( const char *name, char *out)
+{
+   while( *name && *name != '\r' && *name != '\n')
+      {
+      if( isalpha( (unsigned char)*name))
+         *out++ = (char)tolower( (unsigned char)*name);
+      name++;
+      }
+   *out = '\0';
+}
+
+static int same_abbreviation( const char *a, const char *b)
+{
+   while( *a && tolower( (unsigned char)*a) == tolower( (unsigned char)*b))
+      a++, b++;
+   return( !*a && !*b);
+}
+
+static int read_lines( const char *filename, char lines[][MAX_NAME],
+                       const int max_lines)
+{
+   FILE *ifile = fopen( filename, "rb");
+   char buff[200];
+   int n = 0;
+
+   if( !ifile)
+      {
+      perror( filename);
+      return( -1);
+      }
+   while( n < max_lines && fgets( buff, sizeof( buff), ifile))
+      {
+      char *tptr = buff;
+
+      if( !n && !memcmp( tptr, "\xef\xbb\xbf", 3))     /* UTF-8 BOM */
+         tptr += 3;
+      tptr[strcspn( tptr, "\r\n")] = '\0';
+      if( strlen( tptr) >= MAX_NAME)
+         {
+         fprintf( stderr, "%s: line %d is too long\n", filename, n + 1);
+         fclose( ifile);
+         return( -1);
+         }
+      strcpy( lines[n++], tptr);
+      }
+   fclose( ifile);
+   return( n);
+}
+
+static void write_dds_header( FILE *ofile, const int width, const int height,
+                              const int n_levels, const int bc3)
+{
+   uint8_t header[128];
+   const size_t top_size = (size_t)( (width + 3) / 4) * ((height + 3) / 4)
+                              * (bc3 ? 16 : 8);
+
+   memset( header, 0, sizeof( header));
+   memcpy( header, "DDS ", 4);
+   put_le( header + 4, 124, 4);
+   put_le( header + 8, 0x000a1007, 4);    /* caps, size, format, mips, */
+   put_le( header + 12, (uint32_t)height, 4);      /* linear size */
+   put_le( header + 16, (uint32_t)width, 4);
+   put_le( header + 20, (uint32_t)top_size, 4);
+   put_le( header + 28, (uint32_t)n_levels, 4);
+   put_le( header + 76, 32, 4);           /* pixel format size */
+   put_le( header + 80, 4, 4);            /* DDPF_FOURCC */
+   memcpy( header + 84, bc3 ? "DXT5" : "DXT1", 4);
+   put_le( header + 108, 0x00401008, 4);  /* complex, texture, mipmap */
+   fwrite( header, sizeof( header), 1, ofile);
+}
+
+int main( const int argc, const char **argv)
+{
+   static image_t images[MAX_IMAGES];
+   static char names[88][MAX_NAME], abbrs[88][MAX_NAME];
+   static char files[MAX_IMAGES][MAX_NAME];
+   const char *dir_name = NULL, *names_dir = NULL;
+   char path[512], squashed[MAX_NAME], squashed2[MAX_NAME];
+   int max_size = 8192, format = -1, verbose = 0, n_images = 0, n_files = 0;
+   int n_names, i, j, has_alpha = 0, width, height, n_levels, level;
+   uint64_t area = 0, offset = 0;
+   uint8_t *atlas, *next, *packed;
+   FILE *ofile;
+   DIR *dir;
+   struct dirent *entry;
+
+   for( i = 1; i < argc; i++)
+      if( !strcmp( argv[i], "-m") && i + 1 < argc)
+         max_size = atoi( argv[++i]);
+      else if( !strcmp( argv[i], "-f") && i + 1 < argc)
+         format = !strcmp( argv[++i], "bc3");
+      else if( !strcmp( argv[i], "-n") && i + 1 < argc)
+         names_dir = argv[++i];
+      else if( !strcmp( argv[i], "-v"))
+         verbose = 1;
+      else if( !dir_name && argv[i][0] != '-')
+         dir_name = argv[i];
+      else
+         dir_name = NULL, i = argc;
+   if( !dir_name)
+      {
+      fprintf( stderr, "Usage:  conatlas [-m max_size] [-f bc1|bc3] "
+                       "[-n names_dir] [-v] directory\n");
+      return( -1);
+      }
+
+   if( names_dir)
+      snprintf( path, sizeof( path), "%s/ConstNames.dat", names_dir);
+   else
+      snprintf( path, sizeof( path), "%s/../ConstNames.dat", dir_name);
+   n_names = read_lines( path, names, 88);
+   strcpy( strrchr( path, '/') + 1, "ConstShortNames.dat");
+   if( n_names < 0 || read_lines( path, abbrs, 88) != n_names)
+      {
+      fprintf( stderr, "Need matching ConstNames.dat and ConstShortNames.dat\n");
+      return( -1);
+      }
+
+   if( !(dir = opendir( dir_name)))
+      {
+      perror( dir_name);
+      return( -1);
+      }
+   while( (entry = readdir( dir)) != NULL && n_files < MAX_IMAGES)
+      {
+      const size_t len = strlen( entry->d_name);
+
+      if( len > 4 && len < MAX_NAME
+                  && !strcmp( entry->d_name + len - 4, ".png"))
+         strcpy( files[n_files++], entry->d_name);
+      }
+   closedir( dir);
+   qsort( files, n_files, MAX_NAME, compare_names);
+
+   for( i = 0; i < n_files; i++)
+      {
+      image_t *img = images + n_images;
+      int w, h;
+
+      if( snprintf( path, sizeof( path), "%s/%s", dir_name, files[i])
+                     >= (int)sizeof( path))
+         {
+         fprintf( stderr, "%s/%s: path too long\n", dir_name, files[i]);
+         return( -1);
+         }
+      if( !(img->rgba = load_png( path, &w, &h)))
+         return( -1);
+      if( w != h || (w & (w - 1)) || w < 4)
+         {
+         fprintf( stderr, "%s: %d x %d isn't a power-of-two square\n",
+                  path, w, h);
+         return( -1);
+         }
+      strcpy( img->file, files[i]);
+      strcpy( img->key, files[i]);
+      img->key[strlen( img->key) - 4] = '\0';
+      squash_name( img->key, squashed);
+      for( j = 0; j < (int)( sizeof( aliases) / sizeof( aliases[0])); j++)
+         if( !strcmp( squashed, aliases[j][0]))
+            strcpy( squashed, aliases[j][1]);
+      for( j = 0; j < n_names; j++)
+         {
+         squash_name( names[j], squashed2);
+         if( !strcmp( squashed, squashed2) || same_abbreviation( img->key,
+                                                                  abbrs[j]))
+            {
+            strcpy( img->key, abbrs[j]);
+            break;
+            }
+         }
+      img->size = w;
+      for( j = 0; j < w * h; j++)
+         if( img->rgba[j * 4 + 3] != 255)
+            img->has_alpha = 1;
+      has_alpha |= img->has_alpha;
+      n_images++;
+      }
+   if( !n_images)
+      {
+      fprintf( stderr, "No PNGs in %s\n", dir_name);
+      return( -1);
+      }
+   if( format < 0)
+      format = has_alpha;
+
+         /* Find the atlas size,  halving the biggest images if need be */
+   for( ;;)
+      {
+      int largest = 0;
+
+      area = 0;
+      for( i = 0; i < n_images; i++)
+         {
+         area += (uint64_t)images[i].size * images[i].size;
+         if( largest < images[i].size)
+            largest = images[i].size;
+         }
+      for( width = 4; (uint64_t)width * width < area || width < largest; )
+         width *= 2;
+      height = width;
+      if( area <= (uint64_t)width * width / 2 && largest <= width / 2)
+         height = width / 2;
+      if( width <= max_size || largest <= 4)
+         break;
+      for( i = 0; i < n_images; i++)
+         if( images[i].size == largest)
+            {
+            uint8_t *smaller = (uint8_t *)malloc(
+                     (size_t)largest * largest);      /* (size/2)^2 * 4 */
+
+            halve( images[i].rgba, largest, largest, smaller);
+            free( images[i].rgba);
+            images[i].rgba = smaller;
+            images[i].size = largest / 2;
+            fprintf( stderr, "%s halved to %d pixels to fit\n",
+                     images[i].file, largest / 2);
+            }
+      }
+
+   qsort( images, n_images, sizeof( image_t), compare_images);
+   atlas = (uint8_t *)calloc( (size_t)width * height, 4);
+   next = (uint8_t *)malloc( (size_t)width * height);   /* level 1 */
+   packed = (uint8_t *)malloc( (size_t)width * height);  /* BC3 top level */
+   if( !atlas || !next || !packed)
+      {
+      fprintf( stderr, "Out of memory\n");
+      return( -1);
+      }
+         /* Morton order:  bit 2k of the offset is bit k of x,  2k+1 of y */
+   for( i = 0; i < n_images; i++)
+      {
+      image_t *img = images + i;
+
+      img->x = (int)compact_bits( offset);
+      img->y = (int)compact_bits( offset >> 1);
+      for( j = 0; j < img->size; j++)
+         memcpy( atlas + ((size_t)( img->y + j) * width + img->x) * 4,
+                 img->rgba + (size_t)j * img->size * 4, (size_t)img->size * 4);
+      offset += (uint64_t)img->size * img->size;
+      free( img->rgba);
+      }
+
+   for( n_levels = 1; (width >> (n_levels - 1)) > 1
+                   || (height >> (n_levels - 1)) > 1; n_levels++)
+      ;
+   snprintf( path, sizeof( path), "%s/atlas.dds", dir_name);
+   if( !(ofile = fopen( path, "wb")))
+      {
+      perror( path);
+      return( -1);
+      }
+   write_dds_header( ofile, width, height, n_levels, format);
+   for( level = 0; level < n_levels; level++)
+      {
+      const int w = (width >> level ? width >> level : 1);
+      const int h = (height >> level ? height >> level : 1);
+      uint8_t *tptr;
+
+      compress_level( atlas, w, h, format, packed);
+      fwrite( packed, ((w + 3) / 4) * ((h + 3) / 4) * (format ? 16 : 8),
+              1, ofile);
+      halve( atlas, w, h, next);
+      tptr = atlas;
+      atlas = next;
+      next = tptr;
+      }
+   fclose( ofile);
+   free( atlas);
+   free( next);
+   free( packed);
+
+   snprintf( path, sizeof( path), "%s/atlas.idx", dir_name);
+   if( !(ofile = fopen( path, "w")))
+      {
+      perror( path);
+      return( -1);
+      }
+   fprintf( ofile, "# atlas.dds %d x %d, %s, %d levels\n", width, height,
+            format ? "BC3" : "BC1", n_levels);
+   for( i = 0; i < n_images; i++)
+      fprintf( ofile, "%s %d %d %d %d %s\n", images[i].key, images[i].x,
+               images[i].y, images[i].size, images[i].size, images[i].file);
+   fclose( ofile);
+   if( verbose)
+      for( i = 0; i < n_images; i++)
+         printf( "%-12s %5d %5d %4d  %s\n", images[i].key, images[i].x,
+                 images[i].y, images[i].size, images[i].file);
+   printf( "%d images,  %d x %d %s atlas,  %d levels,  %.1f%% used\n",
+           n_images, width, height, format ? "BC3" : "BC1", n_levels,
+           100. * (double)area / ((double)width * height));
+   return( 0);
+}
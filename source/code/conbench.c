@@ -0,0 +1,154 @@
+/* conbench.c : time the three ways we have of finding constellations.
+
+   (1) The per-point scan over 'data[]' in 'constel.c'.
+   (2) constellation_index_at( ),  one point at a time.
+   (3) constellation_classify( ),  the SoA batch version.
+
+   Usage:  conbench [n_points | file.stars] [n_passes]
+
+   With a number,  that many points are scattered uniformly over the
+sphere.  With a file name,  positions are read from a GLScene star file
+such as 'data/catalog/hipparcos.stars' (six-byte records:  RA*100 as a
+word,  dec*100 as a smallint,  then B-V and magnitude bytes).  The
+positions are J2000 and are used as if they were B1875;  that doesn't
+matter for timing.
+
+   (2) and (3) must agree exactly;  (1) uses single-precision boundaries
+and may differ for points within ~1e-5 degree of a boundary,  so those
+differences are only counted.  'constel.c' is built in with its main( )
+renamed,  so this tool always compares against the real table. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "conbound.h"
+
+#define main constel_main
+#include "constel.c"
+#undef main
+
+static const char *constel_scan( const float ra, const float de)
+{
+   const ROW *pr, *pe = data + ITEMS( data);
+
+   for( pr = data + 1; pr < pe; pr++)
+      if( ra >= pr->ral && ra < pr->rau && de >= pr->del)
+         return( pr->cst);
+   return( "???");
+}
+
+static size_t load_stars( const char *filename, float **ra, float **dec)
+{
+   FILE *ifile = fopen( filename, "rb");
+   unsigned char rec[6];
+   size_t n = 0, n_alloced = 0;
+
+   if( !ifile)
+      return( 0);
+   while( fread( rec, 6, 1, ifile) == 1)
+      {
+      if( n == n_alloced)
+         {
+         n_alloced = (n_alloced ? n_alloced * 2 : 65536);
+         *ra = (float *)realloc( *ra, n_alloced * sizeof( float));
+         *dec = (float *)realloc( *dec, n_alloced * sizeof( float));
+         }
+      (*ra)[n] = (float)(rec[0] | (rec[1] << 8)) / 100.f;
+      (*dec)[n] = (float)(int16_t)(rec[2] | (rec[3] << 8)) / 100.f;
+      n++;
+      }
+   fclose( ifile);
+   return( n);
+}
+
+static double seconds_since( const clock_t t0)
+{
+   return( (double)( clock( ) - t0) / (double)CLOCKS_PER_SEC);
+}
+
+int main( const int argc, const char **argv)
+{
+   const int n_passes = (argc > 2 ? atoi( argv[2]) : 5);
+   float *ra = NULL, *dec = NULL;
+   uint8_t *idx;
+   size_t i, n = 0, n_mismatch = 0, n_differ = 0;
+   int pass;
+   long checksum = 0;
+   clock_t t0;
+   double t_scan, t_single, t_batch;
+
+   if( argc > 1 && !atol( argv[1]))
+      {
+      n = load_stars( argv[1], &ra, &dec);
+      if( !n)
+         {
+         fprintf( stderr, "Couldn't read stars from '%s'\n", argv[1]);
+         return( -1);
+         }
+      }
+   else
+      {
+      n = (argc > 1 ? (size_t)atol( argv[1]) : 1000000);
+      ra = (float *)malloc( n * sizeof( float));
+      dec = (float *)malloc( n * sizeof( float));
+      srand( 1);
+      for( i = 0; i < n; i++)
+         {
+         ra[i] = (float)( 360. * rand( ) / ((double)RAND_MAX + 1.));
+         dec[i] = (float)( asin( 2. * rand( ) / (double)RAND_MAX - 1.)
+                                     * 180. / 3.14159265358979323846);
+         }
+      }
+   idx = (uint8_t *)malloc( n);
+
+   t0 = clock( );
+   for( pass = 0; pass < n_passes; pass++)
+      for( i = 0; i < n; i++)
+         checksum += *constel_scan( ra[i], dec[i]);
+   t_scan = seconds_since( t0);
+
+   t0 = clock( );
+   for( pass = 0; pass < n_passes; pass++)
+      for( i = 0; i < n; i++)
+         checksum += constellation_index_at( ra[i], dec[i]);
+   t_single = seconds_since( t0);
+
+   t0 = clock( );
+   for( pass = 0; pass < n_passes; pass++)
+      {
+      constellation_classify( ra, dec, idx, n);
+      checksum += idx[pass % n];
+      }
+   t_batch = seconds_since( t0);
+
+   for( i = 0; i < n; i++)
+      {
+      const int idx1 = constellation_index_at( ra[i], dec[i]);
+
+      if( idx1 != (idx[i] == CONSTELL_IDX_NONE ? -1 : (int)idx[i]))
+         n_mismatch++;
+      if( strcmp( constellation_name( idx1), constel_scan( ra[i], dec[i])))
+         n_differ++;
+      }
+
+   printf( "%lu points x %d passes (checksum %ld)\n",
+               (unsigned long)n, n_passes, checksum);
+   printf( "constel.c scan       %9.2f ns/point\n",
+               t_scan * 1e+9 / ((double)n * n_passes));
+   printf( "packed, per point    %9.2f ns/point  (%.1fx)\n",
+               t_single * 1e+9 / ((double)n * n_passes), t_scan / t_single);
+   printf( "packed, batch        %9.2f ns/point  (%.1fx)\n",
+               t_batch * 1e+9 / ((double)n * n_passes), t_scan / t_batch);
+   printf( "%lu within float rounding of a boundary in constel.c\n",
+               (unsigned long)n_differ);
+   if( n_mismatch)
+      printf( "****%lu batch results differ from constellation_index_at( )!\n",
+               (unsigned long)n_mismatch);
+   free( ra);
+   free( dec);
+   free( idx);
+   return( n_mismatch ? -1 : 0);
+}
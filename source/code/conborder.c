@@ -0,0 +1,436 @@
+/* conborder.c : turn the 'constel.c' boundary rows into a line mesh.
+
+   'constel -p' describes each constellation as a pile of rectangles,
+four corners apiece.  Shared edges come out twice (once per side),  and
+the seams between rectangles of the same constellation come out too,
+so it's only good for filling areas with GNU 'graph'.  This program
+produces what a viewer actually wants to draw :  each stretch of border
+between two constellations,  once,  as a polyline.
+
+   The method is to cut the sky into cells at every RA and dec that
+appears in 'data[]',  find the constellation in each cell (cell centres
+are never on a boundary,  so the float rows don't matter),  and keep
+the cell edges with different constellations on either side.  Edges
+with the same pair of constellations are then chained into polylines.
+Runs of edges along the same meridian become one segment,  since a
+straight chord between two points on a meridian projects to the
+meridian anyway.  Runs along a parallel are subdivided every 'step'
+degrees of RA,  because a parallel is _not_ a great circle and a bare
+chord would cut the corner (by about 25' on a 30 degree run at dec 60).
+The subdivision is done in B1875,  where the borders really are
+parallels;  the points are then precessed to the output epoch.
+
+   Output is a little-endian binary file :
+
+   header     char magic[4] = "CBM1";  float epoch;
+              uint32 n_vertices;  uint32 n_indices;
+   vertices   n_vertices * { float x, y, z;
+                             uint8 constell_idx, neighbour_idx, 0, 0 }
+   indices    n_indices * uint32,  taken in pairs (GL_LINES)
+
+   Vertices are unit vectors (x toward RA=0,  z toward the north pole).
+The two constellation indices (0..87,  as in 'conbound.h') are those on
+either side of the border the vertex belongs to.  The vertex layout is
+ConstLineVertex in 'uConstellationLines.h',  so the viewer can read
+the whole thing straight into its buffers (LoadBorderMesh( )).  The
+J2000 mesh ships as 'data/constellation/ConstBorders.cbm'.
+
+   Usage:  conborder [-e epoch] [-s step] [-t [cst]] output_file
+
+   -e sets the output epoch (Julian years,  default 2000.0);  -s the
+subdivision step in degrees (default 1).  -t writes the polylines as
+"RA dec" text to stdout instead,  in degrees at the output epoch,
+optionally only those bordering one constellation :  e.g.,
+
+   conborder -t Cyg | graph -T ps -x 360 0 -y -90 90
+
+'constel.c' is built in with its main( ) renamed,  so this always works
+from the real table. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "conbound.h"
+#include "precess.h"
+
+#define main constel_main
+#include "constel.c"
+#undef main
+
+#define PI 3.1415926535897932384626433832795028841971693993751058209749445923
+
+typedef struct
+   {
+   int node[2];         /* grid node indices */
+   int pair;            /* lower constell_idx * 256 + higher one */
+   int used;
+   } edge_t;
+
+typedef struct
+   {
+   float pos[3];
+   uint8_t constell_idx, neighbour_idx, reserved[2];
+   } mesh_vertex_t;
+
+static int n_ras, n_decs;        /* grid lines */
+static float ras[2 * ITEMS( data) + 2], decs[ITEMS( data) + 2];
+static edge_t *edges;
+static int n_edges;
+static int *node_first, *node_next;   /* edge lists,  two links per edge */
+
+static int compare_floats( const void *a, const void *b)
+{
+   const float fa = *(const float *)a, fb = *(const float *)b;
+
+   return( fa < fb ? -1 : (fa > fb ? 1 : 0));
+}
+
+static int sort_unique( float *array, int n)
+{
+   int i, j;
+
+   qsort( array, n, sizeof( float), compare_floats);
+   for( i = j = 1; i < n; i++)
+      if( array[i] != array[j - 1])
+         array[j++] = array[i];
+   return( j);
+}
+
+static int constell_index( const char *abbr)
+{
+   int i;
+
+   for( i = 0; i < N_CONSTELLATIONS; i++)
+      if( !strcmp( constellation_name( i), abbr))
+         return( i);
+   return( -1);
+}
+
+/* The same scan as the position branch of constel.c's main( ). */
+
+static int constell_at( const float ra, const float de)
+{
+   const ROW *pr, *pe = data + ITEMS( data);
+
+   for( pr = data + 1; pr < pe; pr++)
+      if( ra >= pr->ral && ra < pr->rau && de >= pr->del)
+         return( constell_index( pr->cst));
+   return( -1);
+}
+
+/* Nodes sit at (RA line,  dec line).  RA lines wrap:  n_ras - 1 is the
+same meridian as 0,  so there are n_ras - 1 distinct columns. */
+
+#define N_COLS          (n_ras - 1)
+#define NODE( i, j)     ((j) * N_COLS + ((i) % N_COLS))
+#define NODE_RA( n)     ((n) % N_COLS)
+#define NODE_DEC( n)    ((n) / N_COLS)
+
+static void add_edge( const int node0, const int node1, const int c0,
+                      const int c1)
+{
+   edge_t *e = edges + n_edges;
+
+   e->node[0] = node0;
+   e->node[1] = node1;
+   e->pair = (c0 < c1 ? c0 * 256 + c1 : c1 * 256 + c0);
+   e->used = 0;
+   node_next[n_edges * 2] = node_first[node0];
+   node_first[node0] = n_edges * 2;
+   node_next[n_edges * 2 + 1] = node_first[node1];
+   node_first[node1] = n_edges * 2 + 1;
+   n_edges++;
+}
+
+static int build_edges( void)
+{
+   const int n_cols = N_COLS, n_rows = n_decs - 1;
+   int *cell = (int *)malloc( n_cols * n_rows * sizeof( int));
+   int i, j;
+
+   for( j = 0; j < n_rows; j++)
+      for( i = 0; i < n_cols; i++)
+         {
+         cell[j * n_cols + i] = constell_at( (ras[i] + ras[i + 1]) / 2.f,
+                                             (decs[j] + decs[j + 1]) / 2.f);
+         if( cell[j * n_cols + i] < 0)
+            {
+            fprintf( stderr, "No constellation at %f %f\n",
+                                 ras[i], decs[j]);
+            return( -1);
+            }
+         }
+   edges = (edge_t *)malloc( 2 * n_cols * n_rows * sizeof( edge_t));
+   node_first = (int *)malloc( n_cols * n_decs * sizeof( int));
+   node_next = (int *)malloc( 4 * n_cols * n_rows * sizeof( int));
+   for( i = 0; i < n_cols * n_decs; i++)
+      node_first[i] = -1;
+   n_edges = 0;
+   for( j = 0; j < n_rows; j++)
+      for( i = 0; i < n_cols; i++)
+         {
+         const int c = cell[j * n_cols + i];
+         const int west = cell[j * n_cols + (i + n_cols - 1) % n_cols];
+
+         if( c != west)       /* meridian at ras[i] */
+            add_edge( NODE( i, j), NODE( i, j + 1), c, west);
+         if( j && c != cell[(j - 1) * n_cols + i])    /* parallel at decs[j] */
+            add_edge( NODE( i, j), NODE( i + 1, j), c,
+                                 cell[(j - 1) * n_cols + i]);
+         }
+   free( cell);
+   return( 0);
+}
+
+/* Finds an unused edge at 'node' with the given pair,  marks it used,
+and returns the node at its other end (or -1). */
+
+static int next_node( const int node, const int pair)
+{
+   int link;
+
+   for( link = node_first[node]; link >= 0; link = node_next[link])
+      {
+      edge_t *e = edges + link / 2;
+
+      if( !e->used && e->pair == pair)
+         {
+         e->used = 1;
+         return( e->node[1 - (link & 1)]);
+         }
+      }
+   return( -1);
+}
+
+/* Signed RA step from node a to its neighbour b along a parallel. */
+
+static double ra_step( const int a, const int b)
+{
+   const int ia = NODE_RA( a), ib = NODE_RA( b);
+
+   if( ib == (ia + 1) % N_COLS)
+      return( ras[ia + 1] - ras[ia]);
+   return( -(ras[ib + 1] - ras[ib]));
+}
+
+typedef struct
+   {
+   float *ra, *dec;
+   int n, n_alloced;
+   } polyline_t;
+
+static void add_point( polyline_t *p, const double ra, const double dec)
+{
+   if( p->n == p->n_alloced)
+      {
+      p->n_alloced = (p->n_alloced ? p->n_alloced * 2 : 256);
+      p->ra = (float *)realloc( p->ra, p->n_alloced * sizeof( float));
+      p->dec = (float *)realloc( p->dec, p->n_alloced * sizeof( float));
+      }
+   p->ra[p->n] = (float)fmod( ra + 360., 360.);
+   p->dec[p->n] = (float)dec;
+   p->n++;
+}
+
+/* Turns a chain of grid nodes into B1875 points,  merging meridian runs
+and subdividing parallel runs. */
+
+static void tessellate( const int *chain, const int n_nodes,
+                        const double step, polyline_t *p)
+{
+   double ra = ras[NODE_RA( chain[0])];
+   int k = 0;
+
+   p->n = 0;
+   add_point( p, ra, decs[NODE_DEC( chain[0])]);
+   while( k < n_nodes - 1)
+      {
+      const double dec = decs[NODE_DEC( chain[k])];
+
+      if( NODE_RA( chain[k]) == NODE_RA( chain[k + 1]))
+         {                   /* meridian:  skip to the end of the run */
+         while( k < n_nodes - 1
+                     && NODE_RA( chain[k]) == NODE_RA( chain[k + 1]))
+            k++;
+         add_point( p, ra, decs[NODE_DEC( chain[k])]);
+         }
+      else
+         {
+         double delta = 0.;
+         int i, n_steps;
+
+         while( k < n_nodes - 1
+                     && NODE_DEC( chain[k]) == NODE_DEC( chain[k + 1]))
+            {
+            delta += ra_step( chain[k], chain[k + 1]);
+            k++;
+            }
+         n_steps = (int)ceil( fabs( delta) / step - 1e-9);
+         for( i = 1; i <= n_steps; i++)
+            add_point( p, ra + delta * i / n_steps, dec);
+         ra += delta;
+         }
+      }
+}
+
+int main( const int argc, const char **argv)
+{
+   double epoch = EPOCH_J2000, step = 1., matrix[9];
+   const char *output_file = NULL, *text_cst = NULL;
+   int text_mode = 0, i, j, *chain, n_polylines = 0;
+   int *back, n_back, n_fwd;
+   polyline_t p = { NULL, NULL, 0, 0 };
+   mesh_vertex_t *vertices = NULL;
+   uint32_t *indices = NULL;
+   size_t n_vertices = 0, n_indices = 0, n_alloced = 0;
+
+   for( i = 1; i < argc; i++)
+      if( argv[i][0] == '-' && argv[i][1])
+         switch( argv[i][1])
+            {
+            case 'e':
+               epoch = atof( argv[i][2] ? argv[i] + 2 : argv[++i]);
+               break;
+            case 's':
+               step = atof( argv[i][2] ? argv[i] + 2 : argv[++i]);
+               break;
+            case 't':
+               text_mode = 1;
+               if( i + 1 < argc && constell_index( argv[i + 1]) >= 0)
+                  text_cst = argv[++i];
+               break;
+            default:
+               fprintf( stderr, "Unknown option '%s'\n", argv[i]);
+               return( -1);
+            }
+      else
+         output_file = argv[i];
+   if( (!output_file && !text_mode) || step <= 0.)
+      {
+      fprintf( stderr,
+               "Usage:  conborder [-e epoch] [-s step] [-t [cst]] output_file\n");
+      return( -1);
+      }
+
+   for( i = 1, n_ras = n_decs = 0; i < (int)ITEMS( data); i++)
+      {
+      ras[n_ras++] = data[i].ral;
+      ras[n_ras++] = data[i].rau;
+      decs[n_decs++] = data[i].del;
+      }
+   decs[n_decs++] = 90.f;
+   n_ras = sort_unique( ras, n_ras);
+   n_decs = sort_unique( decs, n_decs);
+   if( ras[0] != 0.f || ras[n_ras - 1] != 360.f || decs[0] != -90.f)
+      {
+      fprintf( stderr, "Table doesn't cover the sky\n");
+      return( -1);
+      }
+   if( build_edges( ))
+      return( -1);
+
+   setup_precession( matrix, EPOCH_B1875, epoch);
+   chain = (int *)malloc( (n_edges + 1) * sizeof( int));
+   back = (int *)malloc( (n_edges + 1) * sizeof( int));
+   for( i = 0; i < n_edges; i++)
+      if( !edges[i].used)
+         {
+         const int pair = edges[i].pair;
+         const int c0 = pair >> 8, c1 = pair & 0xff;
+         int node;
+
+         edges[i].used = 1;
+         n_fwd = n_back = 0;
+         for( node = edges[i].node[1]; node >= 0; node = next_node( node, pair))
+            chain[n_fwd++] = node;
+         for( node = edges[i].node[0]; node >= 0; node = next_node( node, pair))
+            back[n_back++] = node;
+                  /* chain = reversed 'back' followed by the forward part */
+         memmove( chain + n_back, chain, n_fwd * sizeof( int));
+         for( j = 0; j < n_back; j++)
+            chain[j] = back[n_back - 1 - j];
+         tessellate( chain, n_back + n_fwd, step, &p);
+         precess_positions( matrix, p.ra, p.dec, p.ra, p.dec, (size_t)p.n);
+         n_polylines++;
+
+         if( text_mode)
+            {
+            if( !text_cst || !strcmp( text_cst, constellation_name( c0))
+                          || !strcmp( text_cst, constellation_name( c1)))
+               {
+               printf( "# %s/%s\n", constellation_name( c0),
+                                    constellation_name( c1));
+               for( j = 0; j < p.n; j++)
+                  printf( "%8.4f %+08.4f\n", p.ra[j], p.dec[j]);
+               printf( "\n");
+               }
+            continue;
+            }
+         if( n_vertices + p.n > n_alloced)
+            {
+            n_alloced = (n_vertices + p.n) * 2;
+            vertices = (mesh_vertex_t *)realloc( vertices,
+                                 n_alloced * sizeof( mesh_vertex_t));
+            indices = (uint32_t *)realloc( indices,
+                                 2 * n_alloced * sizeof( uint32_t));
+            }
+         for( j = 0; j < p.n; j++)
+            {
+            const double ra = p.ra[j] * PI / 180., dec = p.dec[j] * PI / 180.;
+            mesh_vertex_t *v = vertices + n_vertices + j;
+
+            v->pos[0] = (float)( cos( dec) * cos( ra));
+            v->pos[1] = (float)( cos( dec) * sin( ra));
+            v->pos[2] = (float)sin( dec);
+            v->constell_idx = (uint8_t)c0;
+            v->neighbour_idx = (uint8_t)c1;
+            v->reserved[0] = v->reserved[1] = 0;
+            if( j)
+               {
+               indices[n_indices++] = (uint32_t)( n_vertices + j - 1);
+               indices[n_indices++] = (uint32_t)( n_vertices + j);
+               }
+            }
+         n_vertices += p.n;
+         }
+
+   if( !text_mode)
+      {
+      FILE *ofile = fopen( output_file, "wb");
+      const float fepoch = (float)epoch;
+      const uint32_t counts[2] = { (uint32_t)n_vertices, (uint32_t)n_indices };
+
+      if( !ofile)
+         {
+         perror( output_file);
+         return( -1);
+         }
+      if( fwrite( "CBM1", 4, 1, ofile) != 1
+               || fwrite( &fepoch, sizeof( float), 1, ofile) != 1
+               || fwrite( counts, sizeof( uint32_t), 2, ofile) != 2
+               || fwrite( vertices, sizeof( mesh_vertex_t), n_vertices, ofile)
+                                 != n_vertices
+               || fwrite( indices, sizeof( uint32_t), n_indices, ofile)
+                                 != n_indices
+               || fclose( ofile))
+         {
+         perror( output_file);
+         return( -1);
+         }
+      fprintf( stderr, "%d cell edges -> %d polylines,  %u vertices,  "
+                       "%u lines\n", n_edges, n_polylines,
+                       (unsigned)n_vertices, (unsigned)n_indices / 2);
+      }
+   free( chain);
+   free( back);
+   free( edges);
+   free( node_first);
+   free( node_next);
+   free( vertices);
+   free( indices);
+   free( p.ra);
+   free( p.dec);
+   return( 0);
+}
@@ -0,0 +1,269 @@
+#include <math.h>
+#include "conbound.h"
+#include "precess.h"
+
+#if defined( __AVX2__)
+   #include <immintrin.h>
+   #define SEG_LANES    8
+#elif defined( __SSE2__) || defined( _M_X64) || (defined( _M_IX86_FP) && _M_IX86_FP >= 2)
+   #include <emmintrin.h>
+   #define SEG_LANES    4
+#else
+   #define SEG_LANES    1
+#endif
+
+/* Implementation of the lookup described in 'conbound.h'.  The table
+itself lives in 'conbound_tbl.h',  which 'constbnd' generates;  don't edit
+it,  and run 'converify' after regenerating it. */
+
+static const constbnd_t bounds[] = {
+#include "conbound_tbl.h"
+   };
+
+#define N_BOUNDS     (sizeof( bounds) / sizeof( bounds[0]))
+
+static const char names[N_CONSTELLATIONS + 1][4] = {
+   "???",
+   "And", "Ant", "Aps", "Aql", "Aqr", "Ara", "Ari", "Aur", "Boo", "Cae", "Cam",
+   "Cap", "Car", "Cas", "Cen", "Cep", "Cet", "Cha", "Cir", "CMa", "CMi", "Cnc",
+   "Col", "Com", "CrA", "CrB", "Crt", "Cru", "Crv", "CVn", "Cyg", "Del", "Dor",
+   "Dra", "Equ", "Eri", "For", "Gem", "Gru", "Her", "Hor", "Hya", "Hyi", "Ind",
+   "Lac", "Leo", "Lep", "Lib", "LMi", "Lup", "Lyn", "Lyr", "Men", "Mic", "Mon",
+   "Mus", "Nor", "Oct", "Oph", "Ori", "Pav", "Peg", "Per", "Phe", "Pic", "PsA",
+   "Psc", "Pup", "Pyx", "Ret", "Scl", "Sco", "Sct", "Ser", "Sex", "Sge", "Sgr",
+   "Tau", "Tel", "TrA", "Tri", "Tuc", "UMa", "UMi", "Vel", "Vir", "Vol", "Vul" };
+
+const char *constellation_name( const int constell_idx)
+{
+   if( constell_idx < 0 || constell_idx >= N_CONSTELLATIONS)
+      return( names[0]);
+   return( names[constell_idx + 1]);
+}
+
+const constbnd_t *constellation_bounds( size_t *n_bounds)
+{
+   if( n_bounds)
+      *n_bounds = N_BOUNDS;
+   return( bounds);
+}
+
+int constellation_index_at( const double ra, const double dec)
+{
+   double ra_sec = ra * 240.;
+   const double spd = (dec + 90.) * 60.;
+   size_t lo = 0, hi = N_BOUNDS;
+
+   if( spd < 0. || spd > 180. * 60.)
+      return( -1);
+   if( ra_sec < 0. || ra_sec >= 86400.)    /* fmod( ) is slow;  avoid it */
+      {                                     /* for the usual 0-360 range  */
+      ra_sec = fmod( ra, 360.) * 240.;
+      if( ra_sec < 0.)
+         ra_sec += 86400.;
+      }
+   {        /* Boundaries are on integer RA seconds and arcminutes, */
+            /* so truncating both (they're positive) loses nothing  */
+   const int32_t ra_s = (int32_t)ra_sec, spd_m = (int32_t)spd;
+
+            /* Find the first segment that is _not_ north of us;  all */
+            /* segments before it are,  with the nearest one last.    */
+   while( lo < hi)
+      {
+      const size_t mid = (lo + hi) / 2;
+
+      if( CONSTBND_SPD( bounds + mid) > spd_m)
+         lo = mid + 1;
+      else
+         hi = mid;
+      }
+   while( lo--)
+      {
+      const int32_t min_ra = CONSTBND_MIN_RA( bounds + lo);
+      const int32_t ra1 = ra_s + (ra_s < min_ra ? 86400 : 0);
+
+      if( ra1 < min_ra + (int32_t)bounds[lo].ra_width)
+         return( bounds[lo].constell_idx);
+      }
+   }
+   return( CONSTELL_IDX_UMI);
+}
+
+const char *constellation_at( const double ra, const double dec)
+{
+   return( constellation_name( constellation_index_at( ra, dec)));
+}
+
+void constellations_at( const double *ra, const double *dec,
+                                 const char **out, const size_t n)
+{
+   size_t i;
+
+   for( i = 0; i < n; i++)
+      out[i] = constellation_at( ra[i], dec[i]);
+}
+
+/* For constellation_classify( ),  the segments are unpacked into
+structure-of-arrays form,  with RAs and SPDs as plain 32-bit integers.
+Since all boundaries fall on integer RA seconds and SPD arcminutes,
+comparing floor(x) against them gives exactly the same answers as
+comparing x;  so each point is truncated once (both are positive),  and every segment test
+after that is integer-only.  'max_ra' is min_ra + width,  and may run
+past 86400.  SEG_LANES dummy segments (with an empty RA range) sit in
+front of the real ones,  so that the walk north can always load a full
+vector without running off the start of the array.   */
+
+typedef struct
+   {
+   int32_t spd[N_BOUNDS];
+   int32_t min_ra[SEG_LANES + N_BOUNDS];
+   int32_t max_ra[SEG_LANES + N_BOUNDS];
+   } seg_soa_t;
+
+static void unpack_bounds( seg_soa_t *soa)
+{
+   size_t i;
+
+   for( i = 0; i < SEG_LANES; i++)
+      soa->min_ra[i] = soa->max_ra[i] = 0;
+   for( i = 0; i < N_BOUNDS; i++)
+      {
+      soa->spd[i] = CONSTBND_SPD( bounds + i);
+      soa->min_ra[i + SEG_LANES] = CONSTBND_MIN_RA( bounds + i);
+      soa->max_ra[i + SEG_LANES] = soa->min_ra[i + SEG_LANES]
+                                  + (int32_t)bounds[i].ra_width;
+      }
+}
+
+/* Returns the (unpadded) index of the nearest segment north of the
+point that covers its RA,  or -1 if there isn't one. */
+
+static int walk_north( const seg_soa_t *soa, const int32_t ra_sec,
+                                 const int32_t spd)
+{
+   const int32_t *tptr = soa->spd;
+   size_t lo, len = N_BOUNDS;
+
+            /* Branch-free binary search;  catalog order is random */
+            /* enough in dec that a branchy one mispredicts a lot. */
+   while( len > 1)
+      {
+      const size_t half = len / 2;
+
+      tptr += (tptr[half] > spd ? half : 0);
+      len -= half;
+      }
+   lo = (size_t)( tptr - soa->spd) + (*tptr > spd);
+#if SEG_LANES == 8
+   {
+   const __m256i ra = _mm256_set1_epi32( ra_sec);
+   const __m256i day = _mm256_set1_epi32( 86400);
+
+   while( lo)
+      {
+      const size_t base = lo;     /* = padded index of the first lane */
+      const __m256i min_ra =
+              _mm256_loadu_si256( (const __m256i *)( soa->min_ra + base));
+      const __m256i max_ra =
+              _mm256_loadu_si256( (const __m256i *)( soa->max_ra + base));
+      const __m256i wrap = _mm256_and_si256( day,
+                           _mm256_cmpgt_epi32( min_ra, ra));
+      const __m256i hit = _mm256_cmpgt_epi32( max_ra,
+                           _mm256_add_epi32( ra, wrap));
+      int mask = _mm256_movemask_ps( _mm256_castsi256_ps( hit));
+
+      if( mask)
+         {
+         int lane = 7;
+
+         while( !(mask & (1 << lane)))
+            lane--;
+         return( (int)base + lane - SEG_LANES);
+         }
+      lo = (lo > SEG_LANES ? lo - SEG_LANES : 0);
+      }
+   }
+#elif SEG_LANES == 4
+   {
+   const __m128i ra = _mm_set1_epi32( ra_sec);
+   const __m128i day = _mm_set1_epi32( 86400);
+
+   while( lo)
+      {
+      const size_t base = lo;
+      const __m128i min_ra =
+              _mm_loadu_si128( (const __m128i *)( soa->min_ra + base));
+      const __m128i max_ra =
+              _mm_loadu_si128( (const __m128i *)( soa->max_ra + base));
+      const __m128i wrap = _mm_and_si128( day, _mm_cmpgt_epi32( min_ra, ra));
+      const __m128i hit = _mm_cmpgt_epi32( max_ra, _mm_add_epi32( ra, wrap));
+      int mask = _mm_movemask_ps( _mm_castsi128_ps( hit));
+
+      if( mask)
+         {
+         int lane = 3;
+
+         while( !(mask & (1 << lane)))
+            lane--;
+         return( (int)base + lane - SEG_LANES);
+         }
+      lo = (lo > SEG_LANES ? lo - SEG_LANES : 0);
+      }
+   }
+#else
+   while( lo--)
+      {
+      const int32_t ra1 = (ra_sec < soa->min_ra[lo + 1] ? ra_sec + 86400 : ra_sec);
+
+      if( ra1 < soa->max_ra[lo + 1])
+         return( (int)lo);
+      }
+#endif
+   return( -1);
+}
+
+void constellation_classify( const float *ra, const float *dec,
+                                 uint8_t *out, const size_t n)
+{
+   seg_soa_t soa;
+   size_t i;
+
+   unpack_bounds( &soa);
+   for( i = 0; i < n; i++)
+      {
+      double ra_sec = (double)ra[i] * 240.;
+      const double spd = ((double)dec[i] + 90.) * 60.;
+      int idx;
+
+      if( spd < 0. || spd > 180. * 60.)
+         {
+         out[i] = CONSTELL_IDX_NONE;
+         continue;
+         }
+      if( ra_sec < 0. || ra_sec >= 86400.)
+         {
+         ra_sec = fmod( (double)ra[i], 360.) * 240.;
+         if( ra_sec < 0.)
+            ra_sec += 86400.;
+         }
+      idx = walk_north( &soa, (int32_t)ra_sec, (int32_t)spd);
+      out[i] = (idx < 0 ? CONSTELL_IDX_UMI : bounds[idx].constell_idx);
+      }
+}
+
+#define J2000_BLOCK  1024
+
+void constellation_classify_j2000( const float *ra, const float *dec,
+                                 uint8_t *out, const size_t n)
+{
+   double matrix[9];
+   float ra1875[J2000_BLOCK], dec1875[J2000_BLOCK];
+   size_t i, block;
+
+   setup_precession( matrix, EPOCH_J2000, EPOCH_B1875);
+   for( i = 0; i < n; i += block)
+      {
+      block = (n - i < J2000_BLOCK ? n - i : J2000_BLOCK);
+      precess_positions( matrix, ra + i, dec + i, ra1875, dec1875, block);
+      constellation_classify( ra1875, dec1875, out + i, block);
+      }
+}
@@ -0,0 +1,91 @@
+/* conbound.h : find the constellation containing a given (B1875) RA/dec.
+
+   This replaces the linear walk over 'data[]' in 'constel.c' with the
+compacted boundary list described in 'constbnd.c'.  Only the
+"horizontal" (east/west) boundary lines are kept.  Each one is stored
+for the constellation lying directly to the _south_ of it.  The list is
+sorted by decreasing south polar distance (i.e.,  north first),  so that
+finding the constellation for a point means :
+
+(1) Binary-search the list for the first segment to the north of the
+point's SPD.
+(2) Check to see if that segment's RA range covers the given RA.  If it
+does,  we've found the constellation.
+(3) If it doesn't,  look at the preceding (more northerly) segment and
+go back to (2).  Running off the top of the list means we're in UMi.
+
+   That's O(log n) to get started,  plus a short walk,  instead of
+scanning ~360 rows per point.
+
+   Each segment packs into eight bytes :  the SPD (integer arcminutes,
+14 bits) and western RA (integer RA seconds,  17 bits) share a 32-bit
+word,  and the RA width (seconds) gets a 16-bit word.  Segments may run
+past RA=24h;  the lookup folds the RA around to handle that.
+
+   All positions are in decimal degrees,  equinox B1875,  the same as
+the position argument of 'constel.c',  except for
+constellation_classify_j2000( ),  which does the precession itself. */
+
+#ifndef CONBOUND_H_INCLUDED
+#define CONBOUND_H_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define N_CONSTELLATIONS       88
+#define CONSTELL_IDX_UMI       83
+#define CONSTELL_IDX_NONE     255
+
+typedef struct
+   {
+   uint32_t spd_ra;     /* (SPD in arcminutes << 17) | western RA in seconds */
+   uint16_t ra_width;   /* eastern RA - western RA,  in seconds */
+   uint8_t constell_idx;   /* from 0 to 87 */
+   uint8_t reserved;
+   } constbnd_t;
+
+#define CONSTBND_SPD( b)      ((int32_t)((b)->spd_ra >> 17))
+#define CONSTBND_MIN_RA( b)   ((int32_t)((b)->spd_ra & 0x1ffff))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Three-letter IAU abbreviation for constellation index 0..87,  in the
+same order as 'data/constellation/ConstShortNames.dat';  "???" for
+anything else. */
+const char *constellation_name( const int constell_idx);
+
+/* Index (0..87) of the constellation containing the B1875 position,
+or -1 if dec is outside -90..+90.  RA is reduced to 0..360. */
+int constellation_index_at( const double ra, const double dec);
+
+/* Same as above,  returning the abbreviation ("???" if out of range). */
+const char *constellation_at( const double ra, const double dec);
+
+/* Batch variant:  fills out[i] with constellation_at( ra[i], dec[i]). */
+void constellations_at( const double *ra, const double *dec,
+                                 const char **out, const size_t n);
+
+/* SoA batch classifier for whole catalogs:  out[i] gets the index of
+the constellation containing (ra[i], dec[i]),  or CONSTELL_IDX_NONE.
+The walk north tests eight (AVX2) or four (SSE2) segments per step;
+other targets use the scalar walk.  Results are identical to calling
+constellation_index_at( ) on each point.  There's a small fixed setup
+cost per call,  so hand it arrays,  not single points. */
+void constellation_classify( const float *ra, const float *dec,
+                                 uint8_t *out, const size_t n);
+
+/* As above,  but for J2000 positions (e.g.,  Hipparcos or IAU-CSN).
+They're precessed to B1875 in blocks on the way in;  see 'precess.h'. */
+void constellation_classify_j2000( const float *ra, const float *dec,
+                                 uint8_t *out, const size_t n);
+
+/* The packed segment list itself,  for code that wants to walk it. */
+const constbnd_t *constellation_bounds( size_t *n_bounds);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,337 @@
+/* Packed constellation boundary segments,  generated from the rows of
+'constel.c' (N.G. Roman, 1987PASP...99..695R).  See 'conbound.h' for
+the layout.  Do not edit by hand. */
+
+   { 0x53714370, 0x7e90, 15, 0 },   /* Cep */
+   { 0x52bc7080, 0x5b68, 10, 0 },   /* Cam */
+   { 0x52952750, 0x1c20, 15, 0 },   /* Cep */
+   { 0x5280fd20, 0x2a30, 33, 0 },   /* Dra */
+   { 0x52084650, 0x2a30, 10, 0 },   /* Cam */
+   { 0x50a080e8, 0x1518, 33, 0 },   /* Dra */
+   { 0x4fb03156, 0x14fa, 10, 0 },   /* Cam */
+   { 0x4fb09600, 0x0bb8, 33, 0 },   /* Dra */
+   { 0x4fb0bf04, 0x0ce4, 83, 0 },   /* UMi */
+   { 0x4fb0f618, 0x0708, 33, 0 },   /* Dra */
+   { 0x4fb11b98, 0x0bb8, 15, 0 },   /* Cep */
+   { 0x4e4804b0, 0x2b5c, 13, 0 },   /* Cas */
+   { 0x4e48300c, 0x014a, 10, 0 },   /* Cam */
+   { 0x4e48a1b8, 0x1518, 33, 0 },   /* Dra */
+   { 0x4e48b6d0, 0x0834, 83, 0 },   /* UMi */
+   { 0x4d58e880, 0x0d98, 33, 0 },   /* Dra */
+   { 0x4d591b98, 0x0708, 33, 0 },   /* Dra */
+   { 0x4ca47008, 0x2f58, 82, 0 },   /* UMa */
+   { 0x4b00b6d0, 0x0e10, 33, 0 },   /* Dra */
+   { 0x4b00dc50, 0x0c30, 33, 0 },   /* Dra */
+   { 0x4a102b98, 0x0474, 10, 0 },   /* Cam */
+   { 0x49991f1c, 0x0384, 15, 0 },   /* Cep */
+   { 0x495c9f60, 0x0960, 82, 0 },   /* UMa */
+   { 0x4920c4e0, 0x1770, 33, 0 },   /* Dra */
+   { 0x49214ba4, 0x0a8c, 13, 0 },   /* Cas */
+   { 0x4830a8c0, 0x1518, 82, 0 },   /* UMa */
+   { 0x47b8bdd8, 0x0ce4, 82, 0 },   /* UMa */
+   { 0x47b945c8, 0x05dc, 13, 0 },   /* Cas */
+   { 0x474055c8, 0x0ca8, 50, 0 },   /* Lyn */
+   { 0x47051940, 0x05dc, 15, 0 },   /* Cep */
+   { 0x46bf20cc, 0x00e4, 30, 0 },   /* Cyg */
+   { 0x46506270, 0x13ec, 50, 0 },   /* Lyn */
+   { 0x461515f8, 0x0ad4, 30, 0 },   /* Cyg */
+   { 0x45e34190, 0x0438, 13, 0 },   /* Cas */
+   { 0x459c1ad6, 0x0762, 62, 0 },   /* Per */
+   { 0x4561110c, 0x04ec, 30, 0 },   /* Cyg */
+   { 0x452417e8, 0x02ee, 62, 0 },   /* Per */
+   { 0x44e82238, 0x0a50, 62, 0 },   /* Per */
+   { 0x448f39d4, 0x07bc, 44, 0 },   /* Lac */
+   { 0x44704650, 0x0f78,  7, 0 },   /* Aur */
+   { 0x4434c558, 0x111c,  8, 0 },   /* Boo */
+   { 0x44350c5c, 0x04b0, 30, 0 },   /* Cyg */
+   { 0x43f82c88, 0x0258, 62, 0 },   /* Per */
+   { 0x43f93740, 0x0294, 44, 0 },   /* Lac */
+   { 0x43e521b0, 0x1338, 30, 0 },   /* Cyg */
+   { 0x43801338, 0x04b0, 62, 0 },   /* Per */
+   { 0x438055c8, 0x05a0,  7, 0 },   /* Aur */
+   { 0x4308a9ec, 0x13ec, 29, 0 },   /* CVn */
+   { 0x4308d674, 0x0708,  8, 0 },   /* Boo */
+   { 0x42eb34e8, 0x0258, 44, 0 },   /* Lac */
+   { 0x42cc2ee0, 0x131a, 62, 0 },   /* Per */
+   { 0x42cc41fa, 0x0456,  7, 0 },   /* Aur */
+   { 0x42cd4190, 0x0690,  0, 0 },   /* And */
+   { 0x4254dd7c, 0x1194, 39, 0 },   /* Her */
+   { 0x41dc1cb6, 0x06ae,  0, 0 },   /* And */
+   { 0x41dcef10, 0x1158, 39, 0 },   /* Her */
+   { 0x41a00fb4, 0x07bc,  0, 0 },   /* And */
+   { 0x41a05b68, 0x0438,  7, 0 },   /* Aur */
+   { 0x41a14820, 0x0384,  0, 0 },   /* And */
+   { 0x40ecbdd8, 0x0780, 29, 0 },   /* CVn */
+   { 0x40b00c30, 0x0384,  0, 0 },   /* And */
+   { 0x40b14ba4, 0x0834,  0, 0 },   /* And */
+   { 0x4074ff96, 0x0df2, 51, 0 },   /* Lyr */
+   { 0x40381770, 0x0546,  0, 0 },   /* And */
+   { 0x4038765c, 0x0a8c, 50, 0 },   /* Lyn */
+   { 0x3fc00258, 0x09d8,  0, 0 },   /* And */
+   { 0x3f48a8c0, 0x012c, 29, 0 },   /* CVn */
+   { 0x3f0c5fa0, 0x07f8,  7, 0 },   /* Aur */
+   { 0x3ed13416, 0x00d2, 44, 0 },   /* Lac */
+   { 0x3eb3339e, 0x0078, 44, 0 },   /* Lac */
+   { 0x3e950d88, 0x0348, 51, 0 },   /* Lyr */
+   { 0x3de080e8, 0x05dc, 50, 0 },   /* Lyn */
+   { 0x3de086c4, 0x0834, 48, 0 },   /* LMi */
+   { 0x3cf08ef8, 0x08ac, 48, 0 },   /* LMi */
+   { 0x3cf0d908, 0x0ca8, 25, 0 },   /* CrB */
+   { 0x3cd28214, 0x04b0, 48, 0 },   /* LMi */
+   { 0x3b6a1c20, 0x07f8, 80, 0 },   /* Tri */
+   { 0x3b4d103a, 0x0096, 30, 0 },   /* Cyg */
+   { 0x3b103f48, 0x02b2,  7, 0 },   /* Aur */
+   { 0x3b1131a0, 0x03c0, 61, 0 },   /* Peg */
+   { 0x3ad45be0, 0x111c, 37, 0 },   /* Gem */
+   { 0x3a9813ce, 0x0852, 80, 0 },   /* Tri */
+   { 0x3a993560, 0x0b7c, 61, 0 },   /* Peg */
+   { 0x3a5d40dc, 0x099c, 61, 0 },   /* Peg */
+   { 0x3a202418, 0x021c, 80, 0 },   /* Tri */
+   { 0x3a2097a4, 0x030c, 48, 0 },   /* LMi */
+   { 0x3a20a8c0, 0x04b0, 23, 0 },   /* Com */
+   { 0x39e46cfc, 0x0384, 37, 0 },   /* Gem */
+   { 0x39e47080, 0x1194, 21, 0 },   /* Cnc */
+   { 0x39e48214, 0x08e8, 45, 0 },   /* Leo */
+   { 0x39a80a14, 0x09ba, 66, 0 },   /* Psc */
+   { 0x39a8d584, 0x0384, 25, 0 },   /* CrB */
+   { 0x393b4a78, 0x0384, 61, 0 },   /* Peg */
+   { 0x3930ad70, 0x0ce4, 23, 0 },   /* Com */
+   { 0x38e14dfc, 0x0384, 61, 0 },   /* Peg */
+   { 0x389ac44a, 0x010e,  8, 0 },   /* Boo */
+   { 0x389021fc, 0x0d5c,  6, 0 },   /* Ari */
+   { 0x38902f58, 0x0ff0, 77, 0 },   /* Tau */
+   { 0x38403f48, 0x0384, 77, 0 },   /* Tau */
+   { 0x3840ff96, 0x02b2, 39, 0 },   /* Her */
+   { 0x38410ed2, 0x0168, 30, 0 },   /* Cyg */
+   { 0x37c89ab0, 0x0c30, 45, 0 },   /* Leo */
+   { 0x37c8a6e0, 0x01e0, 23, 0 },   /* Com */
+   { 0x37c91490, 0x1194, 87, 0 },   /* Vul */
+   { 0x378c42cc, 0x0ff0, 77, 0 },   /* Tau */
+   { 0x378c8afc, 0x08ac, 45, 0 },   /* Leo */
+   { 0x378cba54, 0x0384, 23, 0 },   /* Com */
+   { 0x378cbdd8, 0x0672,  8, 0 },   /* Boo */
+   { 0x37500000, 0x00f0, 61, 0 },   /* Peg */
+   { 0x375013ce, 0x03a2, 66, 0 },   /* Psc */
+   { 0x375052bc, 0x0924, 37, 0 },   /* Gem */
+   { 0x37506edc, 0x01a4, 21, 0 },   /* Cnc */
+   { 0x37512624, 0x0708, 87, 0 },   /* Vul */
+   { 0x37512d2c, 0x0474, 61, 0 },   /* Peg */
+   { 0x37150ed2, 0x05be, 87, 0 },   /* Vul */
+   { 0x36f61af4, 0x0708,  6, 0 },   /* Ari */
+   { 0x36d8e358, 0x0258, 39, 0 },   /* Her */
+   { 0x3660d41c, 0x0d5c, 73, 0 },   /* Ser */
+   { 0x3660e178, 0x01e0, 39, 0 },   /* Her */
+   { 0x36610248, 0x0708, 39, 0 },   /* Her */
+   { 0x3624972c, 0x0384, 45, 0 },   /* Leo */
+   { 0x36250950, 0x0582, 87, 0 },   /* Vul */
+   { 0x35e81770, 0x0384,  6, 0 },   /* Ari */
+   { 0x35520a14, 0x01e0,  0, 0 },   /* And */
+   { 0x353493a8, 0x0384, 45, 0 },   /* Leo */
+   { 0x35352ad4, 0x0258, 61, 0 },   /* Peg */
+   { 0x34e45028, 0x0294, 59, 0 },   /* Ori */
+   { 0x348000f0, 0x010e, 61, 0 },   /* Peg */
+   { 0x3480dfd4, 0x01a4, 39, 0 },   /* Her */
+   { 0x344452bc, 0x04b0, 59, 0 },   /* Ori */
+   { 0x342716e8, 0x05dc, 75, 0 },   /* Sge */
+   { 0x34130950, 0x0564, 75, 0 },   /* Sge */
+   { 0x340801fe, 0x09f6, 66, 0 },   /* Psc */
+   { 0x33cd1cc4, 0x0474, 31, 0 },   /* Del */
+   { 0x33906dce, 0x010e, 21, 0 },   /* Cnc */
+   { 0x33552138, 0x06cc, 31, 0 },   /* Del */
+   { 0x33552804, 0x02d0, 61, 0 },   /* Peg */
+   { 0x332d0eb4, 0x0834, 75, 0 },   /* Sge */
+   { 0x33182e2c, 0x012c, 77, 0 },   /* Tau */
+   { 0x32dd0950, 0x01e0,  3, 0 },   /* Aql */
+   { 0x32a05028, 0x00f0, 77, 0 },   /* Tau */
+   { 0x3264576c, 0x014a, 59, 0 },   /* Ori */
+   { 0x31c50b30, 0x0bb8,  3, 0 },   /* Aql */
+   { 0x31b045d8, 0x0528, 59, 0 },   /* Ori */
+   { 0x31b0dfd4, 0x0258, 73, 0 },   /* Ser */
+   { 0x319316e8, 0x0456,  3, 0 },   /* Aql */
+   { 0x31931b3e, 0x0186, 31, 0 },   /* Del */
+   { 0x317440ec, 0x04ec, 59, 0 },   /* Ori */
+   { 0x31744b00, 0x03c0, 59, 0 },   /* Ori */
+   { 0x3138b478, 0x0960, 85, 0 },   /* Vir */
+   { 0x30e8f294, 0x0e10, 58, 0 },   /* Oph */
+   { 0x30c0a6e0, 0x0d98, 85, 0 },   /* Vir */
+   { 0x30846978, 0x0456, 20, 0 },   /* CMi */
+   { 0x3034eb8c, 0x0708, 58, 0 },   /* Oph */
+   { 0x300c0000, 0x01fe, 66, 0 },   /* Psc */
+   { 0x300c4ec0, 0x0258, 59, 0 },   /* Ori */
+   { 0x300c6270, 0x0708, 20, 0 },   /* CMi */
+   { 0x300d28f4, 0x030c, 34, 0 },   /* Equ */
+   { 0x2fd058b6, 0x08ca, 54, 0 },   /* Mon */
+   { 0x2fd100a4, 0x05cc, 58, 0 },   /* Oph */
+   { 0x2fd10670, 0x02e0,  3, 0 },   /* Aql */
+   { 0x2fbd258e, 0x0366, 34, 0 },   /* Equ */
+   { 0x2f58a1f4, 0x04ec, 85, 0 },   /* Vir */
+   { 0x2ee057c6, 0x00f0, 54, 0 },   /* Mon */
+   { 0x2ee06180, 0x00f0, 54, 0 },   /* Mon */
+   { 0x2ee06dce, 0x01a4, 20, 0 },   /* CMi */
+   { 0x2ee14f28, 0x0258, 66, 0 },   /* Psc */
+   { 0x2ed61770, 0x04b0, 66, 0 },   /* Psc */
+   { 0x2ed61c20, 0x120c, 16, 0 },   /* Cet */
+   { 0x2e2d1b3e, 0x023a,  3, 0 },   /* Aql */
+   { 0x2df0bdd8, 0x1644, 85, 0 },   /* Vir */
+   { 0x2db53fec, 0x0f3c, 66, 0 },   /* Psc */
+   { 0x2d786f72, 0x023a, 20, 0 },   /* CMi */
+   { 0x2d7871ac, 0x1518, 41, 0 },   /* Hya */
+   { 0x2d7886c4, 0x1068, 74, 0 },   /* Sex */
+   { 0x2d1f00a4, 0x08ac, 73, 0 },   /* Ser */
+   { 0x2d0124f8, 0x0096, 34, 0 },   /* Equ */
+   { 0x2cc46270, 0x003c, 54, 0 },   /* Mon */
+   { 0x2c4d00a4, 0x0276, 58, 0 },   /* Oph */
+   { 0x2c10e22c, 0x0294, 73, 0 },   /* Ser */
+   { 0x2c10e4c0, 0x06cc, 58, 0 },   /* Oph */
+   { 0x2b9900a4, 0x0276, 73, 0 },   /* Ser */
+   { 0x2b7b2de0, 0x02d0,  4, 0 },   /* Aqr */
+   { 0x2b2004b0, 0x1770, 16, 0 },   /* Cet */
+   { 0x2b210554, 0x03fc,  3, 0 },   /* Aql */
+   { 0x2b211d78, 0x0348,  3, 0 },   /* Aql */
+   { 0x2b2120c0, 0x0d20,  4, 0 },   /* Aqr */
+   { 0x2b213560, 0x0a8c,  4, 0 },   /* Aqr */
+   { 0x2b0330b0, 0x04b0,  4, 0 },   /* Aqr */
+   { 0x2ae462ac, 0x0294, 54, 0 },   /* Mon */
+   { 0x2a303264, 0x0f3c, 35, 0 },   /* Eri */
+   { 0x2a306540, 0x0c6c, 54, 0 },   /* Mon */
+   { 0x2a30ce40, 0x05dc, 47, 0 },   /* Lib */
+   { 0x2a30fac8, 0x05dc, 73, 0 },   /* Ser */
+   { 0x295e2544, 0x0d20, 35, 0 },   /* Eri */
+   { 0x28aad41c, 0x0bb8, 47, 0 },   /* Lib */
+   { 0x28aadfd4, 0x04ec, 58, 0 },   /* Oph */
+   { 0x285041a0, 0x05dc, 35, 0 },   /* Eri */
+   { 0x28505208, 0x05be, 54, 0 },   /* Mon */
+   { 0x2850fac8, 0x01e0, 58, 0 },   /* Oph */
+   { 0x285100a4, 0x08ac, 72, 0 },   /* Sct */
+   { 0x28513fec, 0x0f3c,  4, 0 },   /* Aqr */
+   { 0x2760972c, 0x0f3c, 26, 0 },   /* Crt */
+   { 0x26e94f28, 0x0708, 16, 0 },   /* Cet */
+   { 0x2670c864, 0x05dc, 47, 0 },   /* Lib */
+   { 0x2670dfd4, 0x04ec, 71, 0 },   /* Sco */
+   { 0x25f91940, 0x0780, 11, 0 },   /* Cap */
+   { 0x25f92c00, 0x0780, 11, 0 },   /* Cap */
+   { 0x2580f168, 0x05dc, 73, 0 },   /* Ser */
+   { 0x2580f870, 0x0438, 73, 0 },   /* Ser */
+   { 0x25084524, 0x10e0, 46, 0 },   /* Lep */
+   { 0x25085604, 0x1194, 19, 0 },   /* CMa */
+   { 0x25086798, 0x0e10, 67, 0 },   /* Pup */
+   { 0x250886c4, 0x1068, 41, 0 },   /* Hya */
+   { 0x2508a668, 0x0e10, 28, 0 },   /* Crv */
+   { 0x24b8f744, 0x012c, 73, 0 },   /* Ser */
+   { 0x248d0950, 0x0ff0, 76, 0 },   /* Sgr */
+   { 0x236443f8, 0x012c, 46, 0 },   /* Lep */
+   { 0x232920c0, 0x0b40, 11, 0 },   /* Cap */
+   { 0x22b0f168, 0x0618, 58, 0 },   /* Oph */
+   { 0x22b0f780, 0x11d0, 76, 0 },   /* Sgr */
+   { 0x223875a8, 0x030c, 68, 0 },   /* Pyx */
+   { 0x21a2e4c0, 0x0186, 71, 0 },   /* Sco */
+   { 0x214878b4, 0x0708, 68, 0 },   /* Pyx */
+   { 0x2148972c, 0x012c, 41, 0 },   /* Hya */
+   { 0x212ae4c0, 0x0186, 58, 0 },   /* Oph */
+   { 0x20d0dc50, 0x0384, 71, 0 },   /* Sco */
+   { 0x1fe0b0f4, 0x1770, 41, 0 },   /* Hya */
+   { 0x1ef07fbc, 0x03fc, 68, 0 },   /* Pyx */
+   { 0x1ef083b8, 0x0564,  1, 0 },   /* Ant */
+   { 0x1ec21770, 0x1d4c, 36, 0 },   /* For */
+   { 0x1eb49858, 0x189c, 41, 0 },   /* Hya */
+   { 0x1eb4c864, 0x0960, 41, 0 },   /* Hya */
+   { 0x1eaae4c0, 0x06cc, 71, 0 },   /* Sco */
+   { 0x1e3d2c00, 0x1770, 65, 0 },   /* PsA */
+   { 0x1e3d4370, 0x2580, 70, 0 },   /* Scl */
+   { 0x1dc4891c, 0x0708,  1, 0 },   /* Ant */
+   { 0x1d6a4218, 0x0438,  9, 0 },   /* Cae */
+   { 0x1d6a4650, 0x0fb4, 22, 0 },   /* Col */
+   { 0x1d111940, 0x04b0, 76, 0 },   /* Sgr */
+   { 0x1d111df0, 0x0e10, 53, 0 },   /* Mic */
+   { 0x1c849024, 0x04b0,  1, 0 },   /* Ant */
+   { 0x1c5cb0f4, 0x20d0, 14, 0 },   /* Cen */
+   { 0x1c5cd1c4, 0x0f3c, 49, 0 },   /* Lup */
+   { 0x1c204074, 0x01a4,  9, 0 },   /* Cae */
+   { 0x1c20eb8c, 0x0f3c, 71, 0 },   /* Sco */
+   { 0x1b9494d4, 0x0384,  1, 0 },   /* Ant */
+   { 0x1ab85604, 0x0690, 22, 0 },   /* Col */
+   { 0x1ab85c94, 0x0b04, 67, 0 },   /* Pup */
+   { 0x1ab8ac44, 0x04b0, 14, 0 },   /* Cen */
+   { 0x19c89858, 0x0258,  1, 0 },   /* Ant */
+   { 0x19c89ab0, 0x1194, 14, 0 },   /* Cen */
+   { 0x19503138, 0x0384, 35, 0 },   /* Eri */
+   { 0x18f675a8, 0x0e10, 84, 0 },   /* Vel */
+   { 0x18d83c00, 0x0474,  9, 0 },   /* Cae */
+   { 0x18d8fac8, 0x12c0, 24, 0 },   /* CrA */
+   { 0x18d92c00, 0x1c20, 38, 0 },   /* Gru */
+   { 0x17a22a30, 0x0708, 35, 0 },   /* Eri */
+   { 0x178e83b8, 0x16f8, 84, 0 },   /* Vel */
+   { 0x177020d0, 0x0960, 35, 0 },   /* Eri */
+   { 0x17703660, 0x05a0, 40, 0 },   /* Hor */
+   { 0x17714820, 0x2a30, 63, 0 },   /* Phe */
+   { 0x1680c738, 0x0a8c, 49, 0 },   /* Lup */
+   { 0x1680dc50, 0x0a9b, 56, 0 },   /* Nor */
+   { 0x160843f8, 0x1068, 64, 0 },   /* Pic */
+   { 0x16085460, 0x0834, 67, 0 },   /* Pup */
+   { 0x16087080, 0x0528, 84, 0 },   /* Vel */
+   { 0x1590300c, 0x0654, 40, 0 },   /* Hor */
+   { 0x14dce6eb, 0x1635,  5, 0 },   /* Ara */
+   { 0x14dcfd20, 0x20d0, 78, 0 },   /* Tel */
+   { 0x14dd1df0, 0x0e10, 43, 0 },   /* Ind */
+   { 0x14a02a30, 0x05dc, 40, 0 },   /* Hor */
+   { 0x14643f48, 0x04b0, 64, 0 },   /* Pic */
+   { 0x13b0d7a0, 0x04b0, 56, 0 },   /* Nor */
+   { 0x139c19c8, 0x0708, 35, 0 },   /* Eri */
+   { 0x13382580, 0x04b0, 40, 0 },   /* Hor */
+   { 0x1338396c, 0x05dc, 32, 0 },   /* Dor */
+   { 0x12c12c00, 0x0960, 43, 0 },   /* Ind */
+   { 0x12665460, 0x1e78, 12, 0 },   /* Car */
+   { 0x124821fc, 0x0384, 40, 0 },   /* Hor */
+   { 0x124835e8, 0x0384, 32, 0 },   /* Dor */
+   { 0x120c1644, 0x0384, 35, 0 },   /* Eri */
+   { 0x11945460, 0x0258, 64, 0 },   /* Pic */
+   { 0x115872d8, 0x03fc, 12, 0 },   /* Car */
+   { 0x11443138, 0x0708, 69, 0 },   /* Ret */
+   { 0x111c12c0, 0x0384, 35, 0 },   /* Eri */
+   { 0x10e01e78, 0x0384, 40, 0 },   /* Hor */
+   { 0x10e03f48, 0x0708, 32, 0 },   /* Dor */
+   { 0x10e0d3a4, 0x03fc, 56, 0 },   /* Nor */
+   { 0x10a476d4, 0x0564, 12, 0 },   /* Car */
+   { 0x106856b8, 0x04b0, 64, 0 },   /* Pic */
+   { 0x1068a668, 0x0e10, 27, 0 },   /* Cru */
+   { 0x1068c738, 0x0528, 14, 0 },   /* Cen */
+   { 0x1068cc60, 0x0b40, 18, 0 },   /* Cir */
+   { 0x0fb43840, 0x04b0, 69, 0 },   /* Ret */
+   { 0x0fb47c38, 0x21fc, 12, 0 },   /* Car */
+   { 0x0f78f618, 0x27d8, 60, 0 },   /* Pav */
+   { 0x0f793560, 0x12c0, 81, 0 },   /* Tuc */
+   { 0x0f3c2d00, 0x0438, 69, 0 },   /* Ret */
+   { 0x0f3c4650, 0x0708, 32, 0 },   /* Dor */
+   { 0x0f005b68, 0x04b0, 64, 0 },   /* Pic */
+   { 0x0ec412c0, 0x0bb8, 42, 0 },   /* Hyi */
+   { 0x0ec54820, 0x1c20, 81, 0 },   /* Tuc */
+   { 0x0e883cf0, 0x0384, 69, 0 },   /* Ret */
+   { 0x0e10d7a0, 0x0f4b, 79, 0 },   /* TrA */
+   { 0x0e111df0, 0x0e10, 60, 0 },   /* Pav */
+   { 0x0d984d58, 0x0708, 32, 0 },   /* Dor */
+   { 0x0d98d548, 0x0258, 79, 0 },   /* TrA */
+   { 0x0d98e6eb, 0x0249, 79, 0 },   /* TrA */
+   { 0x0c62d1c4, 0x0384, 79, 0 },   /* TrA */
+   { 0x0c62e934, 0x0258, 79, 0 },   /* TrA */
+   { 0x0c305460, 0x0834, 32, 0 },   /* Dor */
+   { 0x0c305c94, 0x2274, 86, 0 },   /* Vol */
+   { 0x0c309e34, 0x1fa4, 55, 0 },   /* Mus */
+   { 0x0c30bdd8, 0x0e88, 18, 0 },   /* Cir */
+   { 0x0bb8bdd8, 0x0258, 55, 0 },   /* Mus */
+   { 0x0bb8eb8c, 0x012c, 79, 0 },   /* TrA */
+   { 0x0a8c1e78, 0x21fc, 42, 0 },   /* Hyi */
+   { 0x0a8ccf6c, 0x0258, 79, 0 },   /* TrA */
+   { 0x0a8cecb8, 0x0258, 79, 0 },   /* TrA */
+   { 0x0a8cef10, 0x0e10,  2, 0 },   /* Aps */
+   { 0x0a8d3560, 0x12c0, 43, 0 },   /* Ind */
+   { 0x09604074, 0x1c20, 52, 0 },   /* Men */
+   { 0x0960c030, 0x2ee0,  2, 0 },   /* Aps */
+   { 0x07080000, 0x0a8c, 42, 0 },   /* Hyi */
+   { 0x07083138, 0x0f3c, 52, 0 },   /* Men */
+   { 0x07085c94, 0x0f3c, 52, 0 },   /* Men */
+   { 0x07086bd0, 0x5460, 17, 0 },   /* Cha */
+   { 0x0708fd20, 0x5460, 57, 0 },   /* Oct */
+   { 0x06900a8c, 0x0834, 42, 0 },   /* Hyi */
+   { 0x03840000, 0x3138, 57, 0 },   /* Oct */
+   { 0x03846bd0, 0x9150, 57, 0 },   /* Oct */
+   { 0x02583138, 0x3a98, 57, 0 },   /* Oct */
@@ -0,0 +1,1272 @@
+//---------------------------------------------------------------------------
+// conchart : printable constellation charts, without a GPU or a display.
+//
+// Renders one chart per constellation and skyculture as a PNG: the stars
+// of hipparcos.stars as black discs sized by magnitude, the stick figures
+// of uConstFigures.h, the IAU boundaries of 'constel.c' (through
+// conbound/congrid), an RA/Dec grid, IAU star names and constellation
+// names, and the skyculture's art for the constellation as an inset.
+//
+//   Usage:  conchart [-p stereo|gnomonic] [-s size] [-m mag_limit]
+//                    [-t threads] [-d data_dir] [-o out_dir]
+//                    [-k culture]... [cst ...]
+//
+// -p picks the projection (default stereographic), -s the image side in
+// pixels (default 1200), -m the faintest star drawn (default 6.5), -t
+// the number of threads (default one per core).  -d is the 'data'
+// directory (default 'data') and -o where the charts go (default
+// 'charts'), as out_dir/culture/Abr.png.  -k picks a skyculture, i.e. a
+// directory of 'data/constellation'; it may be repeated, and without it
+// every culture there is drawn.  "-k none" draws plain charts into
+// out_dir itself.  Constellations are given by abbreviation; without
+// any, all 88 are drawn.
+//
+// The art files carry no sky registration, so they can't be warped onto
+// the stars; each is shown whole in a framed corner inset, matched to
+// its constellation by name as conatlas does.  The figures are the same
+// for every culture (uConstellations has only the one set), so the sky
+// layer is drawn once per constellation and only the inset and caption
+// change per culture.
+//
+// Each chart is centred on the mean position of the Hipparcos stars
+// inside its boundary, north up and east left, and sized to hold them.
+// The sky layer is cut into 128-pixel tiles that the threads draw
+// independently: every tile runs the whole primitive list against its
+// own rectangle, so no pixel is written by two threads.  The boundaries
+// are drawn per pixel: each pixel is classified (on a 4-pixel lattice,
+// refined only where the lattice corners disagree) and a border pixel is
+// one whose right or lower neighbour lies in another constellation, so
+// the lines follow the real boundaries in either projection.  Insets,
+// captions and PNG encoding are further jobs on the same threads, and
+// overlap the next chart's tiles.
+//
+// The PNG writer is built in (fixed-Huffman deflate with a hashed LZ77
+// matcher, which suits mostly white charts), as is the PNG reader of
+// conatlas.c, so this needs nothing beyond the C++ library.  Labels use
+// a built-in 5x7 font; accented letters are folded to plain ones.
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "conbound.h"
+#include "congrid.h"
+#include "precess.h"
+#include "uConstFigures.h"
+#include "uHipCatalog.h"
+#include "uStarCatalog.h"
+
+#define main conatlas_main
+#include "conatlas.c"
+#undef main
+
+//---------------------------------------------------------------------------
+namespace
+{
+const double Pi = 3.14159265358979323846;
+const int TileSize = 128;
+const int Lattice = 4;  // classification step, pixels
+
+struct Color
+{
+	uint8_t R, G, B;
+};
+
+const Color Paper = {255, 255, 255};
+const Color TargetArea = {255, 248, 222};
+const Color BorderColor = {214, 128, 128};
+const Color GridColor = {190, 205, 225};
+const Color FigureColor = {150, 165, 200};
+const Color TargetFigureColor = {30, 70, 170};
+const Color StarColor = {0, 0, 0};
+const Color NameColor = {70, 70, 70};
+const Color ConstNameColor = {150, 150, 150};
+const Color TargetNameColor = {30, 70, 170};
+
+// 5x7 glyphs for ' '..'~', one byte per column, bit 0 at the top.
+const uint8_t Font[95][5] = {
+	{0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5f, 0x00, 0x00},
+	{0x00, 0x07, 0x00, 0x07, 0x00}, {0x14, 0x7f, 0x14, 0x7f, 0x14},
+	{0x24, 0x2a, 0x7f, 0x2a, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+	{0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00},
+	{0x00, 0x1c, 0x22, 0x41, 0x00}, {0x00, 0x41, 0x22, 0x1c, 0x00},
+	{0x08, 0x2a, 0x1c, 0x2a, 0x08}, {0x08, 0x08, 0x3e, 0x08, 0x08},
+	{0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08},
+	{0x00, 0x60, 0x60, 0x00, 0x00}, {0x20, 0x10, 0x08, 0x04, 0x02},
+	{0x3e, 0x51, 0x49, 0x45, 0x3e}, {0x00, 0x42, 0x7f, 0x40, 0x00},
+	{0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4b, 0x31},
+	{0x18, 0x14, 0x12, 0x7f, 0x10}, {0x27, 0x45, 0x45, 0x45, 0x39},
+	{0x3c, 0x4a, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+	{0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1e},
+	{0x00, 0x36, 0x36, 0x00, 0x00}, {0x00, 0x56, 0x36, 0x00, 0x00},
+	{0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14},
+	{0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06},
+	{0x32, 0x49, 0x79, 0x41, 0x3e}, {0x7e, 0x11, 0x11, 0x11, 0x7e},
+	{0x7f, 0x49, 0x49, 0x49, 0x36}, {0x3e, 0x41, 0x41, 0x41, 0x22},
+	{0x7f, 0x41, 0x41, 0x22, 0x1c}, {0x7f, 0x49, 0x49, 0x49, 0x41},
+	{0x7f, 0x09, 0x09, 0x01, 0x01}, {0x3e, 0x41, 0x41, 0x51, 0x32},
+	{0x7f, 0x08, 0x08, 0x08, 0x7f}, {0x00, 0x41, 0x7f, 0x41, 0x00},
+	{0x20, 0x40, 0x41, 0x3f, 0x01}, {0x7f, 0x08, 0x14, 0x22, 0x41},
+	{0x7f, 0x40, 0x40, 0x40, 0x40}, {0x7f, 0x02, 0x04, 0x02, 0x7f},
+	{0x7f, 0x04, 0x08, 0x10, 0x7f}, {0x3e, 0x41, 0x41, 0x41, 0x3e},
+	{0x7f, 0x09, 0x09, 0x09, 0x06}, {0x3e, 0x41, 0x51, 0x21, 0x5e},
+	{0x7f, 0x09, 0x19, 0x29, 0x46}, {0x46, 0x49, 0x49, 0x49, 0x31},
+	{0x01, 0x01, 0x7f, 0x01, 0x01}, {0x3f, 0x40, 0x40, 0x40, 0x3f},
+	{0x1f, 0x20, 0x40, 0x20, 0x1f}, {0x7f, 0x20, 0x18, 0x20, 0x7f},
+	{0x63, 0x14, 0x08, 0x14, 0x63}, {0x03, 0x04, 0x78, 0x04, 0x03},
+	{0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7f, 0x41, 0x41, 0x00},
+	{0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7f, 0x00},
+	{0x04, 0x02, 0x01, 0x02, 0x04}, {0x40, 0x40, 0x40, 0x40, 0x40},
+	{0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78},
+	{0x7f, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20},
+	{0x38, 0x44, 0x44, 0x48, 0x7f}, {0x38, 0x54, 0x54, 0x54, 0x18},
+	{0x08, 0x7e, 0x09, 0x01, 0x02}, {0x0c, 0x52, 0x52, 0x52, 0x3e},
+	{0x7f, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7d, 0x40, 0x00},
+	{0x20, 0x40, 0x44, 0x3d, 0x00}, {0x7f, 0x10, 0x28, 0x44, 0x00},
+	{0x00, 0x41, 0x7f, 0x40, 0x00}, {0x7c, 0x04, 0x18, 0x04, 0x78},
+	{0x7c, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38},
+	{0x7c, 0x14, 0x14, 0x14, 0x08}, {0x08, 0x14, 0x14, 0x18, 0x7c},
+	{0x7c, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},
+	{0x04, 0x3f, 0x44, 0x40, 0x20}, {0x3c, 0x40, 0x40, 0x20, 0x7c},
+	{0x1c, 0x20, 0x40, 0x20, 0x1c}, {0x3c, 0x40, 0x30, 0x40, 0x3c},
+	{0x44, 0x28, 0x10, 0x28, 0x44}, {0x0c, 0x50, 0x50, 0x50, 0x3c},
+	{0x44, 0x64, 0x54, 0x4c, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00},
+	{0x00, 0x00, 0x7f, 0x00, 0x00}, {0x00, 0x41, 0x36, 0x08, 0x00},
+	{0x08, 0x04, 0x08, 0x10, 0x08}};
+
+// U+00C0..U+00FF folded to ASCII
+const char Latin1Fold[] =
+	"AAAAAAACEEEEIIIIDNOOOOOxOUUUUYTsaaaaaaaceeeeiiiidnooooo/ouuuuyty";
+
+// UTF-8 to glyph indices; anything without a glyph becomes '?'.
+std::string ToGlyphs(const std::string& Text)
+{
+	std::string Out;
+	for (size_t i = 0; i < Text.size();)
+	{
+		const uint8_t c = static_cast<uint8_t>(Text[i]);
+		if (c < 0x80)
+		{
+			Out += c >= ' ' && c <= '~' ? static_cast<char>(c) : '?';
+			i++;
+			continue;
+		}
+		int Length = c >= 0xf0 ? 4 : c >= 0xe0 ? 3 : 2;
+		uint32_t Code = c & (0x3f >> (Length - 1));
+		for (int k = 1; k < Length && i + k < Text.size(); k++)
+			Code = (Code << 6) | (static_cast<uint8_t>(Text[i + k]) & 0x3f);
+		Out += Code >= 0xc0 && Code <= 0xff ? Latin1Fold[Code - 0xc0] : '?';
+		i += Length;
+	}
+	return Out;
+}
+
+//---------------------------------------------------------------------------
+struct Image
+{
+	int Width = 0, Height = 0;
+	std::vector<uint8_t> Rgb;
+
+	void Resize(int w, int h)
+	{
+		Width = w;
+		Height = h;
+		Rgb.assign(static_cast<size_t>(w) * h * 3, 255);
+	}
+	// Coverage 0..1 of c over the pixel
+	void Blend(int x, int y, Color c, float Coverage)
+	{
+		uint8_t* p = &Rgb[(static_cast<size_t>(y) * Width + x) * 3];
+		const float a = std::clamp(Coverage, 0.f, 1.f);
+		p[0] = static_cast<uint8_t>(p[0] + (c.R - p[0]) * a + 0.5f);
+		p[1] = static_cast<uint8_t>(p[1] + (c.G - p[1]) * a + 0.5f);
+		p[2] = static_cast<uint8_t>(p[2] + (c.B - p[2]) * a + 0.5f);
+	}
+};
+
+struct Rect
+{
+	int X0, Y0, X1, Y1;  // half-open
+
+	bool Overlaps(const Rect& r) const
+	{
+		return X0 < r.X1 && r.X0 < X1 && Y0 < r.Y1 && r.Y0 < Y1;
+	}
+	Rect Clip(const Rect& r) const
+	{
+		return {std::max(X0, r.X0), std::max(Y0, r.Y0), std::min(X1, r.X1),
+			std::min(Y1, r.Y1)};
+	}
+};
+
+//---------------------------------------------------------------------------
+// PNG output
+
+uint32_t Crc32(const uint8_t* Data, size_t Length, uint32_t Crc = 0)
+{
+	static const std::array<uint32_t, 256> Table = []
+	{
+		std::array<uint32_t, 256> t{};
+		for (uint32_t n = 0; n < 256; n++)
+		{
+			uint32_t c = n;
+			for (int k = 0; k < 8; k++)
+				c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+			t[n] = c;
+		}
+		return t;
+	}();
+	Crc = ~Crc;
+	for (size_t i = 0; i < Length; i++)
+		Crc = Table[(Crc ^ Data[i]) & 0xff] ^ (Crc >> 8);
+	return ~Crc;
+}
+
+uint32_t Adler32(const uint8_t* Data, size_t Length)
+{
+	uint32_t a = 1, b = 0;
+	while (Length > 0)
+	{
+		const size_t Run = std::min<size_t>(Length, 5552);
+		for (size_t i = 0; i < Run; i++)
+		{
+			a += Data[i];
+			b += a;
+		}
+		a %= 65521;
+		b %= 65521;
+		Data += Run;
+		Length -= Run;
+	}
+	return (b << 16) | a;
+}
+
+class BitWriter
+{
+public:
+	std::vector<uint8_t> Bytes;
+
+	void Put(uint32_t Value, int Count)
+	{
+		FBits |= static_cast<uint64_t>(Value) << FCount;
+		FCount += Count;
+		while (FCount >= 8)
+		{
+			Bytes.push_back(static_cast<uint8_t>(FBits));
+			FBits >>= 8;
+			FCount -= 8;
+		}
+	}
+	// Huffman codes go most significant bit first
+	void PutCode(uint32_t Code, int Length)
+	{
+		uint32_t Reversed = 0;
+		for (int i = 0; i < Length; i++)
+			Reversed |= ((Code >> i) & 1) << (Length - 1 - i);
+		Put(Reversed, Length);
+	}
+	void Flush()
+	{
+		if (FCount > 0)
+			Put(0, 8 - FCount);
+	}
+
+private:
+	uint64_t FBits = 0;
+	int FCount = 0;
+};
+
+const uint16_t LengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19,
+	23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t LengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+	2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t DistanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65,
+	97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193,
+	12289, 16385, 24577};
+const uint8_t DistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+	6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+void PutLiteral(BitWriter& Out, int Symbol)
+{
+	// The fixed code of RFC 1951, 3.2.6
+	if (Symbol < 144)
+		Out.PutCode(0x30 + Symbol, 8);
+	else if (Symbol < 256)
+		Out.PutCode(0x190 + Symbol - 144, 9);
+	else if (Symbol < 280)
+		Out.PutCode(Symbol - 256, 7);
+	else
+		Out.PutCode(0xc0 + Symbol - 280, 8);
+}
+
+void PutMatch(BitWriter& Out, int Length, int Distance)
+{
+	int l = 28;
+	while (LengthBase[l] > Length)
+		l--;
+	PutLiteral(Out, 257 + l);
+	Out.Put(Length - LengthBase[l], LengthExtra[l]);
+	int d = 29;
+	while (DistanceBase[d] > Distance)
+		d--;
+	Out.PutCode(d, 5);
+	Out.Put(Distance - DistanceBase[d], DistanceExtra[d]);
+}
+
+// zlib stream of one fixed-Huffman block
+std::vector<uint8_t> Deflate(const std::vector<uint8_t>& Data)
+{
+	const int WindowSize = 32768, HashBits = 15, MaxChain = 16;
+	const int MaxMatch = 258, MinMatch = 3, NiceMatch = 64;
+	BitWriter Out;
+	Out.Bytes.reserve(Data.size() / 8 + 64);
+	Out.Put(0x78, 8);
+	Out.Put(0x01, 8);
+	Out.Put(1, 1);  // final block
+	Out.Put(1, 2);  // fixed Huffman
+
+	std::vector<int32_t> Head(1 << HashBits, -1), Prev(WindowSize, -1);
+	const size_t n = Data.size();
+	auto Hash = [&Data](size_t i)
+	{
+		return ((Data[i] << 10) ^ (Data[i + 1] << 5) ^ Data[i + 2])
+			& ((1 << HashBits) - 1);
+	};
+	auto Insert = [&](size_t i)
+	{
+		if (i + MinMatch <= n)
+		{
+			const int h = Hash(i);
+			Prev[i & (WindowSize - 1)] = Head[h];
+			Head[h] = static_cast<int32_t>(i);
+		}
+	};
+	size_t i = 0;
+	while (i < n)
+	{
+		int BestLength = 0, BestDistance = 0;
+		if (i + MinMatch <= n)
+		{
+			const int Limit = static_cast<int>(std::min<size_t>(MaxMatch, n - i));
+			int32_t Candidate = Head[Hash(i)];
+			for (int Chain = 0; Chain < MaxChain && Candidate >= 0
+				&& i - Candidate <= static_cast<size_t>(WindowSize - 1); Chain++)
+			{
+				const uint8_t* a = &Data[Candidate];
+				const uint8_t* b = &Data[i];
+				if (BestLength > 0 && a[BestLength] != b[BestLength])
+				{
+					// Can't beat the best so far
+					Candidate = Prev[Candidate & (WindowSize - 1)];
+					continue;
+				}
+				int Length = 0;
+				while (Length < Limit && a[Length] == b[Length])
+					Length++;
+				if (Length > BestLength)
+				{
+					BestLength = Length;
+					BestDistance = static_cast<int>(i - Candidate);
+					if (Length >= std::min(NiceMatch, Limit))
+						break;
+				}
+				Candidate = Prev[Candidate & (WindowSize - 1)];
+			}
+		}
+		if (BestLength >= MinMatch)
+		{
+			PutMatch(Out, BestLength, BestDistance);
+			// Inside long runs (blank sky, mostly) only the tail is worth
+			// hashing
+			for (int k = BestLength > NiceMatch ? BestLength - 3 : 0; k < BestLength; k++)
+				Insert(i + k);
+			i += BestLength;
+		}
+		else
+		{
+			PutLiteral(Out, Data[i]);
+			Insert(i);
+			i++;
+		}
+	}
+	PutLiteral(Out, 256);
+	Out.Flush();
+	const uint32_t Check = Adler32(Data.data(), n);
+	for (int s = 24; s >= 0; s -= 8)
+		Out.Bytes.push_back(static_cast<uint8_t>(Check >> s));
+	return std::move(Out.Bytes);
+}
+
+void PutChunk(FILE* File, const char* Type, const std::vector<uint8_t>& Data)
+{
+	std::vector<uint8_t> Buffer(8 + Data.size());
+	const uint32_t Length = static_cast<uint32_t>(Data.size());
+	for (int k = 0; k < 4; k++)
+		Buffer[k] = static_cast<uint8_t>(Length >> (24 - 8 * k));
+	std::memcpy(&Buffer[4], Type, 4);
+	if (!Data.empty())
+		std::memcpy(&Buffer[8], Data.data(), Data.size());
+	const uint32_t Crc = Crc32(&Buffer[4], Buffer.size() - 4);
+	for (int k = 0; k < 4; k++)
+		Buffer.push_back(static_cast<uint8_t>(Crc >> (24 - 8 * k)));
+	std::fwrite(Buffer.data(), 1, Buffer.size(), File);
+}
+
+// Per row, the filter (None, Sub or Up) with the smallest sum of
+// magnitudes, the usual heuristic.
+bool WritePng(const std::string& FileName, const Image& Img)
+{
+	const size_t Stride = static_cast<size_t>(Img.Width) * 3;
+	std::vector<uint8_t> Raw((Stride + 1) * Img.Height);
+	std::vector<uint8_t> Row[3];
+	for (std::vector<uint8_t>& r : Row)
+		r.resize(Stride);
+	for (int y = 0; y < Img.Height; y++)
+	{
+		const uint8_t* Line = &Img.Rgb[y * Stride];
+		const uint8_t* Above = y > 0 ? Line - Stride : nullptr;
+		unsigned Cost[3] = {0, 0, 0};
+		for (size_t x = 0; x < Stride; x++)
+		{
+			Row[0][x] = Line[x];
+			Row[1][x] = static_cast<uint8_t>(Line[x] - (x >= 3 ? Line[x - 3] : 0));
+			Row[2][x] = static_cast<uint8_t>(Line[x] - (Above ? Above[x] : 0));
+			for (int f = 0; f < 3; f++)
+				Cost[f] += std::abs(static_cast<int8_t>(Row[f][x]));
+		}
+		const int Best = static_cast<int>(std::min_element(Cost, Cost + 3) - Cost);
+		uint8_t* Out = &Raw[y * (Stride + 1)];
+		Out[0] = static_cast<uint8_t>(Best);
+		std::memcpy(Out + 1, Row[Best].data(), Stride);
+	}
+
+	FILE* File = std::fopen(FileName.c_str(), "wb");
+	if (!File)
+		return false;
+	static const uint8_t Signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+	std::fwrite(Signature, 1, 8, File);
+	std::vector<uint8_t> Header(13, 0);
+	for (int k = 0; k < 4; k++)
+	{
+		Header[k] = static_cast<uint8_t>(Img.Width >> (24 - 8 * k));
+		Header[4 + k] = static_cast<uint8_t>(Img.Height >> (24 - 8 * k));
+	}
+	Header[8] = 8;  // bits per channel
+	Header[9] = 2;  // RGB
+	PutChunk(File, "IHDR", Header);
+	PutChunk(File, "IDAT", Deflate(Raw));
+	PutChunk(File, "IEND", {});
+	return std::fclose(File) == 0;
+}
+
+//---------------------------------------------------------------------------
+struct Vec3
+{
+	double x, y, z;
+};
+
+double Dot(const Vec3& a, const Vec3& b)
+{
+	return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+Vec3 Normalize(const Vec3& v)
+{
+	const double Length = std::sqrt(Dot(v, v));
+	return Length > 0 ? Vec3{v.x / Length, v.y / Length, v.z / Length} : v;
+}
+
+Vec3 FromRecord(const StarRecord& r)
+{
+	const double RA = r.RA * (Pi / 18000.), Dec = r.DEC * (Pi / 18000.);
+	return {std::cos(Dec) * std::cos(RA), std::cos(Dec) * std::sin(RA),
+		std::sin(Dec)};
+}
+
+// Azimuthal projection about Centre, north up and east left.
+struct Projection
+{
+	Vec3 Centre, East, North;
+	bool Gnomonic = false;
+	double Scale = 1;   // pixels per unit of the projection plane
+	double Half = 0;    // image centre, pixels
+
+	void Setup(const Vec3& c, double Radius, bool IsGnomonic, int Size)
+	{
+		Centre = c;
+		Gnomonic = IsGnomonic;
+		const double Length = std::hypot(c.x, c.y);
+		East = Length > 1e-9 ? Vec3{-c.y / Length, c.x / Length, 0} : Vec3{0, 1, 0};
+		North = {c.y * East.z - c.z * East.y, c.z * East.x - c.x * East.z,
+			c.x * East.y - c.y * East.x};
+		Half = 0.5 * Size;
+		Scale = Half / (Gnomonic ? std::tan(Radius) : 2 * std::tan(Radius / 2));
+	}
+	// False for points the projection can't show
+	bool Project(const Vec3& p, float& sx, float& sy) const
+	{
+		const double w = Dot(p, Centre);
+		if (w < (Gnomonic ? 0.05 : -0.5))
+			return false;
+		const double k = Gnomonic ? 1 / w : 2 / (1 + w);
+		sx = static_cast<float>(Half - k * Dot(p, East) * Scale);
+		sy = static_cast<float>(Half - k * Dot(p, North) * Scale);
+		return true;
+	}
+	Vec3 Unproject(double sx, double sy) const
+	{
+		const double X = (Half - sx) / Scale, Y = (Half - sy) / Scale;
+		double x, y, w;
+		if (Gnomonic)
+		{
+			const double Length = std::sqrt(X * X + Y * Y + 1);
+			x = X / Length;
+			y = Y / Length;
+			w = 1 / Length;
+		}
+		else
+		{
+			const double r2 = X * X + Y * Y;
+			w = (4 - r2) / (4 + r2);
+			x = X * (1 + w) / 2;
+			y = Y * (1 + w) / 2;
+		}
+		return {x * East.x + y * North.x + w * Centre.x,
+			x * East.y + y * North.y + w * Centre.y,
+			x * East.z + y * North.z + w * Centre.z};
+	}
+};
+
+//---------------------------------------------------------------------------
+struct Line
+{
+	float X0, Y0, X1, Y1;
+	float Width;
+	Color Ink;
+};
+
+struct Disc
+{
+	float X, Y, Radius;
+};
+
+struct Label
+{
+	int X, Y, Scale;   // top left; Scale pixels per font dot
+	std::string Glyphs;
+	Color Ink;
+
+	Rect Bounds() const
+	{
+		return {X - Scale, Y - Scale,
+			X + (static_cast<int>(Glyphs.size()) * 6 + 1) * Scale, Y + 8 * Scale};
+	}
+};
+
+// Everything drawn into the sky layer of one chart
+struct Chart
+{
+	int Size = 0;
+	int Target = 0;          // IAU index
+	Projection View;
+	double ToB1875[9];
+	const congrid_t* Grid = nullptr;
+	std::vector<Line> Lines;  // grid, then figures
+	std::vector<Disc> Stars;  // faintest first
+	std::vector<Label> Labels;
+
+	int ConstellationAt(double sx, double sy) const
+	{
+		const Vec3 p = View.Unproject(sx, sy);
+		const double x = ToB1875[0] * p.x + ToB1875[1] * p.y + ToB1875[2] * p.z;
+		const double y = ToB1875[3] * p.x + ToB1875[4] * p.y + ToB1875[5] * p.z;
+		const double z = ToB1875[6] * p.x + ToB1875[7] * p.y + ToB1875[8] * p.z;
+		double RA = std::atan2(y, x) * (180. / Pi);
+		if (RA < 0)
+			RA += 360.;
+		const double Dec = std::asin(std::clamp(z, -1., 1.)) * (180. / Pi);
+		return constellation_grid_index_at(Grid, RA, Dec);
+	}
+};
+
+void DrawLine(Image& Img, const Rect& Tile, const Line& l)
+{
+	const float Reach = 0.5f * l.Width + 1;
+	const Rect Box = Rect{
+		static_cast<int>(std::floor(std::min(l.X0, l.X1) - Reach)),
+		static_cast<int>(std::floor(std::min(l.Y0, l.Y1) - Reach)),
+		static_cast<int>(std::ceil(std::max(l.X0, l.X1) + Reach)),
+		static_cast<int>(std::ceil(std::max(l.Y0, l.Y1) + Reach))}.Clip(Tile);
+	const float dx = l.X1 - l.X0, dy = l.Y1 - l.Y0;
+	const float LengthSq = dx * dx + dy * dy;
+	for (int y = Box.Y0; y < Box.Y1; y++)
+		for (int x = Box.X0; x < Box.X1; x++)
+		{
+			const float px = x + 0.5f - l.X0, py = y + 0.5f - l.Y0;
+			const float t = LengthSq > 0
+				? std::clamp((px * dx + py * dy) / LengthSq, 0.f, 1.f) : 0.f;
+			const float Distance = std::hypot(px - t * dx, py - t * dy);
+			const float Coverage = 0.5f * l.Width + 0.5f - Distance;
+			if (Coverage > 0)
+				Img.Blend(x, y, l.Ink, Coverage);
+		}
+}
+
+void DrawDisc(Image& Img, const Rect& Tile, float cx, float cy, float Radius,
+	Color Ink)
+{
+	const Rect Box = Rect{static_cast<int>(std::floor(cx - Radius - 1)),
+		static_cast<int>(std::floor(cy - Radius - 1)),
+		static_cast<int>(std::ceil(cx + Radius + 1)),
+		static_cast<int>(std::ceil(cy + Radius + 1))}.Clip(Tile);
+	for (int y = Box.Y0; y < Box.Y1; y++)
+		for (int x = Box.X0; x < Box.X1; x++)
+		{
+			const float Coverage = Radius + 0.5f
+				- std::hypot(x + 0.5f - cx, y + 0.5f - cy);
+			if (Coverage > 0)
+				Img.Blend(x, y, Ink, Coverage);
+		}
+}
+
+// Halo draws each dot grown by one pixel in paper colour, to lift the
+// text off lines and stars.
+void DrawLabel(Image& Img, const Rect& Tile, const Label& l, bool Halo)
+{
+	if (!l.Bounds().Overlaps(Tile))
+		return;
+	const int Grow = Halo ? 1 : 0;
+	for (size_t i = 0; i < l.Glyphs.size(); i++)
+	{
+		const uint8_t* Glyph = Font[l.Glyphs[i] - ' '];
+		for (int Column = 0; Column < 5; Column++)
+			for (int Row = 0; Row < 7; Row++)
+			{
+				if (!(Glyph[Column] >> Row & 1))
+					continue;
+				const int x = l.X + (static_cast<int>(i) * 6 + Column) * l.Scale;
+				const int y = l.Y + Row * l.Scale;
+				const Rect Dot = Rect{x - Grow, y - Grow, x + l.Scale + Grow,
+					y + l.Scale + Grow}.Clip(Tile);
+				for (int py = Dot.Y0; py < Dot.Y1; py++)
+					for (int px = Dot.X0; px < Dot.X1; px++)
+						Img.Blend(px, py, Halo ? Paper : l.Ink, 1);
+			}
+	}
+}
+
+void RenderTile(const Chart& c, Image& Img, const Rect& Tile)
+{
+	// Constellation of every pixel of the tile plus one column and row
+	const int w = Tile.X1 - Tile.X0 + 1, h = Tile.Y1 - Tile.Y0 + 1;
+	std::vector<int> Region(static_cast<size_t>(w) * h);
+	auto At = [&](int x, int y)
+	{
+		return c.ConstellationAt(Tile.X0 + x + 0.5, Tile.Y0 + y + 0.5);
+	};
+	const int lw = w / Lattice + 2, lh = h / Lattice + 2;
+	std::vector<int> Corner(static_cast<size_t>(lw) * lh);
+	for (int j = 0; j < lh; j++)
+		for (int i = 0; i < lw; i++)
+			Corner[j * lw + i] = At(i * Lattice, j * Lattice);
+	for (int j = 0; j + 1 < lh; j++)
+		for (int i = 0; i + 1 < lw; i++)
+		{
+			const int a = Corner[j * lw + i];
+			const bool Uniform = a == Corner[j * lw + i + 1]
+				&& a == Corner[(j + 1) * lw + i] && a == Corner[(j + 1) * lw + i + 1];
+			for (int y = j * Lattice; y < std::min(h, (j + 1) * Lattice); y++)
+				for (int x = i * Lattice; x < std::min(w, (i + 1) * Lattice); x++)
+					Region[y * w + x] = Uniform ? a : At(x, y);
+		}
+	for (int y = 0; y + 1 < h; y++)
+		for (int x = 0; x + 1 < w; x++)
+		{
+			const int r = Region[y * w + x];
+			const bool Border = r != Region[y * w + x + 1] || r != Region[(y + 1) * w + x];
+			uint8_t* p = &Img.Rgb[((static_cast<size_t>(Tile.Y0) + y) * Img.Width
+				+ Tile.X0 + x) * 3];
+			const Color Ink = Border ? BorderColor : r == c.Target ? TargetArea : Paper;
+			p[0] = Ink.R;
+			p[1] = Ink.G;
+			p[2] = Ink.B;
+		}
+
+	for (const Line& l : c.Lines)
+		DrawLine(Img, Tile, l);
+	for (const Disc& s : c.Stars)
+	{
+		// A paper ring keeps lines from touching the star
+		DrawDisc(Img, Tile, s.X, s.Y, s.Radius + 1.2f, Paper);
+		DrawDisc(Img, Tile, s.X, s.Y, s.Radius, StarColor);
+	}
+	for (const Label& l : c.Labels)
+		DrawLabel(Img, Tile, l, true);
+	for (const Label& l : c.Labels)
+		DrawLabel(Img, Tile, l, false);
+}
+
+//---------------------------------------------------------------------------
+// Runs jobs on a fixed set of threads; Wait() returns once the queue is
+// empty and every job has finished.
+class JobPool
+{
+public:
+	explicit JobPool(unsigned Threads)
+	{
+		for (unsigned i = 0; i < std::max(Threads, 1u); i++)
+			FThreads.emplace_back([this] { Loop(); });
+	}
+	~JobPool()
+	{
+		{
+			std::lock_guard<std::mutex> Guard(FLock);
+			FQuit = true;
+		}
+		FStart.notify_all();
+		for (std::thread& t : FThreads)
+			t.join();
+	}
+	void Submit(std::function<void()> Job)
+	{
+		{
+			std::lock_guard<std::mutex> Guard(FLock);
+			FJobs.push_back(std::move(Job));
+			FPending++;
+		}
+		FStart.notify_one();
+	}
+	void Wait()
+	{
+		std::unique_lock<std::mutex> Guard(FLock);
+		FDone.wait(Guard, [this] { return FPending == 0; });
+	}
+	// Waits for the count of unfinished jobs to drop to Count.
+	void WaitUntil(size_t Count)
+	{
+		std::unique_lock<std::mutex> Guard(FLock);
+		FDone.wait(Guard, [&] { return FPending <= Count; });
+	}
+
+private:
+	void Loop()
+	{
+		std::unique_lock<std::mutex> Guard(FLock);
+		for (;;)
+		{
+			FStart.wait(Guard, [this] { return FQuit || !FJobs.empty(); });
+			if (FJobs.empty())
+				return;
+			std::function<void()> Job = std::move(FJobs.front());
+			FJobs.pop_front();
+			Guard.unlock();
+			Job();
+			Guard.lock();
+			FPending--;
+			FDone.notify_all();
+		}
+	}
+
+	std::vector<std::thread> FThreads;
+	std::mutex FLock;
+	std::condition_variable FStart;
+	std::condition_variable FDone;
+	std::deque<std::function<void()>> FJobs;
+	size_t FPending = 0;
+	bool FQuit = false;
+};
+
+//---------------------------------------------------------------------------
+// A skyculture: its art file for each IAU index, or empty.
+struct Culture
+{
+	std::string Name;
+	std::string Directory;
+	std::array<std::string, N_CONSTELLATIONS> Art;
+};
+
+// Art files are matched as conatlas does: by abbreviation, by Latin
+// name, or by one of its aliases.
+void FindArt(Culture& c, char Names[][MAX_NAME], char Abbreviations[][MAX_NAME],
+	int NameCount)
+{
+	std::error_code Error;
+	for (const auto& Entry : std::filesystem::directory_iterator(c.Directory, Error))
+	{
+		const std::string File = Entry.path().filename().string();
+		if (File.size() <= 4 || File.size() >= MAX_NAME
+			|| File.compare(File.size() - 4, 4, ".png"))
+			continue;
+		const std::string Key = File.substr(0, File.size() - 4);
+		char Squashed[MAX_NAME], Squashed2[MAX_NAME];
+		squash_name(Key.c_str(), Squashed);
+		for (const auto& Alias : aliases)
+			if (!std::strcmp(Squashed, Alias[0]))
+				std::strcpy(Squashed, Alias[1]);
+		for (int j = 0; j < NameCount && j < N_CONSTELLATIONS; j++)
+		{
+			squash_name(Names[j], Squashed2);
+			if (!std::strcmp(Squashed, Squashed2)
+				|| same_abbreviation(Key.c_str(), Abbreviations[j]))
+			{
+				if (c.Art[j].empty() || File < std::filesystem::path(c.Art[j])
+						.filename().string())
+					c.Art[j] = Entry.path().string();
+				break;
+			}
+		}
+	}
+}
+
+// Box-filtered copy of an RGBA image into a Side-pixel square at (x, y),
+// letterboxed, over a paper frame.
+void DrawInset(Image& Img, const uint8_t* Rgba, int w, int h, int x, int y,
+	int Side)
+{
+	const int Frame = std::max(2, Side / 64);
+	for (int py = y - Frame; py < y + Side + Frame; py++)
+		for (int px = x - Frame; px < x + Side + Frame; px++)
+		{
+			const bool Edge = py < y - Frame + 1 || py >= y + Side + Frame - 1
+				|| px < x - Frame + 1 || px >= x + Side + Frame - 1;
+			Img.Blend(px, py, Edge ? ConstNameColor : Paper, 1);
+		}
+	const double Step = static_cast<double>(std::max(w, h)) / Side;
+	const int ox = x + static_cast<int>((Side - w / Step) / 2);
+	const int oy = y + static_cast<int>((Side - h / Step) / 2);
+	for (int py = 0; py < static_cast<int>(h / Step); py++)
+		for (int px = 0; px < static_cast<int>(w / Step); px++)
+		{
+			const int sx0 = static_cast<int>(px * Step);
+			const int sy0 = static_cast<int>(py * Step);
+			const int sx1 = std::max(sx0 + 1, std::min(w, static_cast<int>((px + 1) * Step)));
+			const int sy1 = std::max(sy0 + 1, std::min(h, static_cast<int>((py + 1) * Step)));
+			double Sum[4] = {0, 0, 0, 0};
+			for (int sy = sy0; sy < sy1; sy++)
+				for (int sx = sx0; sx < sx1; sx++)
+				{
+					const uint8_t* s = &Rgba[(static_cast<size_t>(sy) * w + sx) * 4];
+					const double a = s[3] / 255.;
+					Sum[0] += s[0] * a;
+					Sum[1] += s[1] * a;
+					Sum[2] += s[2] * a;
+					Sum[3] += a;
+				}
+			if (Sum[3] <= 0)
+				continue;
+			const double n = (sx1 - sx0) * (sy1 - sy0);
+			const Color c = {static_cast<uint8_t>(Sum[0] / Sum[3]),
+				static_cast<uint8_t>(Sum[1] / Sum[3]),
+				static_cast<uint8_t>(Sum[2] / Sum[3])};
+			Img.Blend(ox + px, oy + py, c, static_cast<float>(Sum[3] / n));
+		}
+}
+
+void DrawText(Image& Img, const Label& l)
+{
+	const Rect All = {0, 0, Img.Width, Img.Height};
+	DrawLabel(Img, All, l, true);
+	DrawLabel(Img, All, l, false);
+}
+
+//---------------------------------------------------------------------------
+// Greedy placement, most important first: a label that would overlap one
+// already placed (or a reserved area) is dropped.
+struct Placer
+{
+	std::vector<Rect> Taken;
+	Rect Frame;
+
+	bool Place(const Label& l)
+	{
+		const Rect b = l.Bounds();
+		if (b.X0 < Frame.X0 || b.Y0 < Frame.Y0 || b.X1 > Frame.X1 || b.Y1 > Frame.Y1)
+			return false;
+		for (const Rect& r : Taken)
+			if (r.Overlaps(b))
+				return false;
+		Taken.push_back(b);
+		return true;
+	}
+};
+
+float StarRadius(float Magnitude, float MagLimit, float Unit)
+{
+	return Unit * std::max(0.6f, 0.55f * (MagLimit + 1.2f - Magnitude));
+}
+
+bool SameAbbreviation(const char* a, const char* b)
+{
+	while (*a && std::tolower(static_cast<unsigned char>(*a))
+			== std::tolower(static_cast<unsigned char>(*b)))
+		a++, b++;
+	return !*a && !*b;
+}
+}
+
+//---------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	bool Gnomonic = false;
+	int Size = 1200;
+	float MagLimit = 6.5f;
+	unsigned ThreadCount = std::max(1u, std::thread::hardware_concurrency());
+	std::string DataDir = "data", OutDir = "charts";
+	std::vector<std::string> CultureNames, Wanted;
+	bool Ok = true;
+
+	for (int i = 1; i < argc && Ok; i++)
+	{
+		const std::string Arg = argv[i];
+		const bool HasValue = i + 1 < argc;
+		if (Arg == "-p" && HasValue)
+		{
+			const std::string p = argv[++i];
+			Gnomonic = p == "gnomonic";
+			Ok = Gnomonic || p == "stereo";
+		}
+		else if (Arg == "-s" && HasValue)
+			Size = std::atoi(argv[++i]);
+		else if (Arg == "-m" && HasValue)
+			MagLimit = static_cast<float>(std::atof(argv[++i]));
+		else if (Arg == "-t" && HasValue)
+			ThreadCount = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+		else if (Arg == "-d" && HasValue)
+			DataDir = argv[++i];
+		else if (Arg == "-o" && HasValue)
+			OutDir = argv[++i];
+		else if (Arg == "-k" && HasValue)
+			CultureNames.push_back(argv[++i]);
+		else if (Arg[0] != '-')
+			Wanted.push_back(Arg);
+		else
+			Ok = false;
+	}
+	if (!Ok || Size < 64)
+	{
+		std::fprintf(stderr, "Usage:  conchart [-p stereo|gnomonic] [-s size] "
+			"[-m mag_limit] [-t threads]\n                 [-d data_dir] "
+			"[-o out_dir] [-k culture]... [cst ...]\n");
+		return -1;
+	}
+
+	// Constellation names, in IAU index order
+	static char Names[N_CONSTELLATIONS][MAX_NAME];
+	static char Abbreviations[N_CONSTELLATIONS][MAX_NAME];
+	const std::string ConstDir = DataDir + "/constellation";
+	const int NameCount = read_lines((ConstDir + "/ConstNames.dat").c_str(),
+		Names, N_CONSTELLATIONS);
+	if (NameCount != N_CONSTELLATIONS || read_lines((ConstDir
+			+ "/ConstShortNames.dat").c_str(), Abbreviations, N_CONSTELLATIONS)
+			!= N_CONSTELLATIONS)
+	{
+		std::fprintf(stderr, "Need all 88 names in ConstNames.dat and "
+			"ConstShortNames.dat\n");
+		return -1;
+	}
+
+	std::vector<int> Targets;
+	for (int c = 0; c < N_CONSTELLATIONS; c++)
+	{
+		bool Selected = Wanted.empty();
+		for (const std::string& w : Wanted)
+			Selected = Selected || SameAbbreviation(w.c_str(), constellation_name(c));
+		if (Selected)
+			Targets.push_back(c);
+	}
+	if (Targets.empty())
+	{
+		std::fprintf(stderr, "No such constellation\n");
+		return -1;
+	}
+
+	std::vector<Culture> Cultures;
+	if (CultureNames.empty())
+	{
+		std::error_code Error;
+		for (const auto& Entry : std::filesystem::directory_iterator(ConstDir, Error))
+			if (Entry.is_directory())
+				CultureNames.push_back(Entry.path().filename().string());
+		std::sort(CultureNames.begin(), CultureNames.end());
+	}
+	for (const std::string& Name : CultureNames)
+	{
+		Culture c;
+		if (Name != "none")
+		{
+			c.Name = Name;
+			c.Directory = ConstDir + "/" + Name;
+			if (!std::filesystem::is_directory(c.Directory))
+			{
+				std::fprintf(stderr, "%s: no such skyculture\n", c.Directory.c_str());
+				return -1;
+			}
+			FindArt(c, Names, Abbreviations, NameCount);
+		}
+		Cultures.push_back(c);
+	}
+	if (Cultures.empty())
+		Cultures.emplace_back();
+	std::error_code Error;
+	for (const Culture& c : Cultures)
+		std::filesystem::create_directories(OutDir + "/" + c.Name, Error);
+
+	StarCatalog Stars;
+	if (!Stars.Open(DataDir + "/catalog/hipparcos.stars"))
+	{
+		std::fprintf(stderr, "%s\n", Stars.LastError().c_str());
+		return -1;
+	}
+	HipCatalogSources Sources;
+	Sources.IauCsn = DataDir + "/star/IAU-CSN.txt";
+	// Built in memory each run: it takes well under a second, and a tool
+	// has no business leaving cache files in the data directory.
+	HipCatalog Catalog;
+	Catalog.Build(Stars.Records(), Sources);
+
+	congrid_t Grid;
+	if (constellation_grid_build(&Grid, 360, 0))
+	{
+		std::fprintf(stderr, "Out of memory\n");
+		return -1;
+	}
+	std::vector<Vec3> Positions(Catalog.Count());
+	for (size_t i = 0; i < Positions.size(); i++)
+		Positions[i] = FromRecord(Catalog[i].Star);
+	// IAU index of each figure (Serpens has two)
+	std::array<int, ConstFigureCount> FigureConstellation;
+	for (int f = 0; f < ConstFigureCount; f++)
+	{
+		FigureConstellation[f] = -1;
+		for (int c = 0; c < N_CONSTELLATIONS; c++)
+			if (SameAbbreviation(ConstFigureNames[f], constellation_name(c)))
+				FigureConstellation[f] = c;
+	}
+
+	const float Unit = Size / 1200.f;
+	const int TextScale = std::max(1, static_cast<int>(std::lround(2 * Unit)));
+	const int TitleScale = std::max(2, static_cast<int>(std::lround(3 * Unit)));
+	const int InsetSide = Size / 4;
+	const int Margin = std::max(4, Size / 100);
+	const Rect InsetArea = {Size - InsetSide - 2 * Margin, Size - InsetSide
+		- 2 * Margin, Size, Size};
+	const Rect TitleArea = {0, 0, Size, Margin + 18 * TitleScale};
+
+	JobPool Pool(ThreadCount);
+	size_t Written = 0, Failed = 0;
+	std::mutex CountLock;
+	for (const int Target : Targets)
+	{
+		// Centre on the stars inside the boundary, sized to hold them
+		Vec3 Sum = {0, 0, 0};
+		for (size_t i = 0; i < Positions.size(); i++)
+			if (Catalog[i].Constellation == Target)
+			{
+				Sum.x += Positions[i].x;
+				Sum.y += Positions[i].y;
+				Sum.z += Positions[i].z;
+			}
+		const Vec3 Centre = Normalize(Sum);
+		double MinDot = 1;
+		for (size_t i = 0; i < Positions.size(); i++)
+			if (Catalog[i].Constellation == Target)
+				MinDot = std::min(MinDot, Dot(Positions[i], Centre));
+		const double Radius = std::min(std::acos(std::clamp(MinDot, -1., 1.)) * 1.12
+			+ 2 * Pi / 180., (Gnomonic ? 70. : 100.) * Pi / 180.);
+
+		auto c = std::make_shared<Chart>();
+		c->Size = Size;
+		c->Target = Target;
+		c->Grid = &Grid;
+		c->View.Setup(Centre, Radius, Gnomonic, Size);
+		setup_precession(c->ToB1875, EPOCH_J2000, EPOCH_B1875);
+
+		// RA/Dec grid, in one-degree steps
+		auto AddCurve = [&](auto Point, int Steps, float Width, Color Ink)
+		{
+			float px = 0, py = 0;
+			bool Last = false;
+			for (int k = 0; k <= Steps; k++)
+			{
+				float x, y;
+				const bool In = c->View.Project(Point(k), x, y);
+				if (In && Last && std::hypot(x - px, y - py) < 0.25f * Size)
+					c->Lines.push_back({px, py, x, y, Width, Ink});
+				px = x;
+				py = y;
+				Last = In;
+			}
+		};
+		for (int Dec = -80; Dec <= 80; Dec += 10)
+			AddCurve([Dec](int k)
+			{
+				const double d = Dec * Pi / 180., r = k * Pi / 180.;
+				return Vec3{std::cos(d) * std::cos(r), std::cos(d) * std::sin(r),
+					std::sin(d)};
+			}, 360, 0.8f * Unit, GridColor);
+		for (int Hour = 0; Hour < 24; Hour++)
+			AddCurve([Hour](int k)
+			{
+				const double d = (k - 80) * Pi / 180., r = Hour * Pi / 12.;
+				return Vec3{std::cos(d) * std::cos(r), std::cos(d) * std::sin(r),
+					std::sin(d)};
+			}, 160, 0.8f * Unit, GridColor);
+
+		// Figures, the target's last so it draws on top
+		for (int Pass = 0; Pass < 2; Pass++)
+			for (int f = 0; f < ConstFigureCount; f++)
+			{
+				if ((FigureConstellation[f] == Target) != (Pass == 1))
+					continue;
+				for (int s = ConstFigureSegmentStart[f]; s < ConstFigureSegmentStart[f + 1]; s++)
+				{
+					const ConstFigureVertex& a = ConstFigureVertices[ConstFigureSegments[2 * s]];
+					const ConstFigureVertex& b = ConstFigureVertices[ConstFigureSegments[2 * s + 1]];
+					float x0, y0, x1, y1;
+					if (c->View.Project({a.x, a.y, a.z}, x0, y0)
+						&& c->View.Project({b.x, b.y, b.z}, x1, y1))
+						c->Lines.push_back({x0, y0, x1, y1, (Pass ? 2.f : 1.4f) * Unit,
+							Pass ? TargetFigureColor : FigureColor});
+				}
+			}
+
+		// Stars, brightest first for the labels; drawn faintest first
+		Placer Labels;
+		Labels.Frame = {Margin, Margin, Size - Margin, Size - Margin};
+		Labels.Taken = std::vector<Rect>{TitleArea, InsetArea};
+		const Label Title = {Margin, Margin, TitleScale,
+			ToGlyphs(std::string(Names[Target]) + " (" + constellation_name(Target) + ")"),
+			TargetNameColor};
+		c->Labels.push_back(Title);
+		for (size_t i = 0; i < Positions.size(); i++)
+		{
+			const float Magnitude = Catalog[i].Star.Magnitude();
+			if (Magnitude > MagLimit)
+				break;
+			float x, y;
+			if (!c->View.Project(Positions[i], x, y) || x < -8 || y < -8
+				|| x > Size + 8 || y > Size + 8)
+				continue;
+			const float r = StarRadius(Magnitude, MagLimit, Unit);
+			c->Stars.push_back({x, y, r});
+			// Labels may cover the faintest stars, not the rest
+			if (Magnitude < MagLimit - 2)
+				Labels.Taken.push_back({static_cast<int>(x - r), static_cast<int>(y - r),
+					static_cast<int>(x + r + 1), static_cast<int>(y + r + 1)});
+		}
+		std::reverse(c->Stars.begin(), c->Stars.end());
+		for (size_t i = 0; i < Positions.size(); i++)
+		{
+			const float Magnitude = Catalog[i].Star.Magnitude();
+			if (Magnitude > MagLimit)
+				break;
+			const std::string_view Name = Catalog.Name(i);
+			float x, y;
+			if (Name.empty() || !c->View.Project(Positions[i], x, y))
+				continue;
+			const float r = StarRadius(Magnitude, MagLimit, Unit);
+			Label l = {static_cast<int>(x + r + 3 * Unit),
+				static_cast<int>(y - 3.5f * TextScale), TextScale,
+				ToGlyphs(std::string(Name)), NameColor};
+			if (!Labels.Place(l))
+			{
+				// Try the left side
+				l.X = static_cast<int>(x - r - 3 * Unit) - (static_cast<int>(l.Glyphs.size()) * 6 - 1) * TextScale;
+				if (!Labels.Place(l))
+					continue;
+			}
+			c->Labels.push_back(l);
+		}
+		for (int f = 0; f < ConstFigureCount; f++)
+		{
+			const int Owner = FigureConstellation[f];
+			const ConstFigureVertex& v = ConstFigureLabelVertices[f];
+			float x, y;
+			if (Owner < 0 || (f > 0 && FigureConstellation[f - 1] == Owner)
+				|| !c->View.Project({v.x, v.y, v.z}, x, y))
+				continue;
+			std::string Upper = Names[Owner];
+			for (char& ch : Upper)
+				ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+			Label l = {0, static_cast<int>(y) - 4 * TextScale, TextScale,
+				ToGlyphs(Upper), Owner == Target ? TargetNameColor : ConstNameColor};
+			l.X = static_cast<int>(x) - static_cast<int>(l.Glyphs.size()) * 3 * TextScale;
+			if (Labels.Place(l))
+				c->Labels.push_back(l);
+		}
+
+		// The sky layer, tile by tile; the last tile to finish queues the
+		// insets and encoding.  Waiting for the queue to run low first keeps
+		// only a few charts in memory.
+		Pool.WaitUntil(4 * static_cast<size_t>(ThreadCount));
+		auto Sky = std::make_shared<Image>();
+		Sky->Resize(Size, Size);
+		auto Finish = [=, &Pool, &Cultures, &Written, &Failed, &CountLock]
+		{
+			for (const Culture& k : Cultures)
+			{
+				const std::string FileName = OutDir + "/" + (k.Name.empty() ? ""
+					: k.Name + "/") + constellation_name(Target) + ".png";
+				const std::string Art = k.Art[Target];
+				const std::string Caption = ToGlyphs(k.Name);
+				Pool.Submit([=, &Written, &Failed, &CountLock]
+				{
+					Image Img = *Sky;
+					int w, h;
+					uint8_t* Rgba = Art.empty() ? nullptr : load_png(Art.c_str(), &w, &h);
+					if (Rgba)
+					{
+						DrawInset(Img, Rgba, w, h, InsetArea.X0 + Margin,
+							InsetArea.Y0 + Margin, InsetSide);
+						free(Rgba);
+					}
+					if (!Caption.empty())
+					{
+						Label l = {0, Margin, TextScale, Caption, NameColor};
+						l.X = Size - Margin - (static_cast<int>(Caption.size()) * 6 - 1)
+							* TextScale;
+						DrawText(Img, l);
+					}
+					const bool Saved = WritePng(FileName, Img);
+					std::lock_guard<std::mutex> Guard(CountLock);
+					(Saved ? Written : Failed)++;
+					if (!Saved)
+						std::fprintf(stderr, "Couldn't write %s\n", FileName.c_str());
+				});
+			}
+		};
+		const int Columns = (Size + TileSize - 1) / TileSize;
+		auto Remaining = std::make_shared<std::atomic<int>>(Columns * Columns);
+		for (int y = 0; y < Size; y += TileSize)
+			for (int x = 0; x < Size; x += TileSize)
+			{
+				const Rect Tile = {x, y, std::min(Size, x + TileSize),
+					std::min(Size, y + TileSize)};
+				Pool.Submit([c, Sky, Tile, Remaining, Finish]
+				{
+					RenderTile(*c, *Sky, Tile);
+					if (--*Remaining == 0)
+						Finish();
+				});
+			}
+	}
+	Pool.Wait();
+	constellation_grid_free(&Grid);
+	std::printf("%zu charts written to %s\n", Written, OutDir.c_str());
+	return Failed ? -1 : 0;
+}
+//---------------------------------------------------------------------------
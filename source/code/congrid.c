@@ -0,0 +1,251 @@
+#include <stdlib.h>
+#include <math.h>
+#include "congrid.h"
+
+/* Implementation of the raster described in 'congrid.h'.  Breakpoints
+are kept in the table's own units (RA seconds,  SPD arcminutes),  so
+deciding whether a boundary is inside a cell is exact. */
+
+static int compare_ints( const void *a, const void *b)
+{
+   const int32_t ia = *(const int32_t *)a, ib = *(const int32_t *)b;
+
+   return( ia < ib ? -1 : (ia > ib ? 1 : 0));
+}
+
+static size_t sort_unique( int32_t *array, const size_t n)
+{
+   size_t i, j;
+
+   if( !n)
+      return( 0);
+   qsort( array, n, sizeof( int32_t), compare_ints);
+   for( i = j = 1; i < n; i++)
+      if( array[i] != array[j - 1])
+         array[j++] = array[i];
+   return( j);
+}
+
+/* Index of the first breakpoint > value. */
+
+static size_t first_above( const int32_t *array, const size_t n,
+                           const double value)
+{
+   size_t lo = 0, hi = n;
+
+   while( lo < hi)
+      {
+      const size_t mid = (lo + hi) / 2;
+
+      if( (double)array[mid] > value)
+         hi = mid;
+      else
+         lo = mid + 1;
+      }
+   return( lo);
+}
+
+/* Collects the breakpoints strictly inside (lo, hi),  plus the two ends,
+into 'out';  returns how many. */
+
+static size_t cuts_in( const int32_t *array, const size_t n, const double lo,
+                       const double hi, double *out)
+{
+   size_t i = first_above( array, n, lo), n_out = 0;
+
+   out[n_out++] = lo;
+   while( i < n && (double)array[i] < hi)
+      out[n_out++] = (double)array[i++];
+   out[n_out++] = hi;
+   return( n_out);
+}
+
+/* Halves 'fine' into 'coarse':  a cell is uniform if the four under it
+are,  and all four agree. */
+
+static int build_coarse_level( congrid_level_t *coarse,
+                               const congrid_level_t *fine)
+{
+   int row, col;
+
+   coarse->width = fine->width / 2;
+   coarse->height = fine->height / 2;
+   coarse->cells = (uint8_t *)malloc( (size_t)coarse->width
+                                    * (size_t)coarse->height);
+   if( !coarse->cells)
+      return( -1);
+   for( row = 0; row < coarse->height; row++)
+      {
+      const uint8_t *below = fine->cells + (size_t)( 2 * row) * fine->width;
+      const uint8_t *above = below + fine->width;
+      uint8_t *out = coarse->cells + (size_t)row * coarse->width;
+
+      for( col = 0; col < coarse->width; col++)
+         {
+         const uint8_t idx = below[2 * col];
+
+         out[col] = (below[2 * col + 1] == idx && above[2 * col] == idx
+                     && above[2 * col + 1] == idx) ? idx : CONSTELL_IDX_NONE;
+         }
+      }
+   return( 0);
+}
+
+int constellation_grid_build( congrid_t *grid, const int height,
+                                 const int fill_mixed)
+{
+   size_t n_bounds, n_ras = 0, n_spds = 0, i;
+   const constbnd_t *bounds = constellation_bounds( &n_bounds);
+   int32_t *ras, *spds;
+   double *ra_cuts, *spd_cuts;
+   int row, col;
+
+   grid->cells = NULL;
+   grid->width = grid->height = 0;
+   grid->n_mixed = 0;
+   grid->n_coarse = 0;
+   if( height < 1)
+      return( -1);
+   ras = (int32_t *)malloc( 2 * n_bounds * sizeof( int32_t));
+   spds = (int32_t *)malloc( n_bounds * sizeof( int32_t));
+   ra_cuts = (double *)malloc( (2 * n_bounds + 2) * sizeof( double));
+   spd_cuts = (double *)malloc( (n_bounds + 2) * sizeof( double));
+   grid->cells = (uint8_t *)malloc( (size_t)height * 2 * (size_t)height);
+   if( !ras || !spds || !ra_cuts || !spd_cuts || !grid->cells)
+      {
+      free( grid->cells);
+      grid->cells = NULL;
+      n_bounds = 0;
+      }
+   for( i = 0; i < n_bounds; i++)
+      {
+      const int32_t min_ra = CONSTBND_MIN_RA( bounds + i);
+
+      ras[n_ras++] = min_ra;
+      ras[n_ras++] = (min_ra + (int32_t)bounds[i].ra_width) % 86400;
+      spds[n_spds++] = CONSTBND_SPD( bounds + i);
+      }
+   n_ras = sort_unique( ras, n_ras);
+   n_spds = sort_unique( spds, n_spds);
+
+   if( grid->cells)
+      {
+      const double cell_ra = 86400. / (2. * height);     /* seconds */
+      const double cell_spd = 10800. / (double)height;   /* arcminutes */
+
+      grid->width = 2 * height;
+      grid->height = height;
+      for( row = 0; row < height; row++)
+         {
+         const double spd0 = row * cell_spd, spd1 = spd0 + cell_spd;
+         const size_t n_spd_cuts = cuts_in( spds, n_spds, spd0, spd1,
+                                            spd_cuts);
+         uint8_t *out = grid->cells + (size_t)row * grid->width;
+
+         for( col = 0; col < grid->width; col++)
+            {
+            const double ra0 = col * cell_ra, ra1 = ra0 + cell_ra;
+            int idx = constellation_index_at( (ra0 + ra1) / 480.,
+                                              (spd0 + spd1) / 120. - 90.);
+
+            if( !fill_mixed)
+               {
+               const size_t n_ra_cuts = cuts_in( ras, n_ras, ra0, ra1,
+                                                 ra_cuts);
+               size_t j, k;
+
+               for( j = 0; j + 1 < n_spd_cuts && idx != CONSTELL_IDX_NONE; j++)
+                  for( k = 0; k + 1 < n_ra_cuts; k++)
+                     if( constellation_index_at(
+                              (ra_cuts[k] + ra_cuts[k + 1]) / 480.,
+                              (spd_cuts[j] + spd_cuts[j + 1]) / 120. - 90.)
+                                 != idx)
+                        {
+                        idx = CONSTELL_IDX_NONE;
+                        grid->n_mixed++;
+                        break;
+                        }
+               }
+            out[col] = (uint8_t)idx;
+            }
+         }
+      }
+   free( ras);
+   free( spds);
+   free( ra_cuts);
+   free( spd_cuts);
+   if( grid->cells && !fill_mixed)
+      {
+      congrid_level_t fine;
+
+      fine.width = grid->width;
+      fine.height = grid->height;
+      fine.cells = grid->cells;
+      while( grid->n_coarse < CONGRID_MAX_COARSE && fine.height % 2 == 0
+                  && (size_t)fine.width * (size_t)fine.height > CONGRID_TOP_BYTES)
+         {
+         congrid_level_t *coarse = grid->coarse + grid->n_coarse;
+
+         if( build_coarse_level( coarse, &fine))
+            {
+            constellation_grid_free( grid);
+            return( -1);
+            }
+         grid->n_coarse++;
+         fine = *coarse;
+         }
+      }
+   return( grid->cells ? 0 : -1);
+}
+
+void constellation_grid_free( congrid_t *grid)
+{
+   int i;
+
+   for( i = 0; i < grid->n_coarse; i++)
+      free( grid->coarse[i].cells);
+   grid->n_coarse = 0;
+   free( grid->cells);
+   grid->cells = NULL;
+   grid->width = grid->height = 0;
+   grid->n_mixed = 0;
+}
+
+int constellation_grid_index_at( const congrid_t *grid,
+                                 const double ra, const double dec)
+{
+   double x = ra * (1. / 360.), y, fx, fy;
+   int row, col, idx, level;
+
+   if( dec < -90. || dec > 90.)
+      return( -1);
+   if( x < 0. || x >= 1.)
+      x -= floor( x);
+   y = (dec + 90.) * (1. / 180.);
+   for( level = grid->n_coarse; level >= 0; level--)
+      {
+      const congrid_level_t *lvl = (level ? grid->coarse + level - 1
+                                          : (const congrid_level_t *)NULL);
+      const int width = (lvl ? lvl->width : grid->width);
+      const int height = (lvl ? lvl->height : grid->height);
+      const double lx = x * width, ly = y * height;
+
+      col = (int)lx;
+      row = (int)ly;
+      if( col >= width)          /* x just under 1 can round up */
+         col = width - 1;
+      if( row >= height)         /* dec = +90 */
+         row = height - 1;
+      idx = (lvl ? lvl->cells : grid->cells)[(size_t)row * width + col];
+            /* A cell edge can also be a boundary,  and the scaling here */
+            /* rounds differently from 'conbound.c';  so a point within */
+            /* rounding error of an edge gets the exact test too.        */
+      fx = lx - col;
+      fy = ly - row;
+      if( fx < 1e-9 || fx > 1. - 1e-9 || fy < 1e-9 || fy > 1. - 1e-9)
+         return( constellation_index_at( ra, dec));
+      if( idx != CONSTELL_IDX_NONE)
+         return( idx);
+      }
+   return( constellation_index_at( ra, dec));
+}
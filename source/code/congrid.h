@@ -0,0 +1,86 @@
+/* congrid.h : constant-time constellation lookup from a raster.
+
+   The segment search in 'conbound.c' is O(log n) plus a walk.  For
+picking (and for shading on the GPU),  a plain equirectangular raster
+of constellation indices is quicker:  one multiply-and-truncate per
+coordinate and a byte load.  Most cells lie wholly inside one
+constellation and answer directly;  only the cells a boundary actually
+crosses are marked CONSTELL_IDX_NONE,  and lookups landing there fall
+back to constellation_index_at( ).  So the answers are exactly those
+of 'conbound.c',  just faster for nearly all points.
+
+   'Crossed' is decided exactly,  not by sampling:  every boundary lies
+on a segment SPD or a segment end RA,  so the breakpoints inside a cell
+cut it into rectangles that each belong to one constellation,  and the
+cell is uniform if they all agree.
+
+   A fine raster outgrows the cache,  so on top of it sit up to
+CONGRID_MAX_COARSE coarser ones,  each half as high and wide as the one
+below,  until one fits in CONGRID_TOP_BYTES.  A coarse cell holds a
+constellation index only if all four cells under it are uniform and
+agree;  otherwise it is CONSTELL_IDX_NONE,  which is its 'not uniform'
+flag.  Lookups start at the coarsest level and only go down one where
+the cell isn't uniform,  so the big raster is touched near boundaries
+only.  (On random points,  a 2880-high raster went from about 45 to 18
+ns a lookup with its two levels,  a 1440-high one from 29 to 18 with
+one.  A raster that already fits gets none:  there the extra step only
+costs.)
+
+   The same builder,  with 'fill_mixed' set,  instead puts the
+constellation at the centre of every cell,  giving a texture with no
+holes for per-fragment region shading;  see 'uConstellationRegions.h'.
+
+   Rows run south to north (row 0 starts at dec -90),  columns east
+from RA=0;  'width' is twice 'height',  so cells are square in degrees.
+Positions are B1875,  as everywhere in 'conbound.h'. */
+
+#ifndef CONGRID_H_INCLUDED
+#define CONGRID_H_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+#include "conbound.h"
+
+#define CONGRID_MAX_COARSE 3
+#define CONGRID_TOP_BYTES 1048576
+
+typedef struct
+   {
+   int width, height;         /* in cells */
+   uint8_t *cells;            /* width * height,  row-major */
+   } congrid_level_t;
+
+typedef struct
+   {
+   int width, height;         /* in cells */
+   uint8_t *cells;            /* width * height,  row-major */
+   size_t n_mixed;            /* cells marked CONSTELL_IDX_NONE */
+   int n_coarse;              /* levels in coarse[],  finest first */
+   congrid_level_t coarse[CONGRID_MAX_COARSE];
+   } congrid_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Builds a grid 'height' cells high (180/height degrees per cell) and
+twice that wide.  With fill_mixed = 0,  cells crossed by a boundary
+are CONSTELL_IDX_NONE,  and coarse levels are added as described above
+(for as long as the height halves evenly);  otherwise cells get the constellation at their
+centre and there are no coarse levels.  Returns 0,  or -1 if out of
+memory or height < 1. */
+int constellation_grid_build( congrid_t *grid, const int height,
+                                 const int fill_mixed);
+
+void constellation_grid_free( congrid_t *grid);
+
+/* Same result as constellation_index_at( ),  using the grid when it
+can.  The grid has to have been built with fill_mixed = 0. */
+int constellation_grid_index_at( const congrid_t *grid,
+                                 const double ra, const double dec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -2,7 +2,6 @@
 #include <string.h>
 #include <stdint.h>
 #include <stdlib.h>
-#include <malloc.h>
 #include <math.h>
 #include <assert.h>
 
@@ -13,13 +12,29 @@ corresponding to a given RA/dec.  See 'constbnd.txt' for a
 description of these boundaries and a few alternative methods for
 solving the point-in-constellation problem.
 
-   This code needs to work only once,  to create the compacted boundary
-list found in 'conbound.c' (which means this file is now of
-intellectual/documentation use only.)
+   This program _only_ generates the compacted subset.  That list is
+written to 'conbound_tbl.h',  which 'conbound.c' includes for the
+actual function to determine which constellation a given RA/dec is
+in,  and optionally to a binary blob (see below) for code that wants
+the table without compiling C.  Re-run it whenever the source data or
+the packing changes,  then run 'converify' to make sure the lookup
+still gives the answers the source data does.  'make tables' does the
+first for the committed 'conbound_tbl.h' and
+'data/constellation/conbound.tbl';  'make check-tables' regenerates
+both under 'build' and fails if they differ from the committed ones :
 
-   This program _only_ generates the compacted subset.  That list
-appears in,  and is used in,  'conbound.c' for the actual function
-to determine which constellation a given RA/dec is in.
+   constbnd [-d constbnd.dat] [-o conbound_tbl.h] [-b conbound.tbl] [-v]
+
+   By default,  the boundaries are taken from the rows of 'constel.c'
+(which is compiled in;  that's what the checked-in 'conbound_tbl.h' is
+made from,  and the output should match it byte for byte).  With -d,
+they're read from 'constbnd.dat' instead,  as originally.  -v lists
+the boundaries in human-readable form on stdout.
+
+   The blob is a four-byte "CBT1",  a little-endian uint32 count of
+segments,  and then the segments as packed in 'conbound.h' :  uint32
+spd_ra,  uint16 ra_width,  uint8 constell_idx,  uint8 zero,  all
+little-endian.
 
    The input constellation boundary data are also available at
 
@@ -96,14 +111,14 @@ typedef struct
    int16_t spd;      /* in arcminutes */
    int32_t min_ra, max_ra;   /* in seconds */
    char constell_idx;      /* from 0 to 87 */
-   } constbnd_t;
+   } bound_t;
 
 typedef struct
    {
    int32_t x, y;
    } point_t;
 
-constbnd_t *bounds;
+bound_t *bounds;
 int n_bounds = 0;
 
 const char *constell_names =
@@ -112,6 +127,31 @@ const char *constell_names =
         "LacLeoLepLibLMiLupLynLyrMenMicMonMusNorOctOphOriPavPegPerPhePicPsA"
         "PscPupPyxRetSclScoSctSerSexSgeSgrTauTelTrATriTucUMaUMiVelVirVolVul";
 
+static void add_bound( const int32_t spd, const int32_t min_ra,
+                       const int32_t max_ra, const int constell_idx)
+{
+   bounds[n_bounds].spd = (int16_t)spd;
+   bounds[n_bounds].min_ra = min_ra;
+   bounds[n_bounds].max_ra = max_ra;
+   bounds[n_bounds].constell_idx = (char)constell_idx;
+   n_bounds++;
+}
+
+      /* The RA width has to fit in 16 bits;  halve anything longer. */
+static void split_long_spans( void)
+{
+   int i;
+   const int n = n_bounds;
+
+   for( i = 0; i < n; i++)
+      if( bounds[i].max_ra - bounds[i].min_ra > 65000)
+         {
+         bounds[n_bounds] = bounds[i];
+         bounds[n_bounds++].min_ra = bounds[i].max_ra
+                  = (bounds[i].min_ra + bounds[i].max_ra) / 2;
+         }
+}
+
 static void dump_lines( const int n_pts, const point_t *p, const int constell_idx)
 {
    int i, j;
@@ -158,30 +198,22 @@ static void dump_lines( const int n_pts, const point_t *p, const int constell_id
             min_ra = (7 * 60 + 40) * 60;
             max_ra = (27 * 60 + 30) * 60;
             }
-         bounds[n_bounds].spd = spd0;
-         bounds[n_bounds].min_ra = min_ra;
-         bounds[n_bounds].max_ra = max_ra;
-         bounds[n_bounds].constell_idx = (char)constell_idx;
-         if( max_ra - min_ra > 65000)     /* long spans require splitting */
-            {
-            bounds[n_bounds + 1] = bounds[n_bounds];
-            bounds[n_bounds + 1].min_ra = bounds[n_bounds].max_ra
-                        = (min_ra + max_ra) / 2;
-            n_bounds++;
-            }
-         n_bounds++;
+         add_bound( spd0, min_ra, max_ra, constell_idx);
          }
 }
 
-int main( const int argc, const char **argv)
+static int read_constbnd_dat( const char *filename)
 {
-   FILE *ifile = fopen( "constbnd.dat", "rb");
+   FILE *ifile = fopen( filename, "rb");
    char buff[100];
-   int i, j;
+   int i;
    point_t *p = (point_t *)calloc( 1000, sizeof( point_t));
 
-   bounds = (constbnd_t *)calloc( 2000, sizeof( constbnd_t));
-   assert( ifile);
+   if( !ifile)
+      {
+      perror( filename);
+      return( -1);
+      }
    while( fgets( buff, sizeof( buff), ifile))
       {
       char constell[4];
@@ -221,51 +253,289 @@ int main( const int argc, const char **argv)
             n_pts++;
          }
       if( memcmp( constell, "Vul", 3))
-         fseek( ifile, -strlen( buff), SEEK_CUR);
-      printf( "Constell %s\n", constell);
+         fseek( ifile, -(long)strlen( buff), SEEK_CUR);
       if( shift_24)
          for( i = 0; i < n_pts; i++)
             p[i].x += 86400;
-      for( i = 0; i < n_pts; i++)
-         printf( "%9.5f %+09.5f\n",
-                  (double)p[i].x / 3600.,
-                  (double)p[i].y / 60. - 90.);
       dump_lines( n_pts, p, constell_idx);
       }
    fclose( ifile);
    free( p);
-   printf( "%d bounds found\n", n_bounds);
-            /* Sort by decreasing dec.  No need to be efficient here. */
-   for( i = 0; i < n_bounds - 1; i++)
-      if( i >= 0)
-         if( bounds[i + 1].spd > bounds[i].spd
-                  || (bounds[i + 1].spd == bounds[i].spd && bounds[i + 1].min_ra > bounds[i].min_ra))
-            {
-            const constbnd_t temp = bounds[i + 1];
+   return( 0);
+}
+
+/* The rows of 'constel.c' give,  for each constellation,  strips with a
+southern dec and an RA range;  a point belongs to the first row (going
+south) that covers it.  Those rows are on the same integer arcminute /
+RA second grid as 'constbnd.dat',  once the float rounding is undone.
 
-            bounds[i + 1] = bounds[i];
-            bounds[i] = temp;
-            i -= 2;
+   So at every dec that starts a row,  walk the RA breakpoints and ask
+the rows which constellation is just north and just south of that dec
+(at half-unit offsets,  so we're never on a boundary).  Where they
+differ,  there's a boundary,  stored for the southern constellation;
+adjacent pieces for the same constellation are merged,  including
+across RA=0. */
+
+#define main constel_main
+#include "constel.c"
+#undef main
+
+typedef struct
+   {
+   int32_t min_ra, max_ra, spd;     /* seconds,  arcminutes */
+   int constell_idx;
+   } row_t;
+
+static row_t *rows;
+static int n_rows;
+
+         /* RA in half-seconds,  SPD in half-arcminutes */
+static int row_constell_idx( const int32_t ra2, const int32_t spd2)
+{
+   int i;
+
+   for( i = 0; i < n_rows; i++)
+      if( ra2 >= 2 * rows[i].min_ra && ra2 < 2 * rows[i].max_ra
+                     && spd2 >= 2 * rows[i].spd)
+         return( rows[i].constell_idx);
+   return( -1);
+}
+
+static int compare_int32s( const void *a, const void *b)
+{
+   const int32_t ia = *(const int32_t *)a, ib = *(const int32_t *)b;
+
+   return( ia < ib ? -1 : (ia > ib ? 1 : 0));
+}
+
+static int sort_unique( int32_t *array, const int n)
+{
+   int i, j;
+
+   qsort( array, n, sizeof( int32_t), compare_int32s);
+   for( i = j = 1; i < n; i++)
+      if( array[i] != array[j - 1])
+         array[j++] = array[i];
+   return( j);
+}
+
+static int read_constel_rows( void)
+{
+   const int n_data = (int)ITEMS( data);
+   int32_t *ras = (int32_t *)malloc( (2 * n_data + 2) * sizeof( int32_t));
+   int32_t *spds = (int32_t *)malloc( n_data * sizeof( int32_t));
+   int i, j, n_ras = 0, n_spds = 0;
+
+   rows = (row_t *)calloc( n_data, sizeof( row_t));
+   n_rows = 0;
+   for( i = 1; i < n_data; i++)     /* data[0] is the pole sentinel */
+      {
+      const double ra0 = data[i].ral * 240., ra1 = data[i].rau * 240.;
+      const double spd = (data[i].del + 90.) * 60.;
+      row_t *r = rows + n_rows++;
+
+      r->min_ra = (int32_t)floor( ra0 + .5);
+      r->max_ra = (int32_t)floor( ra1 + .5);
+      r->spd = (int32_t)floor( spd + .5);
+      if( fabs( ra0 - r->min_ra) > .05 || fabs( ra1 - r->max_ra) > .05
+                           || fabs( spd - r->spd) > .01)
+         {
+         fprintf( stderr, "Row %d (%s) isn't on the grid\n", i, data[i].cst);
+         return( -1);
+         }
+      r->constell_idx = -1;
+      for( j = 0; j < 88; j++)
+         if( !memcmp( constell_names + j * 3, data[i].cst, 3))
+            r->constell_idx = j;
+      if( r->constell_idx < 0)
+         {
+         fprintf( stderr, "Unknown constellation '%s'\n", data[i].cst);
+         return( -1);
+         }
+      ras[n_ras++] = r->min_ra;
+      ras[n_ras++] = r->max_ra;
+      spds[n_spds++] = r->spd;
+      }
+   ras[n_ras++] = 0;
+   ras[n_ras++] = 86400;
+   n_ras = sort_unique( ras, n_ras);
+   n_spds = sort_unique( spds, n_spds);
+
+   for( j = n_spds - 1; j >= 0; j--)
+      {
+      const int32_t spd = spds[j];
+      const int first = n_bounds;
+
+      if( spd <= 0 || spd >= 180 * 60)
+         continue;
+      for( i = 0; i + 1 < n_ras; i++)
+         {
+         const int32_t mid2 = ras[i] + ras[i + 1];
+         const int north = row_constell_idx( mid2, 2 * spd);
+         const int south = row_constell_idx( mid2, 2 * spd - 1);
+
+         if( north == south)
+            continue;
+         if( n_bounds > first && bounds[n_bounds - 1].constell_idx == south
+                     && bounds[n_bounds - 1].max_ra == ras[i])
+            bounds[n_bounds - 1].max_ra = ras[i + 1];
+         else
+            add_bound( spd, ras[i], ras[i + 1], south);
+         }
+               /* join a piece ending at 24h to one starting at 0h */
+      if( n_bounds - first >= 2 && bounds[first].min_ra == 0
+                  && bounds[n_bounds - 1].max_ra == 86400
+                  && bounds[first].constell_idx == bounds[n_bounds - 1].constell_idx)
+         {
+         bounds[n_bounds - 1].max_ra += bounds[first].max_ra;
+         bounds[first] = bounds[--n_bounds];
+         }
+      }
+   free( ras);
+   free( spds);
+   free( rows);
+   return( 0);
+}
+
+   /* North first;  segments at the same SPD don't overlap,  so the
+RA order there is only for the sake of a stable output. */
+
+static int compare_bounds( const void *a, const void *b)
+{
+   const bound_t *ba = (const bound_t *)a, *bb = (const bound_t *)b;
+
+   if( ba->spd != bb->spd)
+      return( ba->spd > bb->spd ? -1 : 1);
+   if( ba->min_ra != bb->min_ra)
+      return( ba->min_ra < bb->min_ra ? -1 : 1);
+   if( ba->max_ra != bb->max_ra)
+      return( ba->max_ra < bb->max_ra ? -1 : 1);
+   return( ba->constell_idx - bb->constell_idx);
+}
+
+static void put_le( unsigned char *buff, uint32_t value, const int n_bytes)
+{
+   int i;
+
+   for( i = 0; i < n_bytes; i++, value >>= 8)
+      buff[i] = (unsigned char)value;
+}
+
+static int write_blob( const char *filename)
+{
+   FILE *ofile = fopen( filename, "wb");
+   unsigned char buff[8];
+   int i, rval = 0;
+
+   if( !ofile)
+      {
+      perror( filename);
+      return( -1);
+      }
+   put_le( buff, (uint32_t)n_bounds, 4);
+   if( fwrite( "CBT1", 4, 1, ofile) != 1 || fwrite( buff, 4, 1, ofile) != 1)
+      rval = -1;
+   for( i = 0; !rval && i < n_bounds; i++)
+      {
+      put_le( buff, (uint32_t)bounds[i].min_ra
+                  | ((uint32_t)bounds[i].spd << 17), 4);
+      put_le( buff + 4, (uint32_t)( bounds[i].max_ra - bounds[i].min_ra), 2);
+      buff[6] = (unsigned char)bounds[i].constell_idx;
+      buff[7] = 0;
+      if( fwrite( buff, 8, 1, ofile) != 1)
+         rval = -1;
+      }
+   if( fclose( ofile) || rval)
+      {
+      perror( filename);
+      return( -1);
+      }
+   return( 0);
+}
+
+static int write_header( const char *filename, const char *source)
+{
+   FILE *ofile = fopen( filename, "w");
+   int i;
+
+   if( !ofile)
+      {
+      perror( filename);
+      return( -1);
+      }
+   fprintf( ofile, "/* Packed constellation boundary segments,  generated from %s "
+                   "(N.G. Roman, 1987PASP...99..695R).  See 'conbound.h' for\n"
+                   "the layout.  Do not edit by hand. */\n\n", source);
+   for( i = 0; i < n_bounds; i++)
+      fprintf( ofile, "   { 0x%08lx, 0x%04lx, %2d, 0 },   /* %.3s */\n",
+                  (unsigned long)bounds[i].min_ra | ((unsigned long)bounds[i].spd << 17),
+                  (unsigned long)(bounds[i].max_ra - bounds[i].min_ra),
+                  (int)bounds[i].constell_idx,
+                  constell_names + 3 * bounds[i].constell_idx);
+   if( fclose( ofile))
+      {
+      perror( filename);
+      return( -1);
+      }
+   return( 0);
+}
+
+int main( const int argc, const char **argv)
+{
+   const char *dat_file = NULL, *header_file = "conbound_tbl.h";
+   const char *blob_file = NULL;
+   int i, j, verbose = 0;
+
+   for( i = 1; i < argc; i++)
+      if( argv[i][0] == '-' && argv[i][1] && !argv[i][2]
+                     && (argv[i][1] == 'v' || i + 1 < argc))
+         switch( argv[i][1])
+            {
+            case 'd':
+               dat_file = argv[++i];
+               break;
+            case 'o':
+               header_file = argv[++i];
+               break;
+            case 'b':
+               blob_file = argv[++i];
+               break;
+            case 'v':
+               verbose = 1;
+               break;
+            default:
+               fprintf( stderr, "Unknown option '%s'\n", argv[i]);
+               return( -1);
             }
+      else
+         {
+         fprintf( stderr, "Usage:  constbnd [-d constbnd.dat] "
+                          "[-o conbound_tbl.h] [-b conbound.tbl] [-v]\n");
+         return( -1);
+         }
+
+   bounds = (bound_t *)calloc( 2000, sizeof( bound_t));
+   if( dat_file ? read_constbnd_dat( dat_file) : read_constel_rows( ))
+      return( -1);
+   split_long_spans( );
+   qsort( bounds, n_bounds, sizeof( bound_t), compare_bounds);
    for( i = j = 1; i < n_bounds; i++)     /* remove duplicates */
-      if( memcmp( bounds + i, bounds + i - 1, sizeof( bounds[0])))
+      if( compare_bounds( bounds + i, bounds + i - 1))
          bounds[j++] = bounds[i];
    n_bounds = j;
-   printf( "%d bounds found after removing duplicates\n", n_bounds);
-           /* Output boundary list in human-readable form */
-   for( i = 0; i < n_bounds; i++)
-      printf( "Line at dec %+09.5f, RA %9.5f to %9.5f : %.3s\n",
+   fprintf( stderr, "%d bounds found\n", n_bounds);
+   if( verbose)      /* Output boundary list in human-readable form */
+      for( i = 0; i < n_bounds; i++)
+         printf( "Line at dec %+09.5f, RA %9.5f to %9.5f : %.3s\n",
                   (double)bounds[i].spd / 60. - 90.,
                   (double)bounds[i].min_ra / 3600.,
                   (double)bounds[i].max_ra / 3600.,
                   constell_names + bounds[i].constell_idx * 3);
-           /* Output boundary list as a C array;  see conbound.c */
-   for( i = 0; i < n_bounds; i++)
-         printf( "    { 0x%08lx, 0x%04lx, %2d },   /* %.3s */\n",
-                  (unsigned long)bounds[i].min_ra | ((unsigned long)bounds[i].spd << 17),
-                  (unsigned long)(bounds[i].max_ra - bounds[i].min_ra),
-                  (int)bounds[i].constell_idx,
-                  constell_names + 3 * bounds[i].constell_idx);
+   if( write_header( header_file, dat_file ? "\n'constbnd.dat'"
+                                           : "the rows of\n'constel.c'"))
+      return( -1);
+   if( blob_file && write_blob( blob_file))
+      return( -1);
    free( bounds);
    return( 0);
 }
@@ -423,11 +423,10 @@ void main(int argc, char **argv)
 {
   ROW *pr, *pe, *br ;
   float ral, rau, ra, de ;
-  char *pgm, *p, *form, *z ;
+  char *p, *form, *z ;
   int n ;
 
     /* Argument must be a position or a constellation name */
-    pgm = *argv ;	/* Program name */
     form = format ;	/* -p option... */
     while (--argc > 0) {
 	p = *++argv ;
@@ -435,6 +434,7 @@ void main(int argc, char **argv)
 	    case 'p': form = formap ; continue ;
 	    default:
 	      fprintf(stderr, "****Invalid option: %s\n", p) ;
+	      /* FALLTHRU */
 	    case 'h':	/* Assume Help */
 	      fprintf(stderr, "%s", usage);
 	      exit(1) ;
@@ -498,7 +498,7 @@ void main(int argc, char **argv)
 	    if ((ra >= pr->ral) && (ra < pr->rau) && (de >= pr->del)) break ;
 	}
 	if (pr < pe) p = pr->cst;
-	else p = "???" ;
+	else p = (char *)"???" ;
 	printf("%8.4f%+08.4f %s\n", ra, de, p) ;
     }
     exit(0) ;
@@ -0,0 +1,181 @@
+/* converify.c : check the packed boundary table against 'constel.c'.
+
+   'conbound.c' answers "which constellation is this?" from the table
+that 'constbnd' generates;  'constel.c' answers it by scanning its
+'data[]' rows,  the way the published boundaries are laid out.  This
+sweeps the whole sphere on an arcminute grid and asks both (plus the
+batch classifier and the raster in 'congrid.h',  built big enough to
+have coarse levels),  and fails if any answer differs.  Run it after
+regenerating 'conbound_tbl.h' or touching the lookup code :
+
+   converify [-s step] [-b conbound.tbl]
+
+   -s sets the grid step in arcminutes (default 1,  about 233 million
+points;  a larger step makes a quicker smoke test).  -b also checks
+that a blob written by 'constbnd -b' holds the same segments as the
+compiled-in table.
+
+   Points sit at the centres of the grid cells,  offset by an eighth of
+an arcminute in RA.  The boundaries fall on whole arcminutes of dec and
+whole seconds of RA,  so no point is on one;  'constel.c' keeps its
+rows as floats (30.6667 and so on),  and a point right on a boundary
+could legitimately go either way.
+
+   Rows of the grid are independent,  so they're spread over threads
+with OpenMP when it's enabled (e.g.,  -fopenmp);  without it,  this
+just takes longer.  'constel.c' is built in with its main( ) renamed,
+so this always compares against the real table. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "conbound.h"
+#include "congrid.h"
+
+#define main constel_main
+#include "constel.c"
+#undef main
+
+#define MAX_REPORTED    20
+
+static int row_idx[ITEMS( data)];
+
+static int scan_index( const float ra, const float de)
+{
+   const ROW *pr, *pe = data + ITEMS( data);
+
+   for( pr = data + 1; pr < pe; pr++)
+      if( ra >= pr->ral && ra < pr->rau && de >= pr->del)
+         return( row_idx[pr - data]);
+   return( -1);
+}
+
+static uint32_t get_le( const unsigned char *buff, const int n_bytes)
+{
+   uint32_t rval = 0;
+   int i;
+
+   for( i = n_bytes - 1; i >= 0; i--)
+      rval = (rval << 8) | buff[i];
+   return( rval);
+}
+
+static int check_blob( const char *filename)
+{
+   FILE *ifile = fopen( filename, "rb");
+   unsigned char buff[8];
+   size_t i, n_bounds;
+   const constbnd_t *bounds = constellation_bounds( &n_bounds);
+   int rval = 0;
+
+   if( !ifile)
+      {
+      perror( filename);
+      return( -1);
+      }
+   if( fread( buff, 8, 1, ifile) != 1 || memcmp( buff, "CBT1", 4)
+               || get_le( buff + 4, 4) != n_bounds)
+      rval = -1;
+   for( i = 0; !rval && i < n_bounds; i++)
+      if( fread( buff, 8, 1, ifile) != 1
+               || get_le( buff, 4) != bounds[i].spd_ra
+               || get_le( buff + 4, 2) != bounds[i].ra_width
+               || buff[6] != bounds[i].constell_idx)
+         rval = -1;
+   if( !rval && fread( buff, 1, 1, ifile))
+      rval = -1;           /* trailing junk */
+   fclose( ifile);
+   printf( "%s %s the compiled-in table\n", filename,
+                  rval ? "does NOT match" : "matches");
+   return( rval);
+}
+
+int main( const int argc, const char **argv)
+{
+   int step = 1, i, n_ra, n_dec, j;
+   const char *blob_file = NULL;
+   long n_mismatch = 0, n_reported = 0;
+   clock_t t0 = clock( );
+   congrid_t grid;
+
+   for( i = 1; i < argc; i++)
+      if( !strcmp( argv[i], "-s") && i + 1 < argc)
+         step = atoi( argv[++i]);
+      else if( !strcmp( argv[i], "-b") && i + 1 < argc)
+         blob_file = argv[++i];
+      else
+         {
+         fprintf( stderr, "Usage:  converify [-s step] [-b conbound.tbl]\n");
+         return( -1);
+         }
+   if( step < 1)
+      step = 1;
+   for( i = 1; i < (int)ITEMS( data); i++)
+      {
+      for( j = 0; j < N_CONSTELLATIONS
+                  && strcmp( constellation_name( j), data[i].cst); j++)
+         ;
+      if( j == N_CONSTELLATIONS)
+         {
+         fprintf( stderr, "Unknown constellation '%s'\n", data[i].cst);
+         return( -1);
+         }
+      row_idx[i] = j;
+      }
+   if( blob_file && check_blob( blob_file))
+      return( -1);
+   if( constellation_grid_build( &grid, 2880, 0))
+      return( -1);
+
+   n_ra = 360 * 60 / step;
+   n_dec = 180 * 60 / step;
+#ifdef _OPENMP
+   #pragma omp parallel for schedule( dynamic, 16) reduction( +: n_mismatch)
+#endif
+   for( j = 0; j < n_dec; j++)
+      {
+      const float dec = -90.f + ((float)( j * step) + .5f) / 60.f;
+      float *ra = (float *)malloc( n_ra * sizeof( float));
+      float *decs = (float *)malloc( n_ra * sizeof( float));
+      uint8_t *batch = (uint8_t *)malloc( n_ra);
+      int k;
+
+      for( k = 0; k < n_ra; k++)
+         {
+         ra[k] = ((float)( k * step) + .125f) / 60.f;
+         decs[k] = dec;
+         }
+      constellation_classify( ra, decs, batch, (size_t)n_ra);
+      for( k = 0; k < n_ra; k++)
+         {
+         const int expected = scan_index( ra[k], dec);
+         const int single = constellation_index_at( ra[k], dec);
+         const int raster = constellation_grid_index_at( &grid, ra[k], dec);
+
+         if( single != expected || batch[k] != expected || raster != expected)
+            {
+            n_mismatch++;
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            if( n_reported++ < MAX_REPORTED)
+               printf( "RA %9.5f dec %+09.5f :  constel.c %s,  "
+                       "table %s,  batch %s,  raster %s\n", ra[k], dec,
+                       constellation_name( expected),
+                       constellation_name( single),
+                       constellation_name( batch[k]),
+                       constellation_name( raster));
+            }
+         }
+      free( ra);
+      free( decs);
+      free( batch);
+      }
+   constellation_grid_free( &grid);
+   printf( "%ld of %ld points differ (%d' grid,  %.1f s CPU)\n",
+               n_mismatch, (long)n_ra * (long)n_dec, step,
+               (double)( clock( ) - t0) / (double)CLOCKS_PER_SEC);
+   return( n_mismatch ? 1 : 0);
+}
@@ -0,0 +1,175 @@
+//---------------------------------------------------------------------------
+// figverify : checks the compiled-in figure table (uConstFiguresData.h)
+// against Constellation[] in uConstellations.pas.
+//
+//   Usage:  figverify [uConstellations.pas]
+//
+// Every "(dm:..;ra:..;dec:..;bay:..)" row of the Pascal table must match
+// the record at the same position in draw mode, RA and Dec, and the last
+// {n} comment on the row (the figure the star belongs to) must equal the
+// record's Figure.  Then each figure's segments in ConstFigureSegments
+// must be the lines of the table that belong to it: a line whose two stars
+// carry the same tag belongs to that figure, any other to the figure most
+// stars of its polyline are tagged with (the first star's on a tie), so
+// the Beta Tau corner stays in Auriga and Alpha And in Pegasus.  Prints
+// each mismatch; the exit code is 1 if there was any, -1 if the file
+// can't be read and 0 otherwise.
+//---------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "uConstFigures.h"
+
+//---------------------------------------------------------------------------
+namespace
+{
+// The integer after Key in Line, e.g. Field(Line, "ra:").
+bool Field(const std::string& Line, const char* Key, int& Value)
+{
+	const size_t At = Line.find(Key);
+	if (At == std::string::npos)
+		return false;
+	const char* Start = Line.c_str() + At + std::char_traits<char>::length(Key);
+	char* End;
+	Value = static_cast<int>(std::strtol(Start, &End, 10));
+	return End != Start;
+}
+
+// The number in the last {n} comment of Line.
+bool FigureTag(const std::string& Line, int& Figure)
+{
+	for (size_t Open = Line.rfind('{'); Open != std::string::npos;
+		Open = Open ? Line.rfind('{', Open - 1) : std::string::npos)
+	{
+		const size_t Close = Line.find('}', Open);
+		const std::string Tag = Line.substr(Open + 1, Close - Open - 1);
+		if (Close != std::string::npos && !Tag.empty()
+			&& Tag.find_first_not_of("0123456789") == std::string::npos)
+		{
+			Figure = std::atoi(Tag.c_str());
+			return true;
+		}
+	}
+	return false;
+}
+
+// Figure of the line drawn to row i, from the tags alone.
+int LineFigure(const std::vector<int>& DrawModes, const std::vector<int>& Tags,
+	size_t i)
+{
+	if (Tags[i - 1] == Tags[i])
+		return Tags[i];
+	size_t First = i, Last = i + 1;
+	while (DrawModes[First] != -2)
+		First--;
+	while (Last < DrawModes.size() && DrawModes[Last] == -1)
+		Last++;
+	int Best = Tags[First];
+	size_t BestCount = 0;
+	for (size_t j = First; j < Last; j++)
+	{
+		size_t Count = 0;
+		for (size_t k = First; k < Last; k++)
+			Count += Tags[k] == Tags[j];
+		if (Count > BestCount)
+		{
+			Best = Tags[j];
+			BestCount = Count;
+		}
+	}
+	return Best;
+}
+} // namespace
+
+//---------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	const char* FileName = argc > 1 ? argv[1] : "uConstellations.pas";
+	std::ifstream Pascal(FileName);
+	if (!Pascal)
+	{
+		std::fprintf(stderr, "%s: can't read\n", FileName);
+		return -1;
+	}
+
+	const size_t Count = std::size(ConstFigureRecords);
+	size_t Row = 0, Errors = 0;
+	std::vector<int> DrawModes, Tags;
+	std::string Line;
+	for (int LineNo = 1; std::getline(Pascal, Line); LineNo++)
+	{
+		int DrawMode, RA, Dec, Figure;
+		if (!Field(Line, "(dm:", DrawMode))
+			continue;
+		if (Row >= Count)
+		{
+			std::printf("%s(%d): more rows than the %zu records\n", FileName,
+				LineNo, Count);
+			Errors++;
+			break;
+		}
+		const ConstFigureRecord& r = ConstFigureRecords[Row];
+		if (!Field(Line, "ra:", RA) || !Field(Line, "dec:", Dec)
+			|| !FigureTag(Line, Figure))
+		{
+			std::printf("%s(%d): can't parse the row\n", FileName, LineNo);
+			Errors++;
+			Figure = -1;
+		}
+		else if (DrawMode != r.DrawMode || RA != r.RA || Dec != r.Dec)
+		{
+			std::printf("%s(%d): record %zu is {%d, %d, %d}, the row "
+				"{%d, %d, %d}\n", FileName, LineNo, Row, r.DrawMode, r.RA,
+				r.Dec, DrawMode, RA, Dec);
+			Errors++;
+		}
+		else if (Figure != r.Figure)
+		{
+			std::printf("%s(%d): record %zu is in figure %d, the row in "
+				"{%d}\n", FileName, LineNo, Row, r.Figure, Figure);
+			Errors++;
+		}
+		DrawModes.push_back(DrawMode);
+		Tags.push_back(Figure);
+		Row++;
+	}
+	if (!Errors && Row != Count)
+	{
+		std::printf("%s: %zu rows for %zu records\n", FileName, Row, Count);
+		Errors++;
+	}
+
+	// The segments, once the records are known to match the rows.
+	if (!Errors)
+	{
+		std::vector<std::vector<uint16_t>> Lines(ConstFigureCount);
+		for (size_t i = 1; i < Row; i++)
+			if (DrawModes[i] == -1)
+			{
+				std::vector<uint16_t>& l = Lines[LineFigure(DrawModes, Tags, i)];
+				l.push_back(ConstFigureRecordVertex[i - 1]);
+				l.push_back(ConstFigureRecordVertex[i]);
+			}
+		for (int f = 0; f < ConstFigureCount; f++)
+		{
+			const std::vector<uint16_t> Segments(
+				ConstFigureSegments.begin() + 2 * ConstFigureSegmentStart[f],
+				ConstFigureSegments.begin() + 2 * ConstFigureSegmentStart[f + 1]);
+			if (Segments != Lines[f])
+			{
+				std::printf("figure %d (%s): %zu segments, the table has %zu "
+					"lines for it\n", f, ConstFigureNames[f], Segments.size() / 2,
+					Lines[f].size() / 2);
+				Errors++;
+			}
+		}
+	}
+	std::printf("%zu records and %d figures checked, %zu mismatches\n", Row,
+		ConstFigureCount, Errors);
+	return Errors ? 1 : 0;
+}
+//---------------------------------------------------------------------------
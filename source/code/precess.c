@@ -0,0 +1,88 @@
+#include <math.h>
+#include "precess.h"
+
+#define PI 3.1415926535897932384626433832795028841971693993751058209749445923
+#define ARCSEC_TO_RADIANS (PI / (180. * 3600.))
+
+/* IAU 1976 precession angles (Lieske et al.,  1977A&A....58....1L).  T
+is the starting epoch and t the interval,  both in Julian centuries from
+J2000;  the rotation is Rz(-z) * Ry(theta) * Rz(-zeta). */
+
+void setup_precession( double *matrix, const double year_from,
+                                 const double year_to)
+{
+   const double T = (year_from - 2000.) / 100.;
+   const double t = (year_to - year_from) / 100.;
+   const double t2 = t * t, t3 = t2 * t;
+   const double base = 2306.2181 + 1.39656 * T - 0.000139 * T * T;
+   const double zeta = (base * t + (0.30188 - 0.000344 * T) * t2
+                                 + 0.017998 * t3) * ARCSEC_TO_RADIANS;
+   const double z = (base * t + (1.09468 + 0.000066 * T) * t2
+                                 + 0.018203 * t3) * ARCSEC_TO_RADIANS;
+   const double theta = ((2004.3109 - 0.85330 * T - 0.000217 * T * T) * t
+                   - (0.42665 + 0.000217 * T) * t2
+                   - 0.041833 * t3) * ARCSEC_TO_RADIANS;
+   const double czeta = cos( zeta), szeta = sin( zeta);
+   const double cz = cos( z), sz = sin( z);
+   const double ctheta = cos( theta), stheta = sin( theta);
+
+   matrix[0] = czeta * ctheta * cz - szeta * sz;
+   matrix[1] = -szeta * ctheta * cz - czeta * sz;
+   matrix[2] = -stheta * cz;
+   matrix[3] = czeta * ctheta * sz + szeta * cz;
+   matrix[4] = -szeta * ctheta * sz + czeta * cz;
+   matrix[5] = -stheta * sz;
+   matrix[6] = czeta * stheta;
+   matrix[7] = -szeta * stheta;
+   matrix[8] = ctheta;
+}
+
+/* Positions are run through in blocks,  as three passes :  to unit
+vectors,  the rotation,  and back to RA/dec.  The middle pass is plain
+multiply-adds over arrays,  which the compiler vectorises;  the outer
+two are where the (unavoidable) trig goes.  */
+
+#define BLOCK_SIZE 256
+
+void precess_positions( const double *matrix,
+               const float *ra_in, const float *dec_in,
+               float *ra_out, float *dec_out, const size_t n)
+{
+   double x[BLOCK_SIZE], y[BLOCK_SIZE], z[BLOCK_SIZE];
+   double x1[BLOCK_SIZE], y1[BLOCK_SIZE], z1[BLOCK_SIZE];
+   size_t i, j, block;
+
+   for( i = 0; i < n; i += block)
+      {
+      block = (n - i < BLOCK_SIZE ? n - i : BLOCK_SIZE);
+      for( j = 0; j < block; j++)
+         {
+         const double ra = (double)ra_in[i + j] * (PI / 180.);
+         const double dec = (double)dec_in[i + j] * (PI / 180.);
+         const double cos_dec = cos( dec);
+
+         x[j] = cos_dec * cos( ra);
+         y[j] = cos_dec * sin( ra);
+         z[j] = sin( dec);
+         }
+      for( j = 0; j < block; j++)
+         {
+         x1[j] = matrix[0] * x[j] + matrix[1] * y[j] + matrix[2] * z[j];
+         y1[j] = matrix[3] * x[j] + matrix[4] * y[j] + matrix[5] * z[j];
+         z1[j] = matrix[6] * x[j] + matrix[7] * y[j] + matrix[8] * z[j];
+         }
+      for( j = 0; j < block; j++)
+         {
+         double ra = atan2( y1[j], x1[j]) * (180. / PI);
+
+         if( ra < 0.)
+            ra += 360.;
+         if( z1[j] > 1.)        /* guard against rounding at the poles */
+            z1[j] = 1.;
+         else if( z1[j] < -1.)
+            z1[j] = -1.;
+         ra_out[i + j] = (float)ra;
+         dec_out[i + j] = (float)( asin( z1[j]) * (180. / PI));
+         }
+      }
+}
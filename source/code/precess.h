@@ -0,0 +1,41 @@
+/* precess.h : rotate RA/decs between equinoxes,  in batches.
+
+   The constellation boundaries are defined for B1875,  while everything
+else we have (IAU-CSN,  Hipparcos) is J2000.  The precession angles are
+the IAU 1976 (Lieske) ones,  which are good to well under an arcsecond
+over this span.  Building the 3x3 rotation matrix is the only part with
+much trig in it,  so do it once per pair of epochs with
+setup_precession( ),  then hand whole arrays to precess_positions( ).
+
+   Epochs are given as Julian years (J2000 = 2000.0);  B1875.0 is
+slightly off a round Julian year,  hence EPOCH_B1875. */
+
+#ifndef PRECESS_H_INCLUDED
+#define PRECESS_H_INCLUDED
+
+#include <stddef.h>
+
+#define EPOCH_J2000     2000.
+#define EPOCH_B1875     1875.0013923353
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Fills matrix[9] (row-major) with the rotation taking equatorial unit
+vectors for equinox 'year_from' to equinox 'year_to'. */
+void setup_precession( double *matrix, const double year_from,
+                                 const double year_to);
+
+/* Applies 'matrix' to n positions,  RA and dec in decimal degrees.  The
+output RAs are in 0..360.  ra_out/dec_out may be the same arrays as
+ra_in/dec_in. */
+void precess_positions( const double *matrix,
+               const float *ra_in, const float *dec_in,
+               float *ra_out, float *dec_out, const size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
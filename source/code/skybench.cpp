@@ -0,0 +1,739 @@
+//---------------------------------------------------------------------------
+// skybench : micro- and macro-benchmarks for the sky core, with JSON
+// results and a baseline to flag regressions against.
+//
+//   Usage:  skybench [-d data_dir] [-H hip_main.dat] [-f filter]
+//                    [-n samples] [-m min_ms] [-o results.json]
+//                    [-b baseline.json] [-r percent] [-l]
+//
+// -d is the 'data' directory (default 'data'); -H adds the Hipparcos main
+// catalogue, without which the catalog has no parallaxes and the octree
+// benchmark is skipped.  -f runs only the benchmarks whose names contain
+// the filter, e.g. "-f lookup." or "-f spatial.cone".  -l lists them.
+//
+// Each benchmark is timed in Samples samples (default 7) of at least
+// min_ms milliseconds each (default 50): one warm-up call tells how many
+// calls a sample needs.  The median sample is the result and the fastest
+// is kept as well; both are per item (point, star, query or call, as the
+// unit says), so sizes can change without breaking the comparison.
+//
+// -o writes the results as JSON:
+//
+//   {
+//     "tool": "skybench", "version": 1,
+//     "date": "2026-10-16T09:30:00Z", "threads": 8, "compiler": "...",
+//     "results": [
+//       {"name": "lookup.packed_scalar", "unit": "ns/point",
+//        "median": 41.2, "min": 40.8, "samples": 7, "items": 262144,
+//        "baseline": 40.1, "change": 0.017, "regression": false},
+//       ...
+//     ],
+//     "regressions": 0
+//   }
+//
+// and -b reads such a file back as the baseline (only "name" and "min"
+// are used; the last three fields above appear only with one).  Results
+// that only model code living elsewhere carry "model": true.  A benchmark
+// is a regression when its fastest sample is more than the -r threshold
+// (default 25 percent) slower than the baseline's, in the first round of
+// samples and in up to three more taken to check.  Medians wander too
+// much between runs of the same build to gate on, and a single round can
+// land in a slow spell; on a loaded machine even the minimum moves by 20%
+// between runs, which is why the threshold is not lower.  Keep the
+// baseline from a run on the machine the numbers are for: a run there
+// with -o gives the file for later -b runs ('make bench-baseline' does
+// that for the committed skybench-baseline.json, 'make bench' runs
+// against it; see the Makefile).  The exit code is 1 if
+// anything regressed, -1 on errors and 0 otherwise, so a script can gate
+// on it.
+//
+// What is measured, grouped by prefix:
+//   lookup.     constellation lookup: the data[] scan of 'constel.c' (as
+//               in conbench), the packed segment search one point at a
+//               time and in batches, the congrid raster, and the J2000
+//               batch classifier with its precession
+//   catalog.    mapping and validating hipparcos.stars, decoding it to
+//               SoA, and building and loading the .hipx extension
+//   transform.  precession, the horizon transform on one thread and on
+//               all of them, and epoch propagation
+//   namesim.    prefix search over the IAU names, a linear scan against
+//               binary search in sorted folded keys; a C++ model, not the
+//               viewer's search (see below)
+//   spatial.    SkyIndex build, cone, frustum and nearest queries, the
+//               full pick, and the octree
+//
+// Lookup points are uniform over the sphere (fixed seed) and used as
+// B1875 directly, as conbench does; everything else uses the catalog.
+// Query centres come from a fixed seed too, so runs see the same work.
+// The star name search the viewer ships is the trie of uStarNames.pas,
+// which is Pascal and not reachable from here.  namesim.* only model its
+// fold-and-prefix approach in C++ on the HipCatalog names, so their
+// numbers say nothing about the viewer's search speed; the JSON marks
+// them "model": true.
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "conbound.h"
+#include "congrid.h"
+#include "precess.h"
+#include "uEpochCache.h"
+#include "uHipCatalog.h"
+#include "uHorizon.h"
+#include "uSkyIndex.h"
+#include "uStarCatalog.h"
+#include "uStarOctree.h"
+#include "uStarPicker.h"
+
+#define main constel_main
+#include "constel.c"
+#undef main
+
+//---------------------------------------------------------------------------
+namespace
+{
+const double Pi = 3.14159265358979323846;
+typedef std::chrono::steady_clock Clock;
+
+// Results are folded in here so the optimiser can't drop the work.
+volatile uint64_t Sink;
+
+const char* ConstelScan(float ra, float de)
+{
+	const ROW* pe = data + ITEMS(data);
+	for (const ROW* pr = data + 1; pr < pe; pr++)
+		if (ra >= pr->ral && ra < pr->rau && de >= pr->del)
+			return pr->cst;
+	return "???";
+}
+
+//---------------------------------------------------------------------------
+struct BenchResult
+{
+	std::string Name;
+	std::string Unit;
+	double Median = 0;
+	double Min = 0;
+	int Samples = 0;
+	size_t Items = 0;
+	double Baseline = 0;   // the baseline's Min, 0 = none
+};
+
+// The gate compares the fastest samples.  Noise on a busy machine only
+// ever adds time, so the minimum moves much less between runs than the
+// median does.
+bool IsRegression(const BenchResult& r, double Threshold)
+{
+	return r.Baseline > 0 && r.Min > r.Baseline * (1 + Threshold);
+}
+
+class Bench
+{
+public:
+	int Samples = 7;
+	double MinSeconds = 0.05;
+	std::string Filter;
+	bool ListOnly = false;
+	std::vector<BenchResult> Results;
+	// Baseline minima by name (see ReadBaseline()), and how many more
+	// rounds of Samples a benchmark that looks like a regression gets
+	// before it counts as one.
+	std::map<std::string, double> Baseline;
+	double Threshold = 0.25;
+	int Retries = 3;
+
+	// Times Body, which handles Items items per call; Scale turns seconds
+	// per item into Unit (1e9 for ns, 1e6 for us, ...).
+	void Run(const std::string& Name, const std::string& Unit, double Scale,
+		size_t Items, const std::function<void()>& Body)
+	{
+		if (!Filter.empty() && Name.find(Filter) == std::string::npos)
+			return;
+		if (ListOnly)
+		{
+			std::printf("%s\n", Name.c_str());
+			return;
+		}
+		const double Once = Time(Body, 1);
+		const size_t Calls = Once >= MinSeconds ? 1
+			: static_cast<size_t>(std::ceil(MinSeconds / std::max(Once, 1e-9)));
+		BenchResult r;
+		r.Name = Name;
+		r.Unit = Unit;
+		r.Items = Items;
+		const auto Found = Baseline.find(Name);
+		r.Baseline = Found != Baseline.end() ? Found->second : 0;
+		// One slow round is common on a loaded machine; a real regression
+		// stays slow in every round.
+		std::vector<double> PerItem;
+		for (int Round = 0; Round <= Retries; Round++)
+		{
+			if (Round)
+				std::this_thread::sleep_for(std::chrono::milliseconds(250));
+			for (int i = 0; i < Samples; i++)
+				PerItem.push_back(Time(Body, Calls) / (static_cast<double>(Calls)
+					* std::max<size_t>(Items, 1)) * Scale);
+			std::sort(PerItem.begin(), PerItem.end());
+			r.Median = PerItem[PerItem.size() / 2];
+			r.Min = PerItem.front();
+			if (!IsRegression(r, Threshold))
+				break;
+		}
+		r.Samples = static_cast<int>(PerItem.size());
+		std::printf("%-28s %12.3f %-9s (min %.3f)%s%s\n", Name.c_str(), r.Median,
+			Unit.c_str(), r.Min, r.Samples > Samples ? "  resampled" : "",
+			Name.starts_with("namesim.") ? "  C++ model" : "");
+		std::fflush(stdout);
+		Results.push_back(r);
+	}
+	void Skip(const std::string& Name, const char* Why)
+	{
+		if (Filter.empty() || Name.find(Filter) != std::string::npos)
+			std::printf("%-28s skipped: %s\n", Name.c_str(), Why);
+	}
+
+private:
+	static double Time(const std::function<void()>& Body, size_t Calls)
+	{
+		const Clock::time_point t0 = Clock::now();
+		for (size_t i = 0; i < Calls; i++)
+			Body();
+		return std::chrono::duration<double>(Clock::now() - t0).count();
+	}
+};
+
+//---------------------------------------------------------------------------
+// Baseline minima from a file written with -o.  Only our own output is
+// expected, so this looks for "name" and "min" keys rather than parsing
+// JSON in general.
+bool ReadBaseline(const std::string& FileName, std::map<std::string, double>& Mins)
+{
+	FILE* File = std::fopen(FileName.c_str(), "rb");
+	if (!File)
+		return false;
+	std::string Text;
+	char Buffer[4096];
+	size_t Read;
+	while ((Read = std::fread(Buffer, 1, sizeof(Buffer), File)) > 0)
+		Text.append(Buffer, Read);
+	std::fclose(File);
+
+	const std::string NameKey = "\"name\"", MinKey = "\"min\"";
+	for (size_t Pos = Text.find(NameKey); Pos != std::string::npos;)
+	{
+		const size_t Next = Text.find(NameKey, Pos + NameKey.size());
+		const size_t Open = Text.find('"', Text.find(':', Pos) + 1);
+		const size_t Close = Text.find('"', Open + 1);
+		const size_t Min = Text.find(MinKey, Pos);
+		if (Open < Next && Close < Next && Min < Next)
+		{
+			const std::string Name = Text.substr(Open + 1, Close - Open - 1);
+			const double Value = std::strtod(Text.c_str()
+				+ Text.find(':', Min) + 1, nullptr);
+			if (Value > 0)
+				Mins[Name] = Value;
+		}
+		Pos = Next;
+	}
+	return true;
+}
+
+bool WriteJson(const std::string& FileName, const std::vector<BenchResult>& Results,
+	double Threshold)
+{
+	FILE* File = std::fopen(FileName.c_str(), "w");
+	if (!File)
+		return false;
+	char Date[32];
+	const std::time_t Now = std::time(nullptr);
+	std::strftime(Date, sizeof(Date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&Now));
+#ifdef __VERSION__
+	const char* Compiler = __VERSION__;
+#else
+	const char* Compiler = "unknown";
+#endif
+	std::fprintf(File, "{\n  \"tool\": \"skybench\", \"version\": 1,\n"
+		"  \"date\": \"%s\", \"threads\": %u, \"compiler\": \"%s\",\n"
+		"  \"results\": [\n", Date, std::max(1u, std::thread::hardware_concurrency()),
+		Compiler);
+	int Regressions = 0;
+	for (size_t i = 0; i < Results.size(); i++)
+	{
+		const BenchResult& r = Results[i];
+		std::fprintf(File, "    {\"name\": \"%s\", \"unit\": \"%s\", \"median\": %.6g, "
+			"\"min\": %.6g, \"samples\": %d, \"items\": %zu", r.Name.c_str(),
+			r.Unit.c_str(), r.Median, r.Min, r.Samples, r.Items);
+		if (r.Name.starts_with("namesim."))
+			std::fprintf(File, ", \"model\": true");
+		if (r.Baseline > 0)
+		{
+			const bool Regressed = IsRegression(r, Threshold);
+			Regressions += Regressed;
+			std::fprintf(File, ", \"baseline\": %.6g, \"change\": %.4f, "
+				"\"regression\": %s", r.Baseline, r.Min / r.Baseline - 1,
+				Regressed ? "true" : "false");
+		}
+		std::fprintf(File, "}%s\n", i + 1 < Results.size() ? "," : "");
+	}
+	std::fprintf(File, "  ],\n  \"regressions\": %d\n}\n", Regressions);
+	return std::fclose(File) == 0;
+}
+
+//---------------------------------------------------------------------------
+// Name keys folded as uStarNames folds them: lowercase ASCII letters and
+// digits only, Latin diacritics dropped.
+std::string FoldName(std::string_view Name)
+{
+	// Base letter of U+00C0..U+017F, '.' where there is none
+	static const char LatinFold[] =
+		"aaaaaa.ceeeeiiiidnooooo.ouuuuyt." "aaaaaa.ceeeeiiiidnooooo.ouuuuyty"
+		"aaaaaaccccccccddddeeeeeeeeeegggg" "gggghhhhiiiiiiiiii..jjkkklllllll"
+		"lllnnnnnn.nnoooooo..rrrrrrssssss" "ssttttttuuuuuuuuuuuuwwyyyzzzzzz.";
+	std::string Key;
+	for (size_t i = 0; i < Name.size(); i++)
+	{
+		const uint8_t c = static_cast<uint8_t>(Name[i]);
+		if (c < 0x80)
+		{
+			if (std::isalnum(c))
+				Key += static_cast<char>(std::tolower(c));
+			continue;
+		}
+		if ((c & 0xe0) != 0xc0 || i + 1 >= Name.size())
+			continue;
+		const uint32_t Code = ((c & 0x1f) << 6) | (Name[++i] & 0x3f);
+		if (Code == 0xdf)
+			Key += "ss";
+		else if (Code == 0xc6 || Code == 0xe6)
+			Key += "ae";
+		else if (Code == 0x152 || Code == 0x153)
+			Key += "oe";
+		else if (Code >= 0xc0 && Code <= 0x17f && LatinFold[Code - 0xc0] != '.')
+			Key += LatinFold[Code - 0xc0];
+	}
+	return Key;
+}
+
+// Unit vector of a random direction, uniform over the sphere
+void RandomDirection(std::mt19937& Random, float* v)
+{
+	std::uniform_real_distribution<double> Uniform(-1., 1.);
+	const double z = Uniform(Random), Phi = Pi * Uniform(Random);
+	const double r = std::sqrt(1 - z * z);
+	v[0] = static_cast<float>(r * std::cos(Phi));
+	v[1] = static_cast<float>(r * std::sin(Phi));
+	v[2] = static_cast<float>(z);
+}
+
+// Side planes of a square frustum of half-angle HalfFov looking along v,
+// camera at the centre of the sky.
+void MakeFrustum(const float* v, double HalfFov, SkyPlane* Planes)
+{
+	float East[3] = {-v[1], v[0], 0};
+	const float Length = std::hypot(East[0], East[1]);
+	if (Length < 1e-6f)
+	{
+		East[0] = 0;
+		East[1] = 1;
+	}
+	else
+	{
+		East[0] /= Length;
+		East[1] /= Length;
+	}
+	const float North[3] = {v[1] * East[2] - v[2] * East[1],
+		v[2] * East[0] - v[0] * East[2], v[0] * East[1] - v[1] * East[0]};
+	const float c = static_cast<float>(std::cos(HalfFov));
+	const float s = static_cast<float>(std::sin(HalfFov));
+	const float* Side[4] = {East, East, North, North};
+	const float Sign[4] = {1, -1, 1, -1};
+	for (int p = 0; p < 4; p++)
+	{
+		// Normal leans from the side axis towards the view direction
+		for (int a = 0; a < 3; a++)
+			Planes[p].Normal[a] = s * v[a] - Sign[p] * c * Side[p][a];
+		Planes[p].D = 0;
+	}
+}
+}
+
+//---------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	Bench b;
+	std::string DataDir = "data", HipMain, OutFile, BaselineFile;
+	bool Ok = true;
+
+	for (int i = 1; i < argc && Ok; i++)
+	{
+		const std::string Arg = argv[i];
+		const bool HasValue = i + 1 < argc;
+		if (Arg == "-d" && HasValue)
+			DataDir = argv[++i];
+		else if (Arg == "-H" && HasValue)
+			HipMain = argv[++i];
+		else if (Arg == "-f" && HasValue)
+			b.Filter = argv[++i];
+		else if (Arg == "-n" && HasValue)
+			b.Samples = std::max(1, std::atoi(argv[++i]));
+		else if (Arg == "-m" && HasValue)
+			b.MinSeconds = std::max(0., std::atof(argv[++i]) / 1000.);
+		else if (Arg == "-o" && HasValue)
+			OutFile = argv[++i];
+		else if (Arg == "-b" && HasValue)
+			BaselineFile = argv[++i];
+		else if (Arg == "-r" && HasValue)
+			b.Threshold = std::atof(argv[++i]) / 100.;
+		else if (Arg == "-l")
+			b.ListOnly = true;
+		else
+			Ok = false;
+	}
+	if (!Ok)
+	{
+		std::fprintf(stderr, "Usage:  skybench [-d data_dir] [-H hip_main.dat] "
+			"[-f filter] [-n samples]\n                 [-m min_ms] "
+			"[-o results.json] [-b baseline.json] [-r percent] [-l]\n");
+		return -1;
+	}
+
+	if (!BaselineFile.empty() && !ReadBaseline(BaselineFile, b.Baseline))
+	{
+		std::fprintf(stderr, "Couldn't read %s\n", BaselineFile.c_str());
+		return -1;
+	}
+	const double Threshold = b.Threshold;
+
+	const std::string StarsFile = DataDir + "/catalog/hipparcos.stars";
+	StarCatalog Stars;
+	if (!Stars.Open(StarsFile))
+	{
+		std::fprintf(stderr, "%s\n", Stars.LastError().c_str());
+		return -1;
+	}
+	const std::span<const StarRecord> Records = Stars.Records();
+	const size_t StarCount = Records.size();
+	std::mt19937 Random(1);
+
+	// lookup.*
+	const size_t PointCount = 262144;
+	std::vector<float> RA(PointCount), Dec(PointCount);
+	std::vector<uint8_t> Index(PointCount);
+	{
+		std::uniform_real_distribution<double> Uniform(0., 1.);
+		for (size_t i = 0; i < PointCount; i++)
+		{
+			RA[i] = static_cast<float>(360. * Uniform(Random));
+			Dec[i] = static_cast<float>(std::asin(2. * Uniform(Random) - 1.)
+				* (180. / Pi));
+		}
+	}
+	congrid_t Grid;
+	if (constellation_grid_build(&Grid, 360, 0))
+	{
+		std::fprintf(stderr, "Out of memory\n");
+		return -1;
+	}
+	b.Run("lookup.constel_scan", "ns/point", 1e9, PointCount, [&]
+	{
+		uint64_t Sum = 0;
+		for (size_t i = 0; i < PointCount; i++)
+			Sum += *ConstelScan(RA[i], Dec[i]);
+		Sink = Sum;
+	});
+	b.Run("lookup.packed_scalar", "ns/point", 1e9, PointCount, [&]
+	{
+		uint64_t Sum = 0;
+		for (size_t i = 0; i < PointCount; i++)
+			Sum += constellation_index_at(RA[i], Dec[i]);
+		Sink = Sum;
+	});
+	b.Run("lookup.packed_batch", "ns/point", 1e9, PointCount, [&]
+	{
+		constellation_classify(RA.data(), Dec.data(), Index.data(), PointCount);
+		Sink = Index[PointCount / 2];
+	});
+	b.Run("lookup.grid_scalar", "ns/point", 1e9, PointCount, [&]
+	{
+		uint64_t Sum = 0;
+		for (size_t i = 0; i < PointCount; i++)
+			Sum += constellation_grid_index_at(&Grid, RA[i], Dec[i]);
+		Sink = Sum;
+	});
+	b.Run("lookup.classify_j2000", "ns/point", 1e9, PointCount, [&]
+	{
+		constellation_classify_j2000(RA.data(), Dec.data(), Index.data(),
+			PointCount);
+		Sink = Index[PointCount / 2];
+	});
+
+	// catalog.*
+	b.Run("catalog.open", "us/call", 1e6, 1, [&]
+	{
+		StarCatalog c;
+		c.Open(StarsFile);
+		Sink = c.Count();
+	});
+	b.Run("catalog.validate", "ns/star", 1e9, StarCount, [&]
+	{
+		Sink = Stars.Validate();
+	});
+	StarArrays Decoded;
+	b.Run("catalog.decode", "ns/star", 1e9, StarCount, [&]
+	{
+		DecodeStars(Records, Decoded);
+		Sink = Decoded.Count();
+	});
+	DecodeStars(Records, Decoded);
+
+	HipCatalogSources Sources;
+	Sources.IauCsn = DataDir + "/star/IAU-CSN.txt";
+	Sources.HipMain = HipMain;
+	HipCatalog Catalog;
+	b.Run("catalog.hipx_build", "ms/call", 1e3, 1, [&]
+	{
+		Catalog.Build(Records, Sources);
+		Sink = Catalog.Count();
+	});
+	if (Catalog.Count() == 0)
+		Catalog.Build(Records, Sources);
+	const std::string HipxFile = (std::filesystem::temp_directory_path()
+		/ "skybench.hipx").string();
+	if (Catalog.Save(HipxFile))
+	{
+		b.Run("catalog.hipx_load", "ms/call", 1e3, 1, [&]
+		{
+			HipCatalog c;
+			Sink = c.Load(HipxFile, Records, Sources);
+		});
+		std::error_code Error;
+		std::filesystem::remove(HipxFile, Error);
+	}
+	else
+		b.Skip("catalog.hipx_load", "can't write a temporary file");
+
+	// transform.*
+	{
+		std::vector<float> RADegrees(StarCount), DecDegrees(StarCount);
+		std::vector<float> RAOut(StarCount), DecOut(StarCount);
+		for (size_t i = 0; i < StarCount; i++)
+		{
+			RADegrees[i] = Records[i].RADegrees();
+			DecDegrees[i] = Records[i].DecDegrees();
+		}
+		double Matrix[9];
+		setup_precession(Matrix, EPOCH_J2000, EPOCH_B1875);
+		b.Run("transform.precess", "ns/star", 1e9, StarCount, [&]
+		{
+			precess_positions(Matrix, RADegrees.data(), DecDegrees.data(),
+				RAOut.data(), DecOut.data(), StarCount);
+			Sink = static_cast<uint64_t>(RAOut[StarCount / 2]);
+		});
+	}
+	SkyVectors Vectors;
+	MakeSkyVectors(Decoded, Vectors);
+	HorizonVectors Horizon;
+	for (const unsigned Threads : {1u, 0u})
+	{
+		HorizonTransform Transform(Threads);
+		Transform.SetObserver(52., 13.4);
+		Transform.SetTime(JulianDate(2026, 10, 16, 21.));
+		b.Run(Threads == 1 ? "transform.horizon_1t" : "transform.horizon",
+			"ns/star", 1e9, StarCount, [&]
+		{
+			Transform.Apply(Vectors, Horizon);
+			Sink = Horizon.Visible.size();
+		});
+	}
+	{
+		EpochCache Epochs(10, 1);
+		Epochs.SetCatalog(Catalog);
+		Epochs.SetEquinoxOfDate(true);
+		double Year = EpochCache::MinYear;
+		// A fresh bucket every call, so each one computes
+		b.Run("transform.epoch", "ms/call", 1e3, 1, [&]
+		{
+			Year = Year + 10 > EpochCache::MaxYear ? EpochCache::MinYear : Year + 10;
+			Sink = Epochs.Stars(Year).Count();
+		});
+	}
+
+	// namesim.*
+	{
+		std::vector<std::pair<std::string, uint32_t>> Keys;
+		for (size_t i = 0; i < Catalog.Count(); i++)
+			if (!Catalog.Name(i).empty())
+				Keys.emplace_back(FoldName(Catalog.Name(i)), static_cast<uint32_t>(i));
+		std::vector<std::string> Queries;
+		for (const auto& k : Keys)
+			for (size_t Length : {1, 3, 5})
+				if (k.first.size() >= Length)
+					Queries.push_back(k.first.substr(0, Length));
+		std::shuffle(Queries.begin(), Queries.end(), Random);
+		if (Keys.empty())
+			b.Skip("namesim.", "no IAU names (IAU-CSN.txt missing?)");
+		else
+		{
+			b.Run("namesim.linear_prefix", "us/query", 1e6, Queries.size(), [&]
+			{
+				uint64_t Found = 0;
+				for (const std::string& q : Queries)
+					for (const auto& k : Keys)
+						Found += k.first.compare(0, q.size(), q) == 0;
+				Sink = Found;
+			});
+			std::vector<std::pair<std::string, uint32_t>> Sorted = Keys;
+			std::sort(Sorted.begin(), Sorted.end());
+			b.Run("namesim.sorted_prefix", "us/query", 1e6, Queries.size(), [&]
+			{
+				uint64_t Found = 0;
+				for (const std::string& q : Queries)
+				{
+					auto First = std::lower_bound(Sorted.begin(), Sorted.end(),
+						std::make_pair(q, 0u));
+					while (First != Sorted.end()
+						&& First->first.compare(0, q.size(), q) == 0)
+					{
+						Found++;
+						++First;
+					}
+				}
+				Sink = Found;
+			});
+		}
+	}
+
+	// spatial.*
+	SkyIndex Sky;
+	b.Run("spatial.index_build", "ms/call", 1e3, 1, [&]
+	{
+		Sky.Build(Records);
+		Sink = Sky.StarCount();
+	});
+	if (Sky.StarCount() == 0)
+		Sky.Build(Records);
+	const size_t QueryCount = 1024;
+	std::vector<float> Centres(3 * QueryCount);
+	for (size_t q = 0; q < QueryCount; q++)
+		RandomDirection(Random, &Centres[3 * q]);
+	std::vector<uint32_t> Found;
+	b.Run("spatial.cone", "us/query", 1e6, QueryCount, [&]
+	{
+		size_t n = 0;
+		for (size_t q = 0; q < QueryCount; q++)
+		{
+			const float* v = &Centres[3 * q];
+			Found.clear();
+			Sky.QueryCone(std::atan2(v[1], v[0]), std::asin(v[2]), 10 * Pi / 180.,
+				6.5f, Found);
+			n += Found.size();
+		}
+		Sink = n;
+	});
+	std::vector<SkyPlane> Frustums(4 * QueryCount);
+	for (size_t q = 0; q < QueryCount; q++)
+		MakeFrustum(&Centres[3 * q], 30 * Pi / 180., &Frustums[4 * q]);
+	b.Run("spatial.frustum", "us/query", 1e6, QueryCount, [&]
+	{
+		size_t n = 0;
+		for (size_t q = 0; q < QueryCount; q++)
+		{
+			Found.clear();
+			Sky.QueryFrustum(&Frustums[4 * q], 4, 8.f, Found);
+			n += Found.size();
+		}
+		Sink = n;
+	});
+	std::vector<SkyNeighbour> Nearest;
+	b.Run("spatial.nearest", "us/query", 1e6, QueryCount, [&]
+	{
+		size_t n = 0;
+		for (size_t q = 0; q < QueryCount; q++)
+		{
+			const float* v = &Centres[3 * q];
+			Sky.QueryNearest(v[0], v[1], v[2], 1, 2 * Pi / 180., 99.f, 0.f, Nearest);
+			n += Nearest.size();
+		}
+		Sink = n;
+	});
+	StarPicker Picker;
+	if (Picker.Init(Sky, Records))
+		b.Run("spatial.pick", "us/query", 1e6, QueryCount, [&]
+		{
+			uint64_t n = 0;
+			for (size_t q = 0; q < QueryCount; q++)
+				n += Picker.Pick(&Centres[3 * q], 0.5f * static_cast<float>(Pi / 180.),
+					99.f).Constellation;
+			Sink = n;
+		});
+	else
+		b.Skip("spatial.pick", "out of memory");
+	StarOctree Octree;
+	Octree.Build(Catalog);
+	if (Octree.StarCount() == 0)
+		b.Skip("spatial.octree", "no parallaxes (give -H hip_main.dat)");
+	else
+	{
+		std::vector<SpaceLight> Lights;
+		b.Run("spatial.octree", "us/query", 1e6, QueryCount, [&]
+		{
+			size_t n = 0;
+			for (size_t q = 0; q < QueryCount; q++)
+			{
+				// From 20 pc out, looking back through the Sun
+				const float* v = &Centres[3 * q];
+				const float Eye[3] = {20 * v[0], 20 * v[1], 20 * v[2]};
+				Lights.clear();
+				Octree.Query(Eye, 0.002f, 6.5f, nullptr, 0, Lights);
+				n += Lights.size();
+			}
+			Sink = n;
+		});
+	}
+	constellation_grid_free(&Grid);
+	if (b.ListOnly)
+		return 0;
+
+	int Regressions = 0;
+	if (!BaselineFile.empty())
+	{
+		std::printf("\nAgainst %s (threshold %.0f%%):\n", BaselineFile.c_str(),
+			Threshold * 100);
+		for (const BenchResult& r : b.Results)
+		{
+			if (r.Baseline <= 0)
+			{
+				std::printf("%-28s   (not in baseline)\n", r.Name.c_str());
+				continue;
+			}
+			const double Change = r.Min / r.Baseline - 1;
+			const bool Regressed = IsRegression(r, Threshold);
+			Regressions += Regressed;
+			std::printf("%-28s %+7.1f%%%s\n", r.Name.c_str(), Change * 100,
+				Regressed ? "  ****REGRESSION" : Change < -Threshold ? "  faster" : "");
+		}
+	}
+	if (!OutFile.empty() && !WriteJson(OutFile, b.Results, Threshold))
+	{
+		std::fprintf(stderr, "Couldn't write %s\n", OutFile.c_str());
+		return -1;
+	}
+	if (Regressions)
+		std::printf("%d regression%s\n", Regressions, Regressions > 1 ? "s" : "");
+	return Regressions ? 1 : 0;
+}
+//---------------------------------------------------------------------------
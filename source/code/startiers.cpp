@@ -0,0 +1,93 @@
+//---------------------------------------------------------------------------
+// startiers : cuts a GLScene .stars catalog into a magnitude-tiered star
+// file for StarTierStream (see uStarTiers.h).
+//
+//   Usage:  startiers [-b breaks] stars_file tier_file
+//
+// -b lists the magnitudes the tiers are cut at, comma separated and
+// ascending (default "6.5,8,9.5": naked eye first, as BaseMagnitude of
+// the stream, then a band per two zoom steps).  Stars fainter than the
+// last break make up a final tier.  Prints one line per tier written.
+//
+//   Build:  g++ -std=c++20 -O2 startiers.cpp uStarTiers.cpp uStarCatalog.cpp
+//---------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "uStarCatalog.h"
+#include "uStarTiers.h"
+
+//---------------------------------------------------------------------------
+namespace
+{
+bool ParseBreaks(const char* Text, std::vector<float>& Breaks)
+{
+	Breaks.clear();
+	while (*Text)
+	{
+		char* End;
+		const float Magnitude = std::strtof(Text, &End);
+		if (End == Text || (!Breaks.empty() && Magnitude <= Breaks.back()))
+			return false;
+		Breaks.push_back(Magnitude);
+		if (*End == ',')
+			End++;
+		else if (*End)
+			return false;
+		Text = End;
+	}
+	return !Breaks.empty();
+}
+} // namespace
+
+//---------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	std::vector<float> Breaks = {6.5f, 8.f, 9.5f};
+	int i = 1;
+	bool Ok = true;
+	if (i + 1 < argc && std::string(argv[i]) == "-b")
+	{
+		Ok = ParseBreaks(argv[i + 1], Breaks);
+		i += 2;
+	}
+	if (!Ok || argc - i != 2)
+	{
+		std::fprintf(stderr, "Usage:  startiers [-b breaks] stars_file "
+			"tier_file\n");
+		return -1;
+	}
+
+	StarCatalog Catalog;
+	if (!Catalog.Open(argv[i]))
+	{
+		std::fprintf(stderr, "%s: %s\n", argv[i], Catalog.LastError().c_str());
+		return -1;
+	}
+	if (!WriteStarTiers(argv[i + 1], Catalog.Records(), Breaks))
+	{
+		std::fprintf(stderr, "%s: can't write\n", argv[i + 1]);
+		return -1;
+	}
+
+	// Read it back the way the viewer will, as a check.
+	StarTierStream Stream;
+	if (!Stream.Open(argv[i + 1]))
+	{
+		std::fprintf(stderr, "%s: can't read back\n", argv[i + 1]);
+		return -1;
+	}
+	for (int t = 0; t < Stream.TierCount(); t++)
+	{
+		const StarTierEntry& e = Stream.Entry(t);
+		std::printf("tier %d: %8llu stars, magnitude %5.2f to %5.2f\n", t,
+			static_cast<unsigned long long>(e.Count),
+			t ? e.MinMagnitude : Stream.Tier(0).front().Magnitude(),
+			e.MaxMagnitude);
+	}
+	return 0;
+}
+//---------------------------------------------------------------------------
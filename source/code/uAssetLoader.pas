@@ -0,0 +1,414 @@
+unit uAssetLoader;
+//--------------------------------------------------
+// Asynchronous asset loading on a worker pool
+//--------------------------------------------------
+(*
+  Planet maps, constellation art and the star catalog take far longer to
+  read and decode than to hand to GLScene, so the form queues them here
+  instead of loading them in FormCreate.
+
+  Each request has a priority (higher first, FIFO among equals), a Decode
+  function that runs on one of the worker threads and an Apply procedure
+  that runs on the main thread from Deliver, called once per cadencer
+  tick.  Apply is where GLScene objects are touched; GL itself gets the
+  pixels on the next render, on the render thread.  Until then whatever
+  the form set up as a placeholder stays on screen.
+
+  Decode must not touch the scene or any VCL control.  Decoding JPEG and
+  PNG files into TGraphic objects is fine: no canvas is involved.  The
+  decoded object belongs to the loader and is freed after Apply, so
+  Apply copies what it needs (TGLTexture.Image.Assign does).
+
+  An asset too big to apply within one tick's budget (the catalog adds
+  some 87,000 sky dome stars) is requested with RequestInSteps instead.
+  Its ApplyStep gets the budget that is left, does that much and returns
+  False until it is done; Deliver resumes it on the next tick.
+
+  Every delivered asset gets a TAssetTiming: time spent queued, decoding
+  and in Apply.
+*)
+
+interface
+
+uses
+  System.Classes,
+  System.SysUtils,
+  System.Diagnostics,
+  System.Generics.Collections,
+  Vcl.Graphics;
+
+type
+  TAssetDecodeFunc = reference to function(const FileName: string): TObject;
+  TAssetApplyProc = reference to procedure(Data: TObject);
+  // True once Data is fully applied
+  TAssetApplyStepFunc = reference to function(Data: TObject;
+    BudgetMs: Double): Boolean;
+
+  TAssetTiming = record
+    FileName: string;
+    QueuedMs: Double;
+    DecodeMs: Double;
+    UploadMs: Double;
+    Error: string; // empty when the asset loaded
+  end;
+
+  TAssetJob = class;
+
+  TAssetLoader = class
+  private
+    FWorkers: TObjectList<TThread>;
+    FQueue: TList<TAssetJob>; // sorted by priority, guarded by TMonitor
+    FDone: TQueue<TAssetJob>; // decoded, waiting for Deliver
+    FStopping: Boolean;
+    FPending: Integer;
+    FTimings: TList<TAssetTiming>;
+    FApplying: TAssetJob; // partly applied, resumed by the next Deliver
+    function NextJob(out Job: TAssetJob): Boolean;
+    procedure RunJob(Job: TAssetJob);
+  public
+    // WorkerCount <= 0 picks one less than the number of cores
+    constructor Create(WorkerCount: Integer = 0);
+    // Waits for running decodes; anything not yet delivered is dropped
+    destructor Destroy; override;
+    procedure Request(const FileName: string; Priority: Integer;
+      const Decode: TAssetDecodeFunc; const Apply: TAssetApplyProc);
+    procedure RequestInSteps(const FileName: string; Priority: Integer;
+      const Decode: TAssetDecodeFunc; const ApplyStep: TAssetApplyStepFunc);
+    // Main thread.  Applies decoded assets until BudgetMs is used up
+    // (at least one step per call); returns how many steps ran, i.e.
+    // whether the scene changed.
+    function Deliver(BudgetMs: Double): Integer;
+    // One line per delivered asset
+    function TimingText: string;
+    // One line for a status bar: count, failures and the slowest asset
+    function SummaryText: string;
+    // requested but not yet delivered
+    property Pending: Integer read FPending;
+    property Timings: TList<TAssetTiming> read FTimings;
+  end;
+
+  TAssetJob = class
+  public
+    FileName: string;
+    Priority: Integer;
+    Decode: TAssetDecodeFunc;
+    ApplyStep: TAssetApplyStepFunc;
+    Data: TObject;
+    Error: string;
+    QueuedAt: Int64; // TStopwatch timestamps
+    StartedAt: Int64;
+    DecodeMs: Double;
+    UploadMs: Double; // summed over the Apply steps so far
+    destructor Destroy; override;
+  end;
+
+// Reads a JPEG or PNG file and decodes its pixels; safe on any thread
+function DecodePicture(const FileName: string): TGraphic;
+
+//==========================================================================
+implementation
+//==========================================================================
+
+uses
+  System.Math,
+  Vcl.Imaging.jpeg,
+  Vcl.Imaging.pngimage;
+
+type
+  TAssetWorker = class(TThread)
+  private
+    FLoader: TAssetLoader;
+  protected
+    procedure Execute; override;
+  public
+    constructor Create(Loader: TAssetLoader);
+  end;
+
+function TicksToMs(Ticks: Int64): Double;
+begin
+  Result := Ticks * 1000 / TStopwatch.Frequency;
+end;
+
+//-----------------------------------------------------------------------
+
+function DecodePicture(const FileName: string): TGraphic;
+var
+  Ext: string;
+begin
+  Ext := LowerCase(ExtractFileExt(FileName));
+  if (Ext = '.jpg') or (Ext = '.jpeg') then
+    Result := TJPEGImage.Create
+  else if Ext = '.png' then
+    Result := TPngImage.Create
+  else
+    raise EInvalidGraphic.CreateFmt('Unsupported image: %s', [FileName]);
+  try
+    Result.LoadFromFile(FileName);
+    // TJPEGImage decodes lazily, on first draw; do it here instead
+    if Result is TJPEGImage then
+      TJPEGImage(Result).DIBNeeded;
+  except
+    Result.Free;
+    raise;
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+destructor TAssetJob.Destroy;
+begin
+  Data.Free;
+  inherited;
+end;
+
+//-----------------------------------------------------------------------
+
+constructor TAssetWorker.Create(Loader: TAssetLoader);
+begin
+  FLoader := Loader;
+  inherited Create(False);
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TAssetWorker.Execute;
+var
+  Job: TAssetJob;
+begin
+  NameThreadForDebugging('AssetWorker');
+  while FLoader.NextJob(Job) do
+    FLoader.RunJob(Job);
+end;
+
+//-----------------------------------------------------------------------
+
+constructor TAssetLoader.Create(WorkerCount: Integer);
+var
+  I: Integer;
+begin
+  inherited Create;
+  FQueue := TList<TAssetJob>.Create;
+  FDone := TQueue<TAssetJob>.Create;
+  FTimings := TList<TAssetTiming>.Create;
+  FWorkers := TObjectList<TThread>.Create;
+  if WorkerCount <= 0 then
+    WorkerCount := Max(1, TThread.ProcessorCount - 1);
+  for I := 1 to WorkerCount do
+    FWorkers.Add(TAssetWorker.Create(Self));
+end;
+
+//-----------------------------------------------------------------------
+
+destructor TAssetLoader.Destroy;
+var
+  Worker: TThread;
+  Job: TAssetJob;
+begin
+  TMonitor.Enter(FQueue);
+  try
+    FStopping := True;
+    TMonitor.PulseAll(FQueue);
+  finally
+    TMonitor.Exit(FQueue);
+  end;
+  for Worker in FWorkers do
+    Worker.WaitFor;
+  FWorkers.Free;
+  FApplying.Free;
+  for Job in FQueue do
+    Job.Free;
+  FQueue.Free;
+  while FDone.Count > 0 do
+    FDone.Dequeue.Free;
+  FDone.Free;
+  FTimings.Free;
+  inherited;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TAssetLoader.Request(const FileName: string; Priority: Integer;
+  const Decode: TAssetDecodeFunc; const Apply: TAssetApplyProc);
+var
+  ApplyAll: TAssetApplyProc;
+begin
+  ApplyAll := Apply;
+  RequestInSteps(FileName, Priority, Decode,
+    function(Data: TObject; BudgetMs: Double): Boolean
+    begin
+      ApplyAll(Data);
+      Result := True;
+    end);
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TAssetLoader.RequestInSteps(const FileName: string; Priority: Integer;
+  const Decode: TAssetDecodeFunc; const ApplyStep: TAssetApplyStepFunc);
+var
+  Job: TAssetJob;
+  I: Integer;
+begin
+  Job := TAssetJob.Create;
+  Job.FileName := FileName;
+  Job.Priority := Priority;
+  Job.Decode := Decode;
+  Job.ApplyStep := ApplyStep;
+  Job.QueuedAt := TStopwatch.GetTimeStamp;
+  Inc(FPending);
+  TMonitor.Enter(FQueue);
+  try
+    // after the last job of the same or higher priority
+    I := FQueue.Count;
+    while (I > 0) and (FQueue[I - 1].Priority < Priority) do
+      Dec(I);
+    FQueue.Insert(I, Job);
+    TMonitor.Pulse(FQueue);
+  finally
+    TMonitor.Exit(FQueue);
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+function TAssetLoader.NextJob(out Job: TAssetJob): Boolean;
+begin
+  TMonitor.Enter(FQueue);
+  try
+    while (FQueue.Count = 0) and not FStopping do
+      TMonitor.Wait(FQueue, INFINITE);
+    Result := not FStopping;
+    if Result then
+    begin
+      Job := FQueue[0];
+      FQueue.Delete(0);
+    end;
+  finally
+    TMonitor.Exit(FQueue);
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TAssetLoader.RunJob(Job: TAssetJob);
+begin
+  Job.StartedAt := TStopwatch.GetTimeStamp;
+  try
+    Job.Data := Job.Decode(Job.FileName);
+  except
+    on E: Exception do
+      Job.Error := E.Message;
+  end;
+  Job.DecodeMs := TicksToMs(TStopwatch.GetTimeStamp - Job.StartedAt);
+  TMonitor.Enter(FDone);
+  try
+    FDone.Enqueue(Job);
+  finally
+    TMonitor.Exit(FDone);
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+function TAssetLoader.Deliver(BudgetMs: Double): Integer;
+var
+  Start, ApplyStart: Int64;
+  Job: TAssetJob;
+  Timing: TAssetTiming;
+  Done: Boolean;
+begin
+  Result := 0;
+  Start := TStopwatch.GetTimeStamp;
+  repeat
+    Job := FApplying;
+    FApplying := nil;
+    if Job = nil then
+    begin
+      TMonitor.Enter(FDone);
+      try
+        if FDone.Count = 0 then
+          Exit;
+        Job := FDone.Dequeue;
+      finally
+        TMonitor.Exit(FDone);
+      end;
+    end;
+    Done := True;
+    if Job.Error = '' then
+    begin
+      ApplyStart := TStopwatch.GetTimeStamp;
+      try
+        Done := Job.ApplyStep(Job.Data,
+          BudgetMs - TicksToMs(ApplyStart - Start));
+      except
+        on E: Exception do
+          Job.Error := E.Message;
+      end;
+      Job.UploadMs := Job.UploadMs + TicksToMs(TStopwatch.GetTimeStamp - ApplyStart);
+    end;
+    Inc(Result);
+    if not Done and (Job.Error = '') then
+    begin
+      FApplying := Job; // the budget is spent; carry on next tick
+      Exit;
+    end;
+    try
+      Timing.FileName := Job.FileName;
+      Timing.QueuedMs := TicksToMs(Job.StartedAt - Job.QueuedAt);
+      Timing.DecodeMs := Job.DecodeMs;
+      Timing.UploadMs := Job.UploadMs;
+      Timing.Error := Job.Error;
+      FTimings.Add(Timing);
+    finally
+      Job.Free;
+    end;
+    Dec(FPending);
+  until TicksToMs(TStopwatch.GetTimeStamp - Start) >= BudgetMs;
+end;
+
+//-----------------------------------------------------------------------
+
+function TAssetLoader.TimingText: string;
+var
+  Lines: TStringList;
+  Timing: TAssetTiming;
+begin
+  Lines := TStringList.Create;
+  try
+    for Timing in FTimings do
+      if Timing.Error = '' then
+        Lines.Add(Format('%s: queued %.1f ms, decode %.1f ms, upload %.1f ms',
+          [ExtractFileName(Timing.FileName), Timing.QueuedMs, Timing.DecodeMs,
+          Timing.UploadMs]))
+      else
+        Lines.Add(Format('%s: failed after %.1f ms, %s',
+          [ExtractFileName(Timing.FileName), Timing.DecodeMs, Timing.Error]));
+    Result := Lines.Text;
+  finally
+    Lines.Free;
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+function TAssetLoader.SummaryText: string;
+var
+  Timing, Slowest: TAssetTiming;
+  Failed: Integer;
+begin
+  Failed := 0;
+  Slowest := Default(TAssetTiming);
+  for Timing in FTimings do
+    if Timing.Error <> '' then
+      Inc(Failed)
+    else if Timing.DecodeMs + Timing.UploadMs > Slowest.DecodeMs + Slowest.UploadMs then
+      Slowest := Timing;
+  Result := Format('%d assets loaded', [FTimings.Count - Failed]);
+  if Failed > 0 then
+    Result := Result + Format(', %d failed', [Failed]);
+  if Slowest.FileName <> '' then
+    Result := Result + Format(', slowest %s %.0f ms',
+      [ExtractFileName(Slowest.FileName), Slowest.DecodeMs + Slowest.UploadMs]);
+end;
+
+end.
@@ -0,0 +1,249 @@
+//---------------------------------------------------------------------------
+// Constellation figures (the Constellation[] table of uConstellations.pas)
+// as compile-time C++ data.
+//
+// The Pascal table is a run of polylines: DrawMode -2 starts one, -1 draws
+// to the record before it, with RA x1000 in hours and Dec x100 in degrees.
+// Everything a renderer or exporter wants from that is worked out here by
+// the compiler:
+//
+//   ConstFigureVertices        unique stars as unit vectors
+//   ConstFigureSegments        line-segment index pairs into those, grouped
+//                              by figure
+//   ConstFigureSegmentStart    figure f owns segments
+//                              [ConstFigureSegmentStart[f],
+//                               ConstFigureSegmentStart[f + 1])
+//   ConstFigureLineVertices    the segments expanded to vertex pairs, for
+//                              consumers without index buffers
+//   ConstFigureLabelVertices   Constpos label positions as unit vectors
+//
+// so filling a vertex or index buffer (or the ConstellationLines nodes) is
+// a copy.  Unit vectors are x = cos(dec) cos(ra), y = cos(dec) sin(ra),
+// z = sin(dec), the same as the star field uses.
+//---------------------------------------------------------------------------
+
+#ifndef uConstFiguresH
+#define uConstFiguresH
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+//---------------------------------------------------------------------------
+struct ConstFigureRecord
+{
+	int16_t DrawMode;      // -2 = start, -1 = draw
+	int16_t RA;            // hours x1000, [0..24000]
+	int16_t Dec;           // degrees x100, [-9000..9000]
+	uint8_t Figure;        // index into ConstFigureNames
+	const char8_t* Bayer;  // UTF-8, may be empty
+};
+
+struct ConstFigureVertex
+{
+	float x, y, z;
+};
+
+inline constexpr int ConstFigureCount = 89;
+
+#include "uConstFiguresData.h"
+
+//---------------------------------------------------------------------------
+namespace ConstFigureDetail
+{
+constexpr double Pi = 3.14159265358979323846;
+constexpr size_t RecordCount = std::size(ConstFigureRecords);
+
+// std::sin/cos aren't constexpr (before C++26).  Reduce to [-pi/2, pi/2]
+// and sum the Taylor series, which is good to ~1e-17 there.
+constexpr double Sin(double x)
+{
+	const double TwoPi = 2. * Pi;
+	x -= TwoPi * static_cast<double>(static_cast<long long>(x / TwoPi));
+	if (x > Pi)
+		x -= TwoPi;
+	else if (x < -Pi)
+		x += TwoPi;
+	if (x > Pi / 2.)
+		x = Pi - x;
+	else if (x < -Pi / 2.)
+		x = -Pi - x;
+	double Term = x, Sum = x;
+	for (int n = 1; n <= 11; n++)
+	{
+		Term *= -x * x / ((2. * n) * (2. * n + 1.));
+		Sum += Term;
+	}
+	return Sum;
+}
+
+constexpr double Cos(double x)
+{
+	return Sin(x + Pi / 2.);
+}
+
+constexpr ConstFigureVertex ToVertex(int RA1000, int Dec100)
+{
+	const double RA = RA1000 * (Pi / 12000.);
+	const double Dec = Dec100 * (Pi / 18000.);
+	return {static_cast<float>(Cos(Dec) * Cos(RA)),
+		static_cast<float>(Cos(Dec) * Sin(RA)), static_cast<float>(Sin(Dec))};
+}
+
+constexpr bool SameStar(const ConstFigureRecord& a, const ConstFigureRecord& b)
+{
+	return a.RA == b.RA && a.Dec == b.Dec;
+}
+
+// Records are ~600 and repeats are common (figures revisit stars to
+// branch), so the quadratic search is fine at compile time.
+constexpr size_t CountVertices()
+{
+	size_t Count = 0;
+	for (size_t i = 0; i < RecordCount; i++)
+	{
+		size_t j = 0;
+		while (j < i && !SameStar(ConstFigureRecords[j], ConstFigureRecords[i]))
+			j++;
+		Count += (j == i);
+	}
+	return Count;
+}
+
+constexpr size_t CountSegments()
+{
+	size_t Count = 0;
+	for (size_t i = 1; i < RecordCount; i++)
+		Count += (ConstFigureRecords[i].DrawMode == -1);
+	return Count;
+}
+
+constexpr size_t VertexCount = CountVertices();
+constexpr size_t SegmentCount = CountSegments();
+
+static_assert(VertexCount < 65536, "vertex indices are 16-bit");
+static_assert(ConstFigureRecords[0].DrawMode == -2,
+	"the first record has to start a polyline");
+
+constexpr std::array<uint16_t, RecordCount> MakeRecordVertex()
+{
+	std::array<uint16_t, RecordCount> Map{};
+	uint16_t Next = 0;
+	for (size_t i = 0; i < RecordCount; i++)
+	{
+		size_t j = 0;
+		while (j < i && !SameStar(ConstFigureRecords[j], ConstFigureRecords[i]))
+			j++;
+		Map[i] = (j == i) ? Next++ : Map[j];
+	}
+	return Map;
+}
+
+constexpr std::array<uint16_t, RecordCount> RecordVertex = MakeRecordVertex();
+
+constexpr std::array<ConstFigureVertex, VertexCount> MakeVertices()
+{
+	std::array<ConstFigureVertex, VertexCount> Vertices{};
+	for (size_t i = 0; i < RecordCount; i++)
+		Vertices[RecordVertex[i]] = ToVertex(ConstFigureRecords[i].RA,
+			ConstFigureRecords[i].Dec);
+	return Vertices;
+}
+
+// Figure of the segment drawn to record i.  Record figures are the stars'
+// tags, and a star shared by two figures (Beta Tau in Auriga, Alpha And in
+// the Pegasus square, Delta and Eta Oph at the ends of Serpens) keeps its
+// own; so a segment whose ends agree goes to their figure, and any other
+// to the figure that owns its polyline, the tag most of its stars carry
+// (the first star's on a tie).
+constexpr uint8_t SegmentFigure(size_t i)
+{
+	const uint8_t To = ConstFigureRecords[i].Figure;
+	if (ConstFigureRecords[i - 1].Figure == To)
+		return To;
+	size_t First = i, Last = i + 1;
+	while (ConstFigureRecords[First].DrawMode != -2)
+		First--;
+	while (Last < RecordCount && ConstFigureRecords[Last].DrawMode == -1)
+		Last++;
+	uint8_t Best = ConstFigureRecords[First].Figure;
+	size_t BestCount = 0;
+	for (size_t j = First; j < Last; j++)
+	{
+		size_t Count = 0;
+		for (size_t k = First; k < Last; k++)
+			Count += (ConstFigureRecords[k].Figure == ConstFigureRecords[j].Figure);
+		if (Count > BestCount)
+		{
+			Best = ConstFigureRecords[j].Figure;
+			BestCount = Count;
+		}
+	}
+	return Best;
+}
+
+// Counting sort of the segments by figure; the Pascal table isn't in
+// figure order everywhere (Serpens and Ophiuchus interleave).
+constexpr std::array<uint16_t, ConstFigureCount + 1> MakeSegmentStart()
+{
+	std::array<uint16_t, ConstFigureCount + 1> Start{};
+	for (size_t i = 1; i < RecordCount; i++)
+		if (ConstFigureRecords[i].DrawMode == -1)
+			Start[SegmentFigure(i) + 1]++;
+	for (int f = 0; f < ConstFigureCount; f++)
+		Start[f + 1] += Start[f];
+	return Start;
+}
+
+constexpr std::array<uint16_t, ConstFigureCount + 1> SegmentStart =
+	MakeSegmentStart();
+
+constexpr std::array<uint16_t, 2 * SegmentCount> MakeSegments()
+{
+	std::array<uint16_t, 2 * SegmentCount> Segments{};
+	std::array<uint16_t, ConstFigureCount + 1> Next = SegmentStart;
+	for (size_t i = 1; i < RecordCount; i++)
+		if (ConstFigureRecords[i].DrawMode == -1)
+		{
+			const size_t s = Next[SegmentFigure(i)]++;
+			Segments[2 * s] = RecordVertex[i - 1];
+			Segments[2 * s + 1] = RecordVertex[i];
+		}
+	return Segments;
+}
+} // namespace ConstFigureDetail
+
+//---------------------------------------------------------------------------
+inline constexpr std::array<ConstFigureVertex, ConstFigureDetail::VertexCount>
+	ConstFigureVertices = ConstFigureDetail::MakeVertices();
+
+inline constexpr std::array<uint16_t, 2 * ConstFigureDetail::SegmentCount>
+	ConstFigureSegments = ConstFigureDetail::MakeSegments();
+
+inline constexpr std::array<uint16_t, ConstFigureCount + 1>
+	ConstFigureSegmentStart = ConstFigureDetail::SegmentStart;
+
+inline constexpr auto ConstFigureLineVertices = []
+{
+	std::array<ConstFigureVertex, 2 * ConstFigureDetail::SegmentCount> Lines{};
+	for (size_t i = 0; i < Lines.size(); i++)
+		Lines[i] = ConstFigureVertices[ConstFigureSegments[i]];
+	return Lines;
+}();
+
+inline constexpr auto ConstFigureLabelVertices = []
+{
+	std::array<ConstFigureVertex, ConstFigureCount> Labels{};
+	for (int f = 0; f < ConstFigureCount; f++)
+		Labels[f] = ConstFigureDetail::ToVertex(ConstFigureLabels[f][0],
+			ConstFigureLabels[f][1]);
+	return Labels;
+}();
+
+// Vertex (index into ConstFigureVertices) of each record of
+// ConstFigureRecords, e.g. to find the Bayer letter for a vertex.
+inline constexpr const std::array<uint16_t, ConstFigureDetail::RecordCount>&
+	ConstFigureRecordVertex = ConstFigureDetail::RecordVertex;
+
+//---------------------------------------------------------------------------
+#endif
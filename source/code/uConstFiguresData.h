@@ -0,0 +1,720 @@
+// Constellation figures, transcribed from uConstellations.pas (Han Kleijn,
+// www.hnsky.org, MPL 2.0).  Regenerate from there if the Pascal tables
+// change; don't edit by hand.  Included by uConstFigures.h only.
+
+// {DrawMode, RA x1000 (hours), Dec x100 (degrees), Figure, Bayer}.  Figure
+// is the {n} tag after the star in Constellation[] (it is only a comment
+// there); uConstFigures.h works out the figure of each segment from the
+// tags of its ends.  figverify checks every record against the Pascal
+// table.
+inline constexpr ConstFigureRecord ConstFigureRecords[] = {
+	{-2, 140, 2909, 0, u8"α"},  // Alpha And
+	{-1, 655, 3086, 0, u8"δ"},  // Delta And
+	{-1, 1162, 3562, 0, u8"β"},  // Beta And
+	{-1, 2065, 4233, 0, u8"γ"},  // Gamma 1 And
+	{-2, 1162, 3562, 0, u8"β"},  // Beta And
+	{-1, 946, 3850, 0, u8"μ"},  // Mu And
+	{-1, 830, 4108, 0, u8"ν"},  // Nu And
+	{-2, 10945, -3714, 1, u8"ι"},  // Iota Ant
+	{-1, 10453, -3107, 1, u8"α"},  // Alpha Ant
+	{-1, 9487, -3595, 1, u8"ε"},  // Epsilon Ant
+	{-2, 14798, -7904, 2, u8"α"},  // Alpha Aps
+	{-1, 16558, -7890, 2, u8"γ"},  // Gamma Aps
+	{-1, 16718, -7752, 2, u8"β"},  // Beta Aps
+	{-2, 22877, -758, 3, u8"λ"},  // Lambda Aqr
+	{-1, 22589, -12, 3, u8"η"},  // Eta Aqr
+	{-1, 22480, -2, 3, u8"ζ"},  // Zeta 1 Aqr
+	{-1, 22361, -139, 3, u8"γ"},  // Gamma Aqr
+	{-1, 22096, -32, 3, u8"α"},  // Alpha Aqr
+	{-1, 21526, -557, 3, u8"β"},  // Beta Aqr
+	{-1, 20795, -950, 3, u8"ε"},  // Epsilon Aqr
+	{-2, 22361, -139, 3, u8"γ"},  // Gamma Aqr
+	{-1, 22281, -778, 3, u8"θ"},  // Theta Aqr
+	{-1, 22911, -1582, 3, u8"δ"},  // Delta Aqr
+	{-2, 20189, -82, 4, u8"θ"},  // Theta Aql
+	{-1, 19922, 641, 4, u8"β"},  // Beta Aql
+	{-1, 19846, 887, 4, u8"α"},  // Alpha Aql
+	{-1, 19771, 1061, 4, u8"γ"},  // Gamma Aql
+	{-1, 19090, 1386, 4, u8"ζ"},  // Zeta Aql
+	{-1, 18994, 1507, 4, u8"ε"},  // Epsilon Aql
+	{-2, 19846, 887, 4, u8"α"},  // Alpha Aql
+	{-1, 19425, 311, 4, u8"δ"},  // Delta Aql
+	{-1, 19104, -488, 4, u8"λ"},  // Lambda Aql
+	{-2, 18110, -5009, 5, u8"θ"},  // Theta Ara
+	{-1, 17531, -4988, 5, u8"α"},  // Alpha Ara
+	{-1, 17422, -5553, 5, u8"β"},  // Beta Ara
+	{-1, 17423, -5638, 5, u8"γ"},  // Gamma Ara
+	{-1, 17518, -6068, 5, u8"δ"},  // Delta Ara
+	{-2, 17422, -5553, 5, u8"β"},  // Beta Ara
+	{-1, 16977, -5599, 5, u8"ζ"},  // Zeta Ara
+	{-1, 16830, -5904, 5, u8"η"},  // Eta Ara
+	{-2, 2833, 2726, 6, u8"41"},  // 41 Ari
+	{-1, 2120, 2346, 6, u8"α"},  // Alpha Ari
+	{-1, 1911, 2081, 6, u8"β"},  // Beta Ari
+	{-1, 1892, 1930, 6, u8"γ"},  // Gamma 1 Ari B
+	{-2, 5278, 4600, 7, u8"α"},  // Alpha Aur
+	{-1, 5033, 4382, 7, u8"ε"},  // Epsilon Aur
+	{-1, 4950, 3317, 7, u8"ι"},  // Iota Aur
+	{-1, 5438, 2861, 78, u8"β"},  // Beta Tau
+	{-1, 5995, 3721, 7, u8"θ"},  // Theta Aur
+	{-1, 5992, 4495, 7, u8"β"},  // Beta Aur
+	{-1, 5278, 4600, 7, u8"α"},  // Alpha Aur
+	{-2, 13911, 1840, 8, u8"η"},  // Eta Boo
+	{-1, 14261, 1918, 8, u8"α"},  // Alpha Boo
+	{-1, 14531, 3037, 8, u8"ρ"},  // Rho Boo, new 2001-10-21
+	{-1, 14535, 3831, 8, u8"γ"},  // Gamma Boo
+	{-1, 15032, 4039, 8, u8"β"},  // Beta Boo
+	{-1, 15258, 3331, 8, u8"δ"},  // Delta Boo
+	{-1, 14750, 2707, 8, u8"ε"},  // Epsilon Boo
+	{-1, 14261, 1918, 8, u8"α"},  // Alpha Boo
+	{-1, 14686, 1373, 8, u8"ζ"},  // Zeta Boo
+	{-2, 4514, -4495, 9, u8"δ"},  // Delta Cae
+	{-1, 4676, -4186, 9, u8"1"},  // 1 Cae
+	{-1, 4701, -3714, 9, u8"β"},  // Beta Cae
+	{-1, 5073, -3548, 9, u8"γ"},  // Gamma Cae
+	{-2, 12821, 8341, 10, u8""},  // SAO2102 Cam
+	{-1, 7001, 7698, 10, u8""},  // 6022 Cam
+	{-1, 6314, 6932, 10, u8""},  // SAO13788 Cam
+	{-1, 4901, 6634, 10, u8"α"},  // Alpha Cam
+	{-1, 5057, 6044, 10, u8"β"},  // Beta Cam
+	{-1, 4955, 5375, 10, u8"7"},  // 7 Cam
+	{-2, 3484, 5994, 10, u8"CS"},  // CS Cam
+	{-1, 3825, 6553, 10, u8"BE"},  // BE Cam
+	{-1, 3839, 7133, 10, u8"γ"},  // Gamma Cam
+	{-1, 6314, 6932, 10, u8""},  // SAO13788 Cam
+	{-2, 8975, 1186, 11, u8"α"},  // Alpha Cnc
+	{-1, 8745, 1815, 11, u8"δ"},  // Delta Cnc
+	{-1, 8721, 2147, 11, u8"γ"},  // Gamma Cnc
+	{-1, 8778, 2876, 11, u8"ι"},  // Iota Cnc
+	{-2, 8275, 919, 11, u8"β"},  // Beta Cnc
+	{-1, 8745, 1815, 11, u8"δ"},  // Delta Cnc
+	{-1, 8204, 1765, 11, u8"ζ"},  // Zeta Cnc
+	{-2, 12933, 3831, 12, u8"α"},  // Alpha 1 CVn
+	{-1, 12562, 4136, 12, u8"β"},  // Beta CVn
+	{-2, 7402, -2930, 13, u8"η"},  // Eta CMa
+	{-1, 7140, -2639, 13, u8"δ"},  // Delta CMa
+	{-1, 6752, -1672, 13, u8"α"},  // Alpha CMa
+	{-1, 6378, -1796, 13, u8"β"},  // Beta CMa
+	{-2, 7063, -1563, 13, u8"γ"},  // Gamma CMa
+	{-1, 6936, -1705, 13, u8"ι"},  // Iota CMa
+	{-1, 6752, -1672, 13, u8"α"},  // Alpha CMa
+	{-2, 6977, -2897, 13, u8"ε"},  // Epsilon CMa
+	{-1, 7140, -2639, 13, u8"δ"},  // Delta CMa
+	{-2, 7655, 523, 14, u8"α"},  // Alpha CMi
+	{-1, 7453, 829, 14, u8"β"},  // Beta CMi
+	{-1, 7469, 893, 14, u8"γ"},  // Gamma CMi
+	{-2, 20294, -1251, 15, u8"α"},  // Alpha 1 Cap
+	{-1, 20301, -1255, 15, u8"α2"},  // Alpha2 Cap
+	{-1, 20350, -1478, 15, u8"β"},  // Beta 1 Cap
+	{-1, 20768, -2527, 15, u8"ψ"},  // Psi Cap
+	{-1, 20864, -2692, 15, u8"ω"},  // Omega Cap
+	{-1, 21444, -2241, 15, u8"ζ"},  // Zeta Cap
+	{-1, 21784, -1613, 15, u8"δ"},  // Delta Cap
+	{-1, 21668, -1666, 15, u8"γ"},  // Gamma Cap
+	{-1, 21371, -1683, 15, u8"ι"},  // Iota Cap
+	{-1, 21099, -1723, 15, u8"θ"},  // Theta Cap
+	{-1, 20350, -1478, 15, u8"β"},  // Beta 1 Cap
+	{-2, 6399, -5270, 16, u8"α"},  // Alpha Car
+	{-1, 7946, -5298, 16, u8"χ"},  // Chi Car
+	{-1, 8375, -5951, 16, u8"ε"},  // Epsilon Car
+	{-1, 9183, -5897, 16, u8"a"},  // a Car
+	{-1, 9285, -5928, 16, u8"ι"},  // Iota Car
+	{-1, 10285, -6133, 16, u8"q"},  // q Car
+	{-1, 10716, -6439, 16, u8"θ"},  // Theta Car
+	{-1, 10229, -7004, 16, u8"ω"},  // Omega Car
+	{-1, 9220, -6972, 16, u8"β"},  // Beta Car
+	{-1, 9785, -6507, 16, u8"υ"},  // Upsilon Car
+	{-1, 9285, -5928, 16, u8"ι"},  // Iota Car
+	{-2, 1907, 6367, 17, u8"ε"},  // Epsilon Cas
+	{-1, 1430, 6024, 17, u8"δ"},  // Delta Cas
+	{-1, 945, 6072, 17, u8"γ"},  // Gamma Cas
+	{-1, 675, 5654, 17, u8"α"},  // Alpha Cas
+	{-1, 153, 5915, 17, u8"β"},  // Beta Cas
+	{-2, 14660, -6084, 18, u8"α"},  // Alpha 1 Cen
+	{-1, 14064, -6037, 18, u8"β"},  // Beta Cen
+	{-1, 13665, -5347, 18, u8"ε"},  // Epsilon Cen
+	{-1, 13926, -4729, 18, u8"ζ"},  // Zeta Cen
+	{-1, 14592, -4216, 18, u8"η"},  // Eta Cen
+	{-1, 14111, -3637, 18, u8"θ"},  // Theta Cen
+	{-1, 13343, -3671, 18, u8"ι"},  // Iota Cen
+	{-1, 12692, -4896, 18, u8"γ"},  // Gamma Cen
+	{-2, 12139, -5072, 18, u8"δ"},  // Delta Cen
+	{-1, 12692, -4896, 18, u8"γ"},  // Gamma Cen
+	{-1, 13665, -5347, 18, u8"ε"},  // Epsilon Cen
+	{-2, 21478, 7056, 19, u8"β"},  // Beta Cep
+	{-1, 21310, 6259, 19, u8"α"},  // Alpha Cep
+	{-1, 22486, 5842, 19, u8"δ"},  // Delta Cep
+	{-1, 22828, 6620, 19, u8"ι"},  // Iota Cep
+	{-1, 23656, 7763, 19, u8"γ"},  // Gamma Cep
+	{-1, 21478, 7056, 19, u8"β"},  // Beta Cep
+	{-1, 22828, 6620, 19, u8"ι"},  // Iota Cep
+	{-2, 3038, 409, 20, u8"α"},  // Alpha Cet
+	{-1, 2722, 324, 20, u8"γ"},  // Gamma Cet
+	{-1, 2658, 33, 20, u8"δ"},  // Delta Cet
+	{-1, 2322, -298, 20, u8"ο"},  // Omicron Cet
+	{-1, 1858, -1034, 20, u8"ζ"},  // Zeta Cet
+	{-1, 1734, -1594, 20, u8"τ"},  // Tau Cet
+	{-1, 726, -1799, 20, u8"β"},  // Beta Cet
+	{-1, 324, -882, 20, u8"ι"},  // Iota Cet
+	{-2, 1858, -1034, 20, u8"ζ"},  // Zeta Cet
+	{-1, 1400, -818, 20, u8"θ"},  // Theta Cet
+	{-1, 1143, -1018, 20, u8"η"},  // Eta Cet
+	{-1, 726, -1799, 20, u8"β"},  // Beta Cet
+	{-2, 8309, -7692, 21, u8"α"},  // Alpha Cha
+	{-1, 10591, -7861, 21, u8"γ"},  // Gamma Cha
+	{-1, 12306, -7931, 21, u8"β"},  // Beta Cha
+	{-1, 10763, -8054, 21, u8"δ2"},  // Delta2 Cha
+	{-1, 8344, -7748, 21, u8"θ"},  // Theta Cha
+	{-1, 8309, -7692, 21, u8"α"},  // Alpha Cha
+	{-2, 15292, -5880, 22, u8"β"},  // Beta Cir
+	{-1, 14708, -6498, 22, u8"α"},  // Alpha Cir
+	{-1, 15390, -5932, 22, u8"γ"},  // Gamma Cir
+	{-2, 6369, -3344, 23, u8"δ"},  // Delta Col
+	{-1, 5849, -3577, 23, u8"β"},  // Beta Col
+	{-1, 5661, -3407, 23, u8"α"},  // Alpha Col
+	{-1, 5520, -3547, 23, u8"ε"},  // Epsilon Col
+	{-1, 5849, -3577, 23, u8"β"},  // Beta Col
+	{-2, 13166, 1753, 24, u8"α"},  // Alpha Com
+	{-1, 13198, 2788, 24, u8"β"},  // Beta Com
+	{-1, 12449, 2827, 24, u8"γ"},  // Gamma Com
+	{-2, 19107, -3706, 25, u8"γ"},  // Gamma CrA
+	{-1, 19158, -3790, 25, u8"α"},  // Alpha CrA
+	{-1, 19167, -3934, 25, u8"β"},  // Beta CrA
+	{-2, 15960, 2688, 26, u8"ε"},  // Epsilon CrB
+	{-1, 15712, 2630, 26, u8"γ"},  // Gamma CrB
+	{-1, 15578, 2671, 26, u8"α"},  // Alpha CrB
+	{-1, 15464, 2911, 26, u8"β"},  // Beta CrB
+	{-1, 15549, 3136, 26, u8"θ"},  // Theta CrB
+	{-2, 12140, -2473, 27, u8"α"},  // Alpha Crv
+	{-1, 12169, -2262, 27, u8"ε"},  // Epsilon Crv
+	{-1, 12263, -1754, 27, u8"γ"},  // Gamma Crv
+	{-1, 12498, -1652, 27, u8"δ"},  // Delta Crv
+	{-1, 12573, -2340, 27, u8"β"},  // Beta Crv
+	{-1, 12169, -2262, 27, u8"ε"},  // Epsilon Crv
+	{-2, 10996, -1830, 28, u8"α"},  // Alpha Crt
+	{-1, 11194, -2283, 28, u8"β"},  // Beta Crt
+	{-1, 11415, -1768, 28, u8"γ"},  // Gamma Crt
+	{-1, 11322, -1478, 28, u8"δ"},  // Delta Crt
+	{-1, 10996, -1830, 28, u8"α"},  // Alpha Crt
+	{-2, 12443, -6310, 29, u8"α"},  // Alpha 1 Cru
+	{-1, 12519, -5711, 29, u8"γ"},  // Gamma Cru a
+	{-2, 12795, -5969, 29, u8"β"},  // Beta Crux
+	{-1, 12252, -5875, 29, u8"δ"},  // Delta Cru
+	{-2, 20691, 4528, 30, u8"α"},  // Alpha Cyg
+	{-1, 20370, 4026, 30, u8"γ"},  // Gamma Cyg
+	{-1, 19938, 3508, 30, u8"η"},  // Eta Cyg
+	{-1, 19843, 3291, 30, u8"χ"},  // Chi Cyg
+	{-1, 19513, 2797, 30, u8"β"},  // Beta Cyg
+	{-2, 21216, 3023, 30, u8"ζ"},  // Zeta Cyg
+	{-1, 20770, 3397, 30, u8"ε"},  // Epsilon Cyg
+	{-1, 20370, 4026, 30, u8"γ"},  // Gamma Cyg
+	{-1, 19750, 4513, 30, u8"δ"},  // Delta Cyg
+	{-1, 19495, 5173, 30, u8"ι"},  // Iota Cyg
+	{-1, 19285, 5337, 30, u8"κ"},  // Kappa Cyg
+	{-2, 20554, 1130, 31, u8"ε"},  // Epsilon Del
+	{-1, 20588, 1467, 31, u8"ζ"},  // Zeta Del
+	{-1, 20661, 1591, 31, u8"α"},  // Alpha Del
+	{-1, 20777, 1612, 31, u8"γ"},  // Gamma 1 Del
+	{-1, 20724, 1507, 31, u8"δ"},  // Delta Del
+	{-1, 20626, 1460, 31, u8"β"},  // Beta Del
+	{-1, 20588, 1467, 31, u8"ζ"},  // Zeta Del
+	{-2, 4267, -5149, 32, u8"γ"},  // Gamma Dor
+	{-1, 4567, -5505, 32, u8"α"},  // Alpha Dor
+	{-1, 5560, -6249, 32, u8"β"},  // Beta Dor
+	{-1, 5746, -6574, 32, u8"δ"},  // Delta Dor
+	{-2, 12558, 6979, 33, u8"κ"},  // Kappa Dra
+	{-1, 14073, 6438, 33, u8"α"},  // Alpha Dra
+	{-1, 15415, 5897, 33, u8"ι"},  // Iota Dra
+	{-1, 16031, 5857, 33, u8"θ"},  // Theta Dra
+	{-1, 16400, 6151, 33, u8"η"},  // Eta Dra
+	{-1, 17146, 6571, 33, u8"ζ"},  // Zeta Dra
+	{-1, 19803, 7027, 33, u8"ε"},  // Epsilon Dra
+	{-1, 19209, 6766, 33, u8"δ"},  // Delta Dra
+	{-1, 17536, 5518, 33, u8"ν"},  // Nu 1 Dra
+	{-1, 17507, 5230, 33, u8"β"},  // Beta Dra
+	{-1, 17943, 5149, 33, u8"γ"},  // Gamma Dra
+	{-1, 17536, 5518, 33, u8"ν"},  // Nu 1 Dra
+	{-2, 21264, 525, 34, u8"α"},  // Alpha Equ
+	{-1, 21241, 1001, 34, u8"δ"},  // Delta Equ
+	{-1, 21172, 1013, 34, u8"γ"},  // Gamma Equ
+	{-1, 20985, 429, 34, u8"ε"},  // Epsilon Equ
+	{-1, 21264, 525, 34, u8"α"},  // Alpha Equ
+	{-2, 5131, -509, 35, u8"β"},  // Beta Eri
+	{-1, 4605, -335, 35, u8"ν"},  // Nu Eri
+	{-1, 3967, -1351, 35, u8"γ"},  // Gamma Eri
+	{-1, 3721, -976, 35, u8"δ"},  // Delta Eri
+	{-1, 3549, -946, 35, u8"ε"},  // Epsilon Eri
+	{-1, 2940, -890, 35, u8"η"},  // Eta Eri
+	{-1, 4298, -3380, 35, u8"41"},  // 41 Eri
+	{-1, 2971, -4030, 35, u8"θ"},  // Theta 1 Eri
+	{-1, 2275, -5150, 35, u8"φ"},  // phi Eri
+	{-1, 1933, -5161, 35, u8"χ"},  // Chi Eri
+	{-1, 1629, -5724, 35, u8"α"},  // Alpha Eri
+	{-2, 3704, -3194, 36, u8"δ"},  // Delta For
+	{-1, 3201, -2899, 36, u8"α"},  // Alpha For
+	{-1, 2818, -3241, 36, u8"β"},  // Beta For
+	{-1, 2075, -2930, 36, u8"ν"},  // Nu For
+	{-2, 6629, 1640, 37, u8"γ"},  // Gamma Gem
+	{-1, 7068, 2057, 37, u8"ζ"},  // Zeta Gem
+	{-1, 7335, 2198, 37, u8"δ"},  // Delta Gem
+	{-1, 7755, 2803, 37, u8"β"},  // Beta Gem
+	{-1, 7577, 3189, 37, u8"α"},  // Alpha Gem
+	{-1, 6732, 2513, 37, u8"ε"},  // Epsilon Gem
+	{-1, 6383, 2251, 37, u8"μ"},  // Mu Gem
+	{-1, 6248, 2251, 37, u8"η"},  // Eta Gem
+	{-2, 21899, -3737, 38, u8"γ"},  // Gamma Gru
+	{-1, 22488, -4350, 38, u8"δ"},  // Delta 1 Gru
+	{-1, 22496, -4375, 38, u8"δ2"},  // Delta2 Gru
+	{-1, 22711, -4688, 38, u8"β"},  // Beta Gru
+	{-1, 22809, -5132, 38, u8"ε"},  // Epsilon Gru
+	{-1, 23015, -5275, 38, u8"ζ"},  // Zeta Gru
+	{-2, 22137, -4696, 38, u8"α"},  // Alpha Gru
+	{-1, 22488, -4350, 38, u8"δ"},  // Delta 1 Gru
+	{-2, 17938, 3725, 39, u8"θ"},  // Theta Her
+	{-1, 17251, 3681, 39, u8"π"},  // Pi Her
+	{-1, 17005, 3093, 39, u8"ε"},  // Epsilon Her
+	{-1, 17251, 2484, 39, u8"δ"},  // Delta Her
+	{-1, 17244, 1439, 39, u8"α"},  // Alpha 1 Her
+	{-2, 17251, 3681, 39, u8"π"},  // Pi Her
+	{-1, 16715, 3892, 39, u8"η"},  // Eta Her
+	{-1, 16688, 3160, 39, u8"ζ"},  // Zeta Her
+	{-1, 16504, 2149, 39, u8"β"},  // Beta Her
+	{-1, 16365, 1915, 39, u8"γ"},  // Gamma Her
+	{-2, 17005, 3093, 39, u8"ε"},  // Epsilon Her
+	{-1, 16688, 3160, 39, u8"ζ"},  // Zeta Her
+	{-2, 16715, 3892, 39, u8"η"},  // Eta Her
+	{-1, 16568, 4244, 39, u8"σ"},  // Sigma Her
+	{-1, 16329, 4631, 39, u8"τ"},  // Tau Her
+	{-2, 4233, -4229, 40, u8"α"},  // Alpha Hor
+	{-1, 2623, -5254, 40, u8"η"},  // Eta Hor
+	{-1, 2980, -6407, 40, u8"β"},  // Beta Hor
+	{-2, 14106, -2668, 41, u8"π"},  // Pi Hya
+	{-1, 13495, -2328, 41, u8"R"},  // R Hya
+	{-1, 13315, -2317, 41, u8"γ"},  // Gamma Hya
+	{-1, 11882, -3391, 41, u8"β"},  // Beta Hya
+	{-1, 11550, -3186, 41, u8"ξ"},  // Xi Hya
+	{-1, 10827, -1619, 41, u8"ν"},  // Nu Hya
+	{-1, 10176, -1235, 41, u8"λ"},  // Lambda Hya, NIEUW HAN
+	{-1, 9858, -1485, 41, u8"υ"},  // Upsilon 1 Hya, nieuw han
+	{-1, 9460, -866, 41, u8"α"},  // Alpha Hya
+	{-1, 9664, -114, 41, u8"ι"},  // Iota Hya, nieuw han
+	{-1, 9239, 231, 41, u8"θ"},  // Theta Hya, nieuw han
+	{-1, 8923, 595, 41, u8"ζ"},  // Zeta Hya
+	{-1, 8780, 642, 41, u8"ε"},  // Epsilon Hya
+	{-1, 8628, 570, 41, u8"δ"},  // Delta Hya
+	{-1, 8720, 340, 41, u8"η"},  // Eta Hya
+	{-1, 8923, 595, 41, u8"ζ"},  // Zeta Hya
+	{-2, 1980, -6157, 42, u8"α"},  // Alpha Hyi
+	{-1, 429, -7725, 42, u8"β"},  // Beta Hyi
+	{-1, 3787, -7424, 42, u8"γ"},  // Gamma Hyi
+	{-1, 1980, -6157, 42, u8"α"},  // Alpha Hyi
+	{-2, 20626, -4729, 43, u8"α"},  // Alpha Ind
+	{-1, 21331, -5345, 43, u8"θ"},  // Theta Ind
+	{-1, 20913, -5845, 43, u8"β"},  // Beta Ind
+	{-2, 21331, -5345, 43, u8"θ"},  // Theta Ind
+	{-1, 21965, -5499, 43, u8"δ"},  // Delta Ind
+	{-2, 22393, 5223, 44, u8"β"},  // Beta Lac
+	{-1, 22522, 5028, 44, u8"α"},  // Alpha Lac
+	{-1, 22266, 3775, 44, u8"1"},  // 1 Lac
+	{-2, 9764, 2377, 45, u8"ε"},  // Epsilon Leo
+	{-1, 10278, 2342, 45, u8"ζ"},  // Zeta Leo
+	{-1, 10333, 1984, 45, u8"γ"},  // Gamma Leo
+	{-1, 10122, 1676, 45, u8"η"},  // Eta Leo
+	{-1, 10140, 1197, 45, u8"α"},  // Alpha Leo
+	{-1, 11237, 1543, 45, u8"θ"},  // Theta Leo
+	{-1, 11818, 1457, 45, u8"β"},  // Beta Leo
+	{-1, 11235, 2052, 45, u8"δ"},  // Delta Leo
+	{-1, 10333, 1984, 45, u8"γ"},  // Gamma Leo
+	{-2, 10889, 3421, 46, u8"46"},  // 46 LMi
+	{-1, 10465, 3671, 46, u8"β"},  // Beta LMi
+	{-1, 10124, 3524, 46, u8"21"},  // 21 LMi
+	{-1, 9570, 3640, 46, u8"10"},  // 10 LMi
+	{-2, 5940, -1417, 47, u8"η"},  // Eta Lep
+	{-1, 5855, -2088, 47, u8"δ"},  // Delta Lep
+	{-1, 5741, -2245, 47, u8"γ"},  // Gamma Lep
+	{-1, 5471, -2076, 47, u8"β"},  // Beta Lep
+	{-1, 5091, -2237, 47, u8"ε"},  // Epsilon Lep
+	{-1, 5216, -1621, 47, u8"μ"},  // Mu Lep
+	{-1, 5545, -1782, 47, u8"α"},  // Alpha Lep
+	{-1, 5855, -2088, 47, u8"δ"},  // Delta Lep
+	{-1, 5783, -1482, 47, u8"ζ"},  // Zeta Lep
+	{-2, 5545, -1782, 47, u8"α"},  // Alpha Lep
+	{-1, 5471, -2076, 47, u8"β"},  // Beta Lep
+	{-2, 15592, -1479, 48, u8"γ"},  // Gamma Lib
+	{-1, 15283, -938, 48, u8"β"},  // Beta Lib
+	{-1, 14848, -1604, 48, u8"α2"},  // Alpha2 Lib
+	{-2, 14699, -4739, 49, u8"α"},  // Alpha Lup
+	{-1, 14976, -4313, 49, u8"β"},  // Beta Lup
+	{-1, 15356, -4065, 49, u8"δ"},  // Delta Lup
+	{-1, 16002, -3840, 49, u8"η"},  // Eta Lup
+	{-1, 15586, -4117, 49, u8"γ"},  // Gamma Lup
+	{-1, 15378, -4469, 49, u8"ε"},  // Epsilon Lup
+	{-1, 15199, -4874, 49, u8"κ"},  // Kappa 1 Lup
+	{-1, 15205, -5210, 49, u8"ζ"},  // Zeta Lup
+	{-1, 14699, -4739, 49, u8"α"},  // Alpha Lup
+	{-2, 9351, 3439, 50, u8"α"},  // Alpha Lyn
+	{-1, 9314, 3680, 50, u8"38"},  // 38 Lyn
+	{-1, 9011, 4178, 50, u8"10"},  // 10 Lyn
+	{-1, 8381, 4319, 50, u8"31"},  // 31 Lyn
+	{-1, 7445, 4921, 50, u8"21"},  // 21 Lyn
+	{-2, 18616, 3878, 51, u8"α"},  // Alpha Lyr
+	{-1, 18746, 3761, 51, u8"ζ"},  // Zeta 1 Lyr
+	{-1, 18835, 3336, 51, u8"β"},  // Beta Lyr
+	{-1, 18982, 3269, 51, u8"γ"},  // Gamma Lyr
+	{-1, 18908, 3690, 51, u8"δ2"},  // Delta2 Lyr
+	{-1, 18746, 3761, 51, u8"ζ"},  // Zeta 1 Lyr
+	{-2, 6171, -7475, 52, u8"α"},  // Alpha Men
+	{-1, 5531, -7634, 52, u8"γ"},  // Gamma Men
+	{-1, 4920, -7494, 52, u8"η"},  // Eta Men
+	{-1, 5045, -7131, 52, u8"β"},  // Beta Men
+	{-2, 20833, -3378, 53, u8"α"},  // Alpha Mic
+	{-1, 21022, -3226, 53, u8"γ"},  // Gamma Mic
+	{-1, 21299, -3217, 53, u8"ε"},  // Epsilon Mic
+	{-2, 8143, -298, 54, u8"ζ"},  // Zeta Mon
+	{-1, 7687, -955, 54, u8"α"},  // Alpha Mon
+	{-1, 7198, -49, 54, u8"δ"},  // Delta Mon
+	{-2, 6396, 459, 54, u8"ε"},  // Epsilon Mon
+	{-1, 7198, -49, 54, u8"δ"},  // Delta Mon
+	{-1, 6480, -703, 54, u8"β"},  // Beta Mon
+	{-1, 6248, -627, 54, u8"γ"},  // Gamma Mon
+	{-2, 11760, -6673, 55, u8"λ"},  // Lambda Mus
+	{-1, 12293, -6796, 55, u8"ε"},  // Epsilon Mus
+	{-1, 12620, -6914, 55, u8"α"},  // Alpha Mus
+	{-1, 12771, -6811, 55, u8"β"},  // Beta Mus
+	{-1, 13038, -7155, 55, u8"δ"},  // Delta Mus
+	{-1, 12541, -7213, 55, u8"γ"},  // Gamma Mus
+	{-1, 12620, -6914, 55, u8"α"},  // Alpha Mus
+	{-2, 16331, -5016, 56, u8"γ2"},  // Gamma2 Nor
+	{-1, 16054, -4923, 56, u8"η"},  // Eta Nor
+	{-2, 22768, -8138, 57, u8"β"},  // Beta Oct
+	{-1, 14449, -8367, 57, u8"δ"},  // Delta Oct
+	{-1, 21691, -7739, 57, u8"ν"},  // Nu Oct
+	{-1, 22768, -8138, 57, u8"β"},  // Beta Oct
+	{-2, 17367, -2500, 58, u8"θ"},  // Theta Oph
+	{-1, 17173, -1572, 58, u8"η"},  // Eta Oph
+	{-1, 17725, 457, 58, u8"β"},  // Beta Oph
+	{-1, 17582, 1256, 58, u8"α"},  // Alpha Oph
+	{-1, 16961, 938, 58, u8"κ"},  // Kappa Oph
+	{-1, 16239, -369, 58, u8"δ"},  // Delta Oph
+	{-1, 16305, -469, 58, u8"ε"},  // Epsilon Oph
+	{-1, 16619, -1057, 58, u8"ζ"},  // Zeta Oph
+	{-1, 17173, -1572, 58, u8"η"},  // Eta Oph
+	{-2, 5679, -194, 59, u8"ζ"},  // Zeta Ori
+	{-1, 5920, 741, 59, u8"α"},  // Alpha Ori
+	{-1, 5586, 993, 59, u8"λ"},  // Lambda Ori
+	{-1, 5419, 635, 59, u8"γ"},  // Gamma Ori
+	{-1, 5533, -28, 59, u8"δ"},  // Delta Ori
+	{-1, 5604, -120, 59, u8"ε"},  // Epsilon Ori
+	{-1, 5679, -194, 59, u8"ζ"},  // Zeta Ori
+	{-1, 5796, -967, 59, u8"κ"},  // Kappa Ori
+	{-1, 5242, -820, 59, u8"β"},  // Beta Ori
+	{-1, 5533, -28, 59, u8"δ"},  // Delta Ori
+	{-2, 21441, -6537, 60, u8"τ"},  // Tau Pav
+	{-1, 20749, -6620, 60, u8"β"},  // Beta Pav
+	{-1, 20010, -7291, 60, u8"ε"},  // Epsilon Pav
+	{-1, 18717, -7143, 60, u8"ζ"},  // Zeta Pav
+	{-1, 17762, -6472, 60, u8"η"},  // Eta Pav
+	{-1, 18387, -6149, 60, u8"ξ"},  // Xi Pav
+	{-1, 20145, -6618, 60, u8"δ"},  // Delta Pav
+	{-1, 20749, -6620, 60, u8"β"},  // Beta Pav
+	{-2, 22717, 3022, 61, u8"η"},  // Eta Peg
+	{-1, 23063, 2808, 61, u8"β"},  // Beta Peg
+	{-1, 140, 2909, 0, u8"α"},  // Alpha And
+	{-1, 221, 1518, 61, u8"γ"},  // Gamma Peg
+	{-1, 23079, 1521, 61, u8"α"},  // Alpha Peg
+	{-1, 22691, 1083, 61, u8"ζ"},  // Zeta Peg
+	{-1, 22170, 620, 61, u8"θ"},  // Theta Peg
+	{-1, 21736, 988, 61, u8"ε"},  // Epsilon Peg
+	{-2, 23063, 2808, 61, u8"β"},  // Beta Peg
+	{-1, 23079, 1521, 61, u8"α"},  // Alpha Peg
+	{-2, 2845, 5590, 62, u8"η"},  // Eta Per
+	{-1, 3080, 5351, 62, u8"γ"},  // Gamma Per
+	{-1, 3405, 4986, 62, u8"α"},  // Alpha Per
+	{-1, 3715, 4779, 62, u8"δ"},  // Delta Per
+	{-1, 3964, 4001, 62, u8"ε"},  // Epsilon Per
+	{-1, 3902, 3188, 62, u8"ζ"},  // Zeta Per
+	{-2, 3405, 4986, 62, u8"α"},  // Alpha Per
+	{-1, 3136, 4096, 62, u8"β"},  // Beta Per
+	{-1, 3086, 3884, 62, u8"ρ"},  // Rho Per
+	{-2, 157, -4575, 63, u8"ε"},  // Epsilon Phe
+	{-1, 437, -4368, 63, u8"κ"},  // Kappa Phe
+	{-1, 1101, -4672, 63, u8"β"},  // Beta Phe
+	{-1, 1473, -4332, 63, u8"γ"},  // Gamma Phe
+	{-1, 1521, -4907, 63, u8"δ"},  // Delta Phe
+	{-1, 1140, -5525, 63, u8"ζ"},  // Zeta Phe
+	{-1, 1101, -4672, 63, u8"β"},  // Beta Phe
+	{-2, 6803, -6194, 64, u8"α"},  // Alpha Pic
+	{-1, 5830, -5617, 64, u8"γ"},  // Gamma Pic
+	{-1, 5788, -5107, 64, u8"β"},  // Beta Pic
+	{-2, 1525, 1535, 65, u8"η"},  // Eta Psc
+	{-1, 1757, 916, 65, u8"ο"},  // Omicron Psc
+	{-1, 2034, 276, 65, u8"α"},  // Alpha Psc
+	{-1, 1049, 789, 65, u8"ε"},  // Epsilon Psc
+	{-1, 811, 759, 65, u8"δ"},  // Delta Psc
+	{-1, 23989, 686, 65, u8"ω"},  // Omega Psc
+	{-1, 23666, 563, 65, u8"ι"},  // Iota Psc
+	{-1, 23466, 638, 65, u8"θ"},  // Theta Psc
+	{-1, 23065, 382, 65, u8"β"},  // Beta Psc
+	{-1, 23286, 328, 65, u8"γ"},  // Gamma Psc
+	{-1, 23666, 563, 65, u8"ι"},  // Iota Psc
+	{-2, 21749, -3303, 66, u8"ι"},  // Iota PsA
+	{-1, 22525, -3235, 66, u8"β"},  // Beta PsA
+	{-1, 22875, -3288, 66, u8"γ"},  // Gamma PsA
+	{-1, 22932, -3254, 66, u8"δ"},  // Delta PsA
+	{-1, 22961, -2962, 66, u8"α"},  // Alpha PsA
+	{-1, 22678, -2704, 66, u8"ε"},  // Epsilon PsA
+	{-1, 22525, -3235, 66, u8"β"},  // Beta PsA
+	{-2, 8126, -2430, 67, u8"ρ"},  // Rho Pup
+	{-1, 7822, -2486, 67, u8"ξ"},  // Xi Pup
+	{-1, 8060, -4000, 67, u8"ζ"},  // Zeta Pup
+	{-1, 7286, -3710, 67, u8"π"},  // Pi Pup
+	{-1, 7487, -4330, 67, u8"σ"},  // Sigma Pup
+	{-1, 7226, -4464, 67, u8"L2"},  // L2 Pup
+	{-1, 6629, -4320, 67, u8"ν"},  // Nu Pup
+	{-1, 6832, -5061, 67, u8"τ"},  // Tau Pup
+	{-1, 7226, -4464, 67, u8"L2"},  // L2 Pup
+	{-2, 8060, -4000, 67, u8"ζ"},  // Zeta Pup
+	{-1, 7487, -4330, 67, u8"σ"},  // Sigma Pup
+	{-2, 8668, -3531, 68, u8"β"},  // Beta Pyx
+	{-1, 8727, -3319, 68, u8"α"},  // Alpha Pyx
+	{-1, 8842, -2771, 68, u8"γ"},  // Gamma Pyx
+	{-2, 4240, -6247, 69, u8"α"},  // Alpha Ret
+	{-1, 3737, -6481, 69, u8"β"},  // Beta Ret
+	{-1, 4015, -6216, 69, u8"γ"},  // Gamma Ret
+	{-1, 3979, -6140, 69, u8"4"},  // 4 Ret
+	{-1, 4275, -5930, 69, u8"ε"},  // Epsilon Ret
+	{-1, 4240, -6247, 69, u8"α"},  // Alpha Ret
+	{-2, 19668, 1801, 70, u8"α"},  // Alpha Sge
+	{-1, 19790, 1853, 70, u8"δ"},  // Delta Sge
+	{-1, 19684, 1748, 70, u8"β"},  // Beta Sge
+	{-2, 19790, 1853, 70, u8"δ"},  // Delta Sge
+	{-1, 19979, 1949, 70, u8"γ"},  // Gamma Sge
+	{-2, 19387, -4480, 71, u8"β2"},  // Beta2 Sgr
+	{-1, 19377, -4446, 71, u8"β"},  // Beta 1 Sgr
+	{-1, 19398, -4062, 71, u8"α"},  // Alpha Sgr
+	{-1, 19044, -2988, 71, u8"ζ"},  // Zeta Sgr
+	{-1, 18921, -2630, 71, u8"σ"},  // Sigma Sgr
+	{-1, 18466, -2542, 71, u8"λ"},  // Lambda Sgr
+	{-1, 18350, -2983, 71, u8"δ"},  // Delta Sgr
+	{-1, 18403, -3438, 71, u8"ε"},  // Epsilon Sgr
+	{-1, 18294, -3676, 71, u8"η"},  // Eta Sgr
+	{-2, 18097, -3042, 71, u8"γ"},  // Gamma Sgr
+	{-1, 18350, -2983, 71, u8"δ"},  // Delta Sgr
+	{-2, 18229, -2106, 71, u8"μ"},  // Mu Sgr
+	{-1, 18466, -2542, 71, u8"λ"},  // Lambda Sgr
+	{-2, 18962, -2111, 71, u8"ξ2"},  // Xi2 Sgr
+	{-1, 18921, -2630, 71, u8"σ"},  // Sigma Sgr
+	{-2, 17560, -3710, 72, u8"λ"},  // Lambda Sco
+	{-1, 17708, -3903, 72, u8"κ"},  // Kappa Sco
+	{-1, 17622, -4300, 72, u8"θ"},  // Theta Sco
+	{-1, 17203, -4324, 72, u8"η"},  // Eta Sco
+	{-1, 16910, -4236, 72, u8"ζ2"},  // Zeta2 Sco
+	{-1, 16864, -3805, 72, u8"μ"},  // Mu 1 Sco
+	{-1, 16836, -3429, 72, u8"ε"},  // Epsilon Sco
+	{-1, 16490, -2643, 72, u8"α"},  // Alpha Sco
+	{-1, 16091, -1981, 72, u8"β"},  // Beta 1 Sco
+	{-1, 16006, -2262, 72, u8"δ"},  // Delta Sco
+	{-1, 16490, -2643, 72, u8"α"},  // Alpha Sco
+	{-2, 977, -2936, 73, u8"α"},  // Alpha Scl
+	{-1, 23815, -2813, 73, u8"δ"},  // Delta Scl
+	{-1, 23314, -3253, 73, u8"γ"},  // Gamma Scl
+	{-1, 23550, -3782, 73, u8"β"},  // Beta Scl
+	{-2, 18786, -475, 74, u8"β"},  // Beta Sct
+	{-1, 18587, -824, 74, u8"α"},  // Alpha Sct
+	{-1, 18487, -1457, 74, u8"γ"},  // Gamma Sct
+	{-2, 15941, 1566, 76, u8"γ"},  // Gamma Ser
+	{-1, 15770, 1542, 76, u8"β"},  // Beta Ser
+	{-1, 15580, 1054, 76, u8"δ"},  // Delta Ser
+	{-1, 15738, 643, 76, u8"α"},  // Alpha Ser
+	{-1, 15847, 448, 76, u8"ε"},  // Epsilon Ser
+	{-1, 15827, -343, 76, u8"μ"},  // Mu Ser
+	{-1, 16239, -369, 58, u8"δ"},  // Delta Oph
+	{-2, 17173, -1572, 58, u8"η"},  // Eta Oph
+	{-1, 17626, -1540, 76, u8"ξ"},  // Xi Ser
+	{-1, 18355, -290, 76, u8"η"},  // Eta Ser
+	{-1, 18937, 420, 76, u8"θ"},  // Theta 1 Ser
+	{-2, 10505, -64, 77, u8"β"},  // Beta Sex
+	{-1, 10132, -37, 77, u8"α"},  // Alpha Sex
+	{-1, 9875, -811, 77, u8"γ"},  // Gamma Sex
+	{-2, 5627, 2114, 78, u8"ζ"},  // Zeta Tau
+	{-1, 4599, 1651, 78, u8"α"},  // Alpha Tau
+	{-1, 5438, 2861, 78, u8"β"},  // Beta Tau
+	{-2, 4599, 1651, 78, u8"α"},  // Alpha Tau
+	{-1, 4478, 1587, 78, u8"θ2"},  // Theta2 Tau
+	{-1, 4330, 1563, 78, u8"γ"},  // Gamma Tau
+	{-1, 4382, 1754, 78, u8"δ"},  // Delta 1 Tau
+	{-1, 4477, 1918, 78, u8"ε"},  // Epsilon Tau
+	{-2, 3791, 2411, 78, u8"η"},  // Eta Tau
+	{-1, 4330, 1563, 78, u8"γ"},  // Gamma Tau
+	{-1, 4011, 1249, 78, u8"λ"},  // Lambda Tau
+	{-2, 18187, -4595, 79, u8"ε"},  // Epsilon Tel
+	{-1, 18450, -4597, 79, u8"α"},  // Alpha Tel
+	{-1, 18481, -4907, 79, u8"ζ"},  // Zeta Tel
+	{-2, 1885, 2958, 80, u8"α"},  // Alpha Tri
+	{-1, 2159, 3499, 80, u8"β"},  // Beta Tri
+	{-1, 2289, 3385, 80, u8"γ"},  // Gamma Tri
+	{-1, 1885, 2958, 80, u8"α"},  // Alpha Tri
+	{-2, 16811, -6903, 81, u8"α"},  // Alpha TrA
+	{-1, 15919, -6343, 81, u8"β"},  // Beta TrA
+	{-1, 15315, -6868, 81, u8"γ"},  // Gamma TrA
+	{-1, 16811, -6903, 81, u8"α"},  // Alpha TrA
+	{-2, 22308, -6026, 82, u8"α"},  // Alpha Tuc
+	{-1, 23290, -5824, 82, u8"γ"},  // Gamma Tuc
+	{-1, 526, -6296, 82, u8"β"},  // Beta 1 Tuc
+	{-1, 335, -6488, 82, u8"ζ"},  // Zeta Tuc
+	{-1, 22308, -6026, 82, u8"α"},  // Alpha Tuc
+	{-2, 13792, 4931, 83, u8"η"},  // Eta UMa
+	{-1, 13399, 5493, 83, u8"ζ"},  // Zeta UMa
+	{-1, 12900, 5596, 83, u8"ε"},  // Epsilon UMa
+	{-1, 12257, 5703, 83, u8"δ"},  // Delta UMa
+	{-1, 11062, 6175, 83, u8"α"},  // Alpha UMa
+	{-1, 11031, 5638, 83, u8"β"},  // Beta UMa
+	{-1, 11897, 5369, 83, u8"γ"},  // Gamma UMa
+	{-1, 12257, 5703, 83, u8"δ"},  // Delta UMa
+	{-2, 2531, 8926, 84, u8"α"},  // Alpha UMi
+	{-1, 17537, 8659, 84, u8"δ"},  // Delta UMi
+	{-1, 16766, 8204, 84, u8"ε"},  // Epsilon UMi
+	{-1, 15734, 7779, 84, u8"ζ"},  // Zeta UMi
+	{-1, 14845, 7416, 84, u8"β"},  // Beta UMi
+	{-1, 15345, 7183, 84, u8"γ"},  // Gamma UMi
+	{-1, 16292, 7576, 84, u8"η"},  // Eta UMi
+	{-1, 15734, 7779, 84, u8"ζ"},  // Zeta UMi
+	{-2, 10779, -4942, 85, u8"μ"},  // Mu Vel
+	{-1, 9948, -5457, 85, u8"φ"},  // Phi Vel
+	{-1, 9369, -5501, 85, u8"κ"},  // Kappa Vel
+	{-1, 8745, -5471, 85, u8"δ"},  // Delta Vel
+	{-1, 8158, -4735, 85, u8"γ"},  // Gamma 1 Vel
+	{-1, 9133, -4343, 85, u8"λ"},  // Lambda Vel
+	{-1, 9512, -4047, 85, u8"ψ"},  // Psi Vel
+	{-2, 9133, -4343, 85, u8"λ"},  // Lambda Vel
+	{-1, 9369, -5501, 85, u8"κ"},  // Kappa Vel
+	{-2, 14718, -566, 86, u8"μ"},  // Mu Vir
+	{-1, 14267, -600, 86, u8"ι"},  // Iota Vir
+	{-1, 13420, -1116, 86, u8"α"},  // Alpha Vir
+	{-1, 13166, -554, 86, u8"θ"},  // Theta Vir
+	{-1, 12694, -145, 86, u8"γ"},  // Gamma Vir
+	{-1, 12332, -67, 86, u8"η"},  // Eta Vir
+	{-1, 11845, 176, 86, u8"β"},  // Beta Vir
+	{-2, 12694, -145, 86, u8"γ"},  // Gamma Vir
+	{-1, 12927, 340, 86, u8"δ"},  // Delta Vir
+	{-1, 13578, -60, 86, u8"ζ"},  // Zeta Vir
+	{-1, 13420, -1116, 86, u8"α"},  // Alpha Vir
+	{-2, 13036, 1096, 86, u8"ε"},  // Epsilon Vir
+	{-1, 12927, 340, 86, u8"δ"},  // Delta Vir
+	{-2, 9041, -6640, 87, u8"α"},  // Alpha Vol
+	{-1, 8132, -6862, 87, u8"ε"},  // Epsilon Vol
+	{-1, 7281, -6796, 87, u8"δ"},  // Delta Vol
+	{-1, 7145, -7050, 87, u8"γ"},  // Gamma 1 Vol
+	{-1, 7697, -7261, 87, u8"ζ"},  // Zeta Vol
+	{-1, 8132, -6862, 87, u8"ε"},  // Epsilon Vol
+	{-2, 20018, 2775, 88, u8"15"},  // 15 Vul
+	{-1, 19891, 2408, 88, u8"13"},  // 13 Vul
+	{-1, 19478, 2467, 88, u8"α"},  // Alpha Vul
+	{-1, 19270, 2139, 88, u8"1"},  // 1 Vul
+};
+
+// Constpos: label positions, RA x1000 (hours), Dec x100 (degrees)
+inline constexpr int16_t ConstFigureLabels[ConstFigureCount][2] = {
+	{564, 3925},  // Andromeda
+	{10118, -3365},  // Antlia
+	{16000, -8000},  // Apus
+	{22697, -1053},  // Aquarius
+	{19690, 337},  // Aquila
+	{17231, -5189},  // Ara
+	{2676, 2257},  // Aries
+	{5500, 4240},  // Auriga
+	{14687, 3233},  // Bootes
+	{4721, -3883},  // Caelum
+	{6151, 7196},  // Camelopardalis
+	{8497, 2356},  // Cancer
+	{13020, 4235},  // Canes_Venatici
+	{6830, -2269},  // Canis_Major
+	{7624, 676},  // Canis_Minor
+	{21048, -1965},  // Capricornus
+	{7761, -5717},  // Carina
+	{870, 6030},  // Cassiopeia
+	{12950, -4400},  // Centaurus
+	{22417, 7256},  // Cepheus
+	{1709, -664},  // Cetus
+	{12000, -8000},  // Chamaeleon
+	{14527, -6770},  // Circinus
+	{5705, -3708},  // Columba
+	{12748, 2265},  // Coma_Berenices
+	{18655, -4125},  // Corona_Australis
+	{15880, 3263},  // Corona_Borealis
+	{12387, -1836},  // Corvus
+	{11348, -1325},  // Crater
+	{12600, -6070},  // Crux
+	{20598, 4958},  // Cygnus
+	{20663, 1210},  // Delphinus
+	{5333, -6399},  // Dorado
+	{17945, 6606},  // Draco
+	{21251, 794},  // Equuleus
+	{3876, -1701},  // Eridanus
+	{2766, -2694},  // Fornax
+	{7300, 2600},  // Gemini
+	{22457, -4586},  // Grus
+	{17425, 3123},  // Hercules
+	{3212, -5200},  // Horologium
+	{9136, -1132},  // Hydra
+	{2589, -7208},  // Hydrus
+	{21138, -5268},  // Indus
+	{22514, 4667},  // Lacerta
+	{10600, 1800},  // Leo
+	{10316, 3324},  // Leo_Minor
+	{5436, -1935},  // Lepus
+	{15187, -1545},  // Libra
+	{15376, -4228},  // Lupus
+	{7734, 4783},  // Lynx
+	{18908, 4065},  // Lyra
+	{5500, -7999},  // Mensa
+	{20942, -3620},  // Microscopium
+	{6962, -500},  // Monoceros
+	{12460, -6987},  // Musca
+	{16042, -5229},  // Norma
+	{22173, -8473},  // Octans
+	{17037, -265},  // Ophiuchus
+	{5660, 500},  // Orion
+	{19160, -6514},  // Pavo
+	{22617, 1965},  // Pegasus
+	{3514, 4489},  // Perseus
+	{732, -4823},  // Phoenix
+	{5381, -5163},  // Pictor
+	{891, 1548},  // Pisces
+	{22410, -3143},  // Piscis_Austrinus
+	{7873, -3239},  // Puppis
+	{8891, -2921},  // Pyxis
+	{3899, -6049},  // Reticulum
+	{19667, 1700},  // Sagitta
+	{19385, -2911},  // Sagittarius
+	{16865, -3567},  // Scorpius
+	{500, -3500},  // Sculptor
+	{18651, -1011},  // Scutum
+	{15731, 1085},  // Serpens_Caput
+	{17958, -1352},  // Serpens_Cauda
+	{10102, -187},  // Sextans
+	{4095, 1734},  // Taurus
+	{19244, -5154},  // Telescopium
+	{2043, 3234},  // Triangulum
+	{16124, -6590},  // Triangulum_Australe
+	{23828, -6406},  // Tucana
+	{10263, 5748},  // Ursa_Major
+	{15000, 7600},  // Ursa_Minor
+	{9337, -4851},  // Vela
+	{13343, -349},  // Virgo
+	{7659, -6939},  // Volans
+	{20367, 2503},  // Vulpecula
+};
+
+// Constshortname; Serpens has two entries (Caput and Cauda)
+inline constexpr const char* ConstFigureNames[ConstFigureCount] = {
+	"And", "Ant", "Aps", "Aqr", "Aql", "Ara", "Ari", "Aur", "Boo", "Cae", "Cam",
+	"Cnc", "CVn", "CMa", "CMi", "Cap", "Car", "Cas", "Cen", "Cep", "Cet", "Cha",
+	"Cir", "Col", "Com", "CrA", "CrB", "Crv", "Crt", "Cru", "Cyg", "Del", "Dor",
+	"Dra", "Equ", "Eri", "For", "Gem", "Gru", "Her", "Hor", "Hya", "Hyi", "Ind",
+	"Lac", "Leo", "LMi", "Lep", "Lib", "Lup", "Lyn", "Lyr", "Men", "Mic", "Mon",
+	"Mus", "Nor", "Oct", "Oph", "Ori", "Pav", "Peg", "Per", "Phe", "Pic", "Psc",
+	"PsA", "Pup", "Pyx", "Ret", "Sge", "Sgr", "Sco", "Scl", "Sct", "Ser", "Ser",
+	"Sex", "Tau", "Tel", "Tri", "TrA", "Tuc", "UMa", "UMi", "Vel", "Vir", "Vol",
+	"Vul",
+};
@@ -0,0 +1,412 @@
+//---------------------------------------------------------------------------
+
+#include "uConstellationLines.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include "uConstFigures.h"
+
+//---------------------------------------------------------------------------
+#define CONSTLINES_GL_FUNCTIONS(F) \
+	F(PFNGLGENBUFFERSPROC, glGenBuffers) \
+	F(PFNGLBINDBUFFERPROC, glBindBuffer) \
+	F(PFNGLBUFFERDATAPROC, glBufferData) \
+	F(PFNGLBUFFERSUBDATAPROC, glBufferSubData) \
+	F(PFNGLDELETEBUFFERSPROC, glDeleteBuffers) \
+	F(PFNGLCREATESHADERPROC, glCreateShader) \
+	F(PFNGLSHADERSOURCEPROC, glShaderSource) \
+	F(PFNGLCOMPILESHADERPROC, glCompileShader) \
+	F(PFNGLGETSHADERIVPROC, glGetShaderiv) \
+	F(PFNGLGETSHADERINFOLOGPROC, glGetShaderInfoLog) \
+	F(PFNGLDELETESHADERPROC, glDeleteShader) \
+	F(PFNGLCREATEPROGRAMPROC, glCreateProgram) \
+	F(PFNGLATTACHSHADERPROC, glAttachShader) \
+	F(PFNGLLINKPROGRAMPROC, glLinkProgram) \
+	F(PFNGLGETPROGRAMIVPROC, glGetProgramiv) \
+	F(PFNGLGETPROGRAMINFOLOGPROC, glGetProgramInfoLog) \
+	F(PFNGLDELETEPROGRAMPROC, glDeleteProgram) \
+	F(PFNGLUSEPROGRAMPROC, glUseProgram) \
+	F(PFNGLGETATTRIBLOCATIONPROC, glGetAttribLocation) \
+	F(PFNGLGETUNIFORMLOCATIONPROC, glGetUniformLocation) \
+	F(PFNGLUNIFORM1FVPROC, glUniform1fv) \
+	F(PFNGLUNIFORM4FVPROC, glUniform4fv) \
+	F(PFNGLUNIFORMMATRIX4FVPROC, glUniformMatrix4fv) \
+	F(PFNGLVERTEXATTRIBPOINTERPROC, glVertexAttribPointer) \
+	F(PFNGLENABLEVERTEXATTRIBARRAYPROC, glEnableVertexAttribArray) \
+	F(PFNGLDISABLEVERTEXATTRIBARRAYPROC, glDisableVertexAttribArray) \
+	F(PFNGLGETVERTEXATTRIBIVPROC, glGetVertexAttribiv) \
+	F(PFNGLBLENDFUNCSEPARATEPROC, glBlendFuncSeparate)
+
+struct ConstellationLineRenderer::GLFunctions
+{
+#define CONSTLINES_DECLARE(Type, Name) Type Name = nullptr;
+	CONSTLINES_GL_FUNCTIONS(CONSTLINES_DECLARE)
+#undef CONSTLINES_DECLARE
+};
+
+//---------------------------------------------------------------------------
+namespace
+{
+// The mask is one float per constellation; GLSL 1.20 has no integer bit
+// operations, and 88 uniform components fit any 2.x implementation.
+const char* VertexShader =
+	"#version 120\n"
+	"uniform mat4 MVP;\n"
+	"uniform vec4 LineColor;\n"
+	"uniform vec4 HighlightColor;\n"
+	"uniform float Highlight[88];\n"
+	"attribute vec3 Position;\n"
+	"attribute vec2 Constellations;\n"
+	"varying vec4 Color;\n"
+	"void main()\n"
+	"{\n"
+	"  gl_Position = MVP * vec4(Position, 1.0);\n"
+	"  Color = mix(LineColor, HighlightColor,\n"
+	"    max(Highlight[int(Constellations.x + 0.5)],\n"
+	"      Highlight[int(Constellations.y + 0.5)]));\n"
+	"}\n";
+
+const char* FragmentShader =
+	"#version 120\n"
+	"varying vec4 Color;\n"
+	"void main()\n"
+	"{\n"
+	"  gl_FragColor = Color;\n"
+	"}\n";
+
+int ConstellationIndex(const char* Abbreviation)
+{
+	for (int i = 0; i < N_CONSTELLATIONS; i++)
+		if (!std::strcmp(constellation_name(i), Abbreviation))
+			return i;
+	return -1;
+}
+
+// The GL state Draw changes, put back as found for GLScene's state cache
+// (see StarFieldRenderer::Draw).
+struct SavedState
+{
+	GLboolean Blend, DepthMask;
+	GLint BlendSrcRGB, BlendDstRGB, BlendSrcAlpha, BlendDstAlpha;
+	GLint Program, ArrayBuffer, ElementArrayBuffer;
+	GLint AttribEnabled[2];
+};
+} // namespace
+
+//---------------------------------------------------------------------------
+void BuildFigureMesh(ConstLineMesh& Mesh)
+{
+	Mesh.Vertices.clear();
+	Mesh.Indices.clear();
+	Mesh.Indices.reserve(ConstFigureSegments.size());
+
+	// Figure-local copies of the shared vertices; Local[v] is the mesh
+	// index of ConstFigureVertices[v] within the current figure.
+	std::vector<uint32_t> Local(ConstFigureVertices.size());
+	std::vector<uint16_t> Touched;
+	const uint32_t None = ~0u;
+	std::fill(Local.begin(), Local.end(), None);
+
+	for (int f = 0; f < ConstFigureCount; f++)
+	{
+		const int Constellation = ConstellationIndex(ConstFigureNames[f]);
+		if (Constellation < 0)
+			continue;
+		for (size_t i = 2 * ConstFigureSegmentStart[f];
+			i < 2u * ConstFigureSegmentStart[f + 1]; i++)
+		{
+			const uint16_t v = ConstFigureSegments[i];
+			if (Local[v] == None)
+			{
+				const ConstFigureVertex& p = ConstFigureVertices[v];
+				Local[v] = static_cast<uint32_t>(Mesh.Vertices.size());
+				const uint8_t c = static_cast<uint8_t>(Constellation);
+				Mesh.Vertices.push_back({{p.x, p.y, p.z}, c, c, {0, 0}});
+				Touched.push_back(v);
+			}
+			Mesh.Indices.push_back(Local[v]);
+		}
+		for (uint16_t v : Touched)
+			Local[v] = None;
+		Touched.clear();
+	}
+}
+
+//---------------------------------------------------------------------------
+bool LoadBorderMesh(const std::string& FileName, ConstLineMesh& Mesh,
+	float* Epoch)
+{
+	struct
+	{
+		char Magic[4];
+		float Epoch;
+		uint32_t VertexCount;
+		uint32_t IndexCount;
+	} Header;
+
+	Mesh.Vertices.clear();
+	Mesh.Indices.clear();
+	FILE* File = std::fopen(FileName.c_str(), "rb");
+	if (!File)
+		return false;
+	bool Ok = std::fread(&Header, sizeof(Header), 1, File) == 1
+		&& !std::memcmp(Header.Magic, "CBM1", 4) && !(Header.IndexCount & 1)
+		&& Header.VertexCount < (1u << 24) && Header.IndexCount < (1u << 24);
+	if (Ok)
+	{
+		Mesh.Vertices.resize(Header.VertexCount);
+		Mesh.Indices.resize(Header.IndexCount);
+		Ok = std::fread(Mesh.Vertices.data(), sizeof(ConstLineVertex),
+				Header.VertexCount, File) == Header.VertexCount
+			&& std::fread(Mesh.Indices.data(), sizeof(uint32_t),
+				Header.IndexCount, File) == Header.IndexCount;
+	}
+	std::fclose(File);
+	for (size_t i = 0; Ok && i < Mesh.Indices.size(); i++)
+		Ok = Mesh.Indices[i] < Header.VertexCount;
+	for (size_t i = 0; Ok && i < Mesh.Vertices.size(); i++)
+		Ok = Mesh.Vertices[i].Constellation < N_CONSTELLATIONS
+			&& Mesh.Vertices[i].Neighbour < N_CONSTELLATIONS;
+	if (!Ok)
+	{
+		Mesh.Vertices.clear();
+		Mesh.Indices.clear();
+		return false;
+	}
+	if (Epoch)
+		*Epoch = Header.Epoch;
+	return true;
+}
+
+//---------------------------------------------------------------------------
+ConstellationLineRenderer::ConstellationLineRenderer() : FGL(new GLFunctions)
+{
+}
+//---------------------------------------------------------------------------
+ConstellationLineRenderer::~ConstellationLineRenderer()
+{
+	delete FGL;
+}
+//---------------------------------------------------------------------------
+bool ConstellationLineRenderer::Init(GetProcAddressFunc GetProcAddress)
+{
+	GLFunctions& gl = *FGL;
+#define CONSTLINES_LOAD(Type, Name) \
+	gl.Name = reinterpret_cast<Type>(GetProcAddress(#Name)); \
+	if (!gl.Name) \
+	{ \
+		FInfoLog = "OpenGL 2.1 entry point " #Name " is missing"; \
+		return false; \
+	}
+	CONSTLINES_GL_FUNCTIONS(CONSTLINES_LOAD)
+#undef CONSTLINES_LOAD
+
+	auto Compile = [this, &gl](GLenum Type, const char* Source) -> GLuint
+	{
+		GLuint Shader = gl.glCreateShader(Type);
+		GLint Ok = GL_FALSE;
+		gl.glShaderSource(Shader, 1, &Source, nullptr);
+		gl.glCompileShader(Shader);
+		gl.glGetShaderiv(Shader, GL_COMPILE_STATUS, &Ok);
+		if (!Ok)
+		{
+			char Log[1024];
+			gl.glGetShaderInfoLog(Shader, sizeof(Log), nullptr, Log);
+			FInfoLog = Log;
+			gl.glDeleteShader(Shader);
+			return 0;
+		}
+		return Shader;
+	};
+
+	GLuint Vertex = Compile(GL_VERTEX_SHADER, VertexShader);
+	GLuint Fragment = Vertex ? Compile(GL_FRAGMENT_SHADER, FragmentShader) : 0;
+	if (!Fragment)
+	{
+		if (Vertex)
+			gl.glDeleteShader(Vertex);
+		return false;
+	}
+	FProgram = gl.glCreateProgram();
+	gl.glAttachShader(FProgram, Vertex);
+	gl.glAttachShader(FProgram, Fragment);
+	gl.glLinkProgram(FProgram);
+	gl.glDeleteShader(Vertex);
+	gl.glDeleteShader(Fragment);
+
+	GLint Ok = GL_FALSE;
+	gl.glGetProgramiv(FProgram, GL_LINK_STATUS, &Ok);
+	if (!Ok)
+	{
+		char Log[1024];
+		gl.glGetProgramInfoLog(FProgram, sizeof(Log), nullptr, Log);
+		FInfoLog = Log;
+		gl.glDeleteProgram(FProgram);
+		FProgram = 0;
+		return false;
+	}
+	FPositionAttrib = gl.glGetAttribLocation(FProgram, "Position");
+	FConstellationAttrib = gl.glGetAttribLocation(FProgram, "Constellations");
+	FMVPUniform = gl.glGetUniformLocation(FProgram, "MVP");
+	FColorUniform = gl.glGetUniformLocation(FProgram, "LineColor");
+	FHighlightColorUniform = gl.glGetUniformLocation(FProgram, "HighlightColor");
+	FHighlightUniform = gl.glGetUniformLocation(FProgram, "Highlight");
+	gl.glGenBuffers(1, &FVertexBuffer);
+	gl.glGenBuffers(1, &FIndexBuffer);
+	FHighlightChanged = true;
+	return true;
+}
+//---------------------------------------------------------------------------
+void ConstellationLineRenderer::Upload(const ConstLineMesh& Figures,
+	const ConstLineMesh& Borders)
+{
+	if (!FVertexBuffer)
+		return;
+	const GLFunctions& gl = *FGL;
+	const size_t FigureVertices = Figures.Vertices.size();
+	const size_t VertexBytes = sizeof(ConstLineVertex);
+
+	// Borders follow the figures in both buffers, so their indices are
+	// rebased past the figure vertices (2.1 has no base-vertex draws).
+	std::vector<uint32_t> Indices(Figures.Indices);
+	Indices.reserve(Figures.Indices.size() + Borders.Indices.size());
+	for (uint32_t i : Borders.Indices)
+		Indices.push_back(static_cast<uint32_t>(i + FigureVertices));
+
+	gl.glBindBuffer(GL_ARRAY_BUFFER, FVertexBuffer);
+	gl.glBufferData(GL_ARRAY_BUFFER,
+		(FigureVertices + Borders.Vertices.size()) * VertexBytes, nullptr,
+		GL_STATIC_DRAW);
+	gl.glBufferSubData(GL_ARRAY_BUFFER, 0, FigureVertices * VertexBytes,
+		Figures.Vertices.data());
+	gl.glBufferSubData(GL_ARRAY_BUFFER, FigureVertices * VertexBytes,
+		Borders.Vertices.size() * VertexBytes, Borders.Vertices.data());
+	gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	gl.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, FIndexBuffer);
+	gl.glBufferData(GL_ELEMENT_ARRAY_BUFFER, Indices.size() * sizeof(uint32_t),
+		Indices.data(), GL_STATIC_DRAW);
+	gl.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	FFirst[0] = 0;
+	FCount[0] = Figures.Indices.size();
+	FFirst[1] = Figures.Indices.size();
+	FCount[1] = Borders.Indices.size();
+}
+//---------------------------------------------------------------------------
+void ConstellationLineRenderer::SetHighlight(int Constellation, bool On)
+{
+	if (Constellation < 0 || Constellation >= N_CONSTELLATIONS
+		|| FHighlight[Constellation] == On)
+		return;
+	FHighlight[Constellation] = On;
+	FHighlightChanged = true;
+}
+//---------------------------------------------------------------------------
+void ConstellationLineRenderer::ClearHighlight()
+{
+	if (FHighlight.none())
+		return;
+	FHighlight.reset();
+	FHighlightChanged = true;
+}
+//---------------------------------------------------------------------------
+bool ConstellationLineRenderer::Highlighted(int Constellation) const
+{
+	return Constellation >= 0 && Constellation < N_CONSTELLATIONS
+		&& FHighlight[Constellation];
+}
+//---------------------------------------------------------------------------
+void ConstellationLineRenderer::Draw(ConstLineLayer Layer,
+	const float* ModelViewProjection, const float* Color,
+	const float* HighlightColor)
+{
+	const int l = static_cast<int>(Layer);
+	if (!FProgram || !FCount[l])
+		return;
+	const GLFunctions& gl = *FGL;
+	const GLint Attribs[2] = {FPositionAttrib, FConstellationAttrib};
+
+	SavedState Saved;
+	Saved.Blend = glIsEnabled(GL_BLEND);
+	glGetBooleanv(GL_DEPTH_WRITEMASK, &Saved.DepthMask);
+	glGetIntegerv(GL_BLEND_SRC_RGB, &Saved.BlendSrcRGB);
+	glGetIntegerv(GL_BLEND_DST_RGB, &Saved.BlendDstRGB);
+	glGetIntegerv(GL_BLEND_SRC_ALPHA, &Saved.BlendSrcAlpha);
+	glGetIntegerv(GL_BLEND_DST_ALPHA, &Saved.BlendDstAlpha);
+	glGetIntegerv(GL_CURRENT_PROGRAM, &Saved.Program);
+	glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &Saved.ArrayBuffer);
+	glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &Saved.ElementArrayBuffer);
+	for (int i = 0; i < 2; i++)
+		gl.glGetVertexAttribiv(Attribs[i], GL_VERTEX_ATTRIB_ARRAY_ENABLED,
+			&Saved.AttribEnabled[i]);
+
+	gl.glUseProgram(FProgram);
+	// Uniforms stick to the program, so the mask only goes over the bus
+	// when the selection actually changed.
+	if (FHighlightChanged)
+	{
+		float Mask[N_CONSTELLATIONS];
+		for (int i = 0; i < N_CONSTELLATIONS; i++)
+			Mask[i] = FHighlight[i] ? 1.f : 0.f;
+		gl.glUniform1fv(FHighlightUniform, N_CONSTELLATIONS, Mask);
+		FHighlightChanged = false;
+	}
+	gl.glUniformMatrix4fv(FMVPUniform, 1, GL_FALSE, ModelViewProjection);
+	gl.glUniform4fv(FColorUniform, 1, Color);
+	gl.glUniform4fv(FHighlightColorUniform, 1, HighlightColor);
+
+	gl.glBindBuffer(GL_ARRAY_BUFFER, FVertexBuffer);
+	gl.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, FIndexBuffer);
+	gl.glEnableVertexAttribArray(FPositionAttrib);
+	gl.glVertexAttribPointer(FPositionAttrib, 3, GL_FLOAT, GL_FALSE,
+		sizeof(ConstLineVertex),
+		reinterpret_cast<const void*>(offsetof(ConstLineVertex, Pos)));
+	gl.glEnableVertexAttribArray(FConstellationAttrib);
+	gl.glVertexAttribPointer(FConstellationAttrib, 2, GL_UNSIGNED_BYTE, GL_FALSE,
+		sizeof(ConstLineVertex),
+		reinterpret_cast<const void*>(offsetof(ConstLineVertex, Constellation)));
+
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glDepthMask(GL_FALSE);
+
+	glDrawElements(GL_LINES, static_cast<GLsizei>(FCount[l]), GL_UNSIGNED_INT,
+		reinterpret_cast<const void*>(FFirst[l] * sizeof(uint32_t)));
+
+	glDepthMask(Saved.DepthMask);
+	gl.glBlendFuncSeparate(Saved.BlendSrcRGB, Saved.BlendDstRGB,
+		Saved.BlendSrcAlpha, Saved.BlendDstAlpha);
+	if (!Saved.Blend)
+		glDisable(GL_BLEND);
+	for (int i = 0; i < 2; i++)
+		if (!Saved.AttribEnabled[i])
+			gl.glDisableVertexAttribArray(Attribs[i]);
+	gl.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Saved.ElementArrayBuffer);
+	gl.glBindBuffer(GL_ARRAY_BUFFER, Saved.ArrayBuffer);
+	gl.glUseProgram(Saved.Program);
+}
+//---------------------------------------------------------------------------
+void ConstellationLineRenderer::Release()
+{
+	if (FVertexBuffer)
+		FGL->glDeleteBuffers(1, &FVertexBuffer);
+	if (FIndexBuffer)
+		FGL->glDeleteBuffers(1, &FIndexBuffer);
+	if (FProgram)
+		FGL->glDeleteProgram(FProgram);
+	FVertexBuffer = 0;
+	FIndexBuffer = 0;
+	FProgram = 0;
+	FCount[0] = FCount[1] = 0;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,116 @@
+//---------------------------------------------------------------------------
+// Constellation figure and border lines, batched.
+//
+// Both layers live in one interleaved vertex buffer and one index buffer;
+// each is drawn with a single glDrawElements(GL_LINES) call.  Every vertex
+// carries the IAU index (0..87, see conbound.h) of the constellation it
+// belongs to, and the vertex shader looks that up in a highlight mask
+// uniform.  Selecting a constellation (tvConstellationsClick) therefore
+// only flips a bit; the geometry is never rebuilt.
+//
+// A star used by two figures is duplicated, one copy per figure, so each
+// copy can be highlighted on its own.  Border vertices carry both of the
+// constellations they separate and light up when either is selected, so
+// each border is drawn once; conborder.c generates them.
+//
+// Like StarFieldRenderer, this wants a current OpenGL 2.1 or compatibility
+// context and resolves its entry points through the GetProcAddress given
+// to Init().
+//---------------------------------------------------------------------------
+
+#ifndef uConstellationLinesH
+#define uConstellationLinesH
+
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "conbound.h"
+
+//---------------------------------------------------------------------------
+struct ConstLineVertex
+{
+	float Pos[3];           // unit vector, equatorial
+	uint8_t Constellation;  // IAU index 0..87
+	uint8_t Neighbour;      // across a border; same as Constellation in figures
+	uint8_t Pad[2];
+};
+
+static_assert(sizeof(ConstLineVertex) == 16,
+	"line vertices must stay 16 bytes");
+
+// GL_LINES index pairs into Vertices.
+struct ConstLineMesh
+{
+	std::vector<ConstLineVertex> Vertices;
+	std::vector<uint32_t> Indices;
+};
+
+// Fills Mesh with the stick figures of uConstFigures.h.
+void BuildFigureMesh(ConstLineMesh& Mesh);
+// Reads a border mesh written by conborder.  False if the file is missing
+// or malformed; Epoch, if given, gets the equinox the mesh was built for.
+bool LoadBorderMesh(const std::string& FileName, ConstLineMesh& Mesh,
+	float* Epoch = nullptr);
+
+//---------------------------------------------------------------------------
+enum class ConstLineLayer
+{
+	Figures,
+	Borders
+};
+
+class ConstellationLineRenderer
+{
+public:
+	typedef void* (*GetProcAddressFunc)(const char* Name);
+
+	ConstellationLineRenderer();
+	~ConstellationLineRenderer();
+	ConstellationLineRenderer(const ConstellationLineRenderer&) = delete;
+	ConstellationLineRenderer& operator=(const ConstellationLineRenderer&) = delete;
+
+	// Resolves entry points and compiles the shaders.  False if the
+	// context is too old or a shader fails (see InfoLog()).
+	bool Init(GetProcAddressFunc GetProcAddress);
+	// Packs both layers into the shared buffers; either may be empty.
+	void Upload(const ConstLineMesh& Figures, const ConstLineMesh& Borders);
+	// Highlight state is applied at the next Draw().
+	void SetHighlight(int Constellation, bool On = true);
+	void ClearHighlight();
+	bool Highlighted(int Constellation) const;
+	// ModelViewProjection is column-major.  Colors are RGBA; highlighted
+	// constellations get HighlightColor.  Line width is left to the caller.
+	void Draw(ConstLineLayer Layer, const float* ModelViewProjection,
+		const float* Color, const float* HighlightColor);
+	// Frees the GL objects; the context must still be current.
+	void Release();
+
+	size_t IndexCount(ConstLineLayer Layer) const
+	{
+		return FCount[static_cast<int>(Layer)];
+	}
+	const char* InfoLog() const { return FInfoLog.c_str(); }
+
+private:
+	struct GLFunctions;
+	GLFunctions* FGL;
+	unsigned FProgram = 0;
+	unsigned FVertexBuffer = 0;
+	unsigned FIndexBuffer = 0;
+	int FPositionAttrib = -1;
+	int FConstellationAttrib = -1;
+	int FMVPUniform = -1;
+	int FColorUniform = -1;
+	int FHighlightColorUniform = -1;
+	int FHighlightUniform = -1;
+	size_t FFirst[2] = {0, 0};  // in indices
+	size_t FCount[2] = {0, 0};
+	std::bitset<N_CONSTELLATIONS> FHighlight;
+	bool FHighlightChanged = true;
+	std::string FInfoLog;
+};
+
+//---------------------------------------------------------------------------
+#endif
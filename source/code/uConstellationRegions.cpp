@@ -0,0 +1,365 @@
+//---------------------------------------------------------------------------
+
+#include "uConstellationRegions.h"
+
+#include <cmath>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include "precess.h"
+
+//---------------------------------------------------------------------------
+#define CONSTREGIONS_GL_FUNCTIONS(F) \
+	F(PFNGLACTIVETEXTUREPROC, glActiveTexture) \
+	F(PFNGLGENBUFFERSPROC, glGenBuffers) \
+	F(PFNGLBINDBUFFERPROC, glBindBuffer) \
+	F(PFNGLBUFFERDATAPROC, glBufferData) \
+	F(PFNGLDELETEBUFFERSPROC, glDeleteBuffers) \
+	F(PFNGLCREATESHADERPROC, glCreateShader) \
+	F(PFNGLSHADERSOURCEPROC, glShaderSource) \
+	F(PFNGLCOMPILESHADERPROC, glCompileShader) \
+	F(PFNGLGETSHADERIVPROC, glGetShaderiv) \
+	F(PFNGLGETSHADERINFOLOGPROC, glGetShaderInfoLog) \
+	F(PFNGLDELETESHADERPROC, glDeleteShader) \
+	F(PFNGLCREATEPROGRAMPROC, glCreateProgram) \
+	F(PFNGLATTACHSHADERPROC, glAttachShader) \
+	F(PFNGLLINKPROGRAMPROC, glLinkProgram) \
+	F(PFNGLGETPROGRAMIVPROC, glGetProgramiv) \
+	F(PFNGLGETPROGRAMINFOLOGPROC, glGetProgramInfoLog) \
+	F(PFNGLDELETEPROGRAMPROC, glDeleteProgram) \
+	F(PFNGLUSEPROGRAMPROC, glUseProgram) \
+	F(PFNGLGETATTRIBLOCATIONPROC, glGetAttribLocation) \
+	F(PFNGLGETUNIFORMLOCATIONPROC, glGetUniformLocation) \
+	F(PFNGLUNIFORM1IPROC, glUniform1i) \
+	F(PFNGLUNIFORM1FVPROC, glUniform1fv) \
+	F(PFNGLUNIFORM4FVPROC, glUniform4fv) \
+	F(PFNGLUNIFORMMATRIX3FVPROC, glUniformMatrix3fv) \
+	F(PFNGLUNIFORMMATRIX4FVPROC, glUniformMatrix4fv) \
+	F(PFNGLVERTEXATTRIBPOINTERPROC, glVertexAttribPointer) \
+	F(PFNGLENABLEVERTEXATTRIBARRAYPROC, glEnableVertexAttribArray) \
+	F(PFNGLDISABLEVERTEXATTRIBARRAYPROC, glDisableVertexAttribArray) \
+	F(PFNGLGETVERTEXATTRIBIVPROC, glGetVertexAttribiv) \
+	F(PFNGLBLENDFUNCSEPARATEPROC, glBlendFuncSeparate)
+
+struct ConstellationRegionRenderer::GLFunctions
+{
+#define CONSTREGIONS_DECLARE(Type, Name) Type Name = nullptr;
+	CONSTREGIONS_GL_FUNCTIONS(CONSTREGIONS_DECLARE)
+#undef CONSTREGIONS_DECLARE
+};
+
+//---------------------------------------------------------------------------
+namespace
+{
+const char* VertexShader =
+	"#version 120\n"
+	"attribute vec2 Corner;\n"
+	"varying vec2 Clip;\n"
+	"void main()\n"
+	"{\n"
+	"  Clip = Corner;\n"
+	"  gl_Position = vec4(Corner, 0.0, 1.0);\n"
+	"}\n";
+
+// The direction is taken between the near and far plane points, so the
+// camera needn't sit at the origin.  The raster's u runs with RA from 0h,
+// v from the south pole; texels hold index / 255.
+const char* FragmentShader =
+	"#version 120\n"
+	"uniform mat4 InverseMVP;\n"
+	"uniform mat3 ToGrid;\n"
+	"uniform sampler2D Regions;\n"
+	"uniform float Highlight[88];\n"
+	"uniform vec4 TintColor;\n"
+	"varying vec2 Clip;\n"
+	"void main()\n"
+	"{\n"
+	"  vec4 Far = InverseMVP * vec4(Clip, 1.0, 1.0);\n"
+	"  vec4 Near = InverseMVP * vec4(Clip, -1.0, 1.0);\n"
+	"  vec3 d = normalize(ToGrid * (Far.xyz / Far.w - Near.xyz / Near.w));\n"
+	"  vec2 uv = vec2(fract(atan(d.y, d.x) * 0.15915494309),\n"
+	"    asin(clamp(d.z, -1.0, 1.0)) * 0.31830988618 + 0.5);\n"
+	"  float h = Highlight[int(texture2D(Regions, uv).r * 255.0 + 0.5)];\n"
+	"  if (h <= 0.0)\n"
+	"    discard;\n"
+	"  gl_FragColor = vec4(TintColor.rgb, TintColor.a * h);\n"
+	"}\n";
+
+// Column-major 4x4 inverse by cofactors; false if singular.
+bool Invert(const float* m, float* Out)
+{
+	double a[16], inv[16];
+	for (int i = 0; i < 16; i++)
+		a[i] = m[i];
+	inv[0] = a[5] * a[10] * a[15] - a[5] * a[11] * a[14] - a[9] * a[6] * a[15]
+		+ a[9] * a[7] * a[14] + a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+	inv[4] = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] + a[8] * a[6] * a[15]
+		- a[8] * a[7] * a[14] - a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+	inv[8] = a[4] * a[9] * a[15] - a[4] * a[11] * a[13] - a[8] * a[5] * a[15]
+		+ a[8] * a[7] * a[13] + a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+	inv[12] = -a[4] * a[9] * a[14] + a[4] * a[10] * a[13] + a[8] * a[5] * a[14]
+		- a[8] * a[6] * a[13] - a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+	inv[1] = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] + a[9] * a[2] * a[15]
+		- a[9] * a[3] * a[14] - a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+	inv[5] = a[0] * a[10] * a[15] - a[0] * a[11] * a[14] - a[8] * a[2] * a[15]
+		+ a[8] * a[3] * a[14] + a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+	inv[9] = -a[0] * a[9] * a[15] + a[0] * a[11] * a[13] + a[8] * a[1] * a[15]
+		- a[8] * a[3] * a[13] - a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+	inv[13] = a[0] * a[9] * a[14] - a[0] * a[10] * a[13] - a[8] * a[1] * a[14]
+		+ a[8] * a[2] * a[13] + a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+	inv[2] = a[1] * a[6] * a[15] - a[1] * a[7] * a[14] - a[5] * a[2] * a[15]
+		+ a[5] * a[3] * a[14] + a[13] * a[2] * a[7] - a[13] * a[3] * a[6];
+	inv[6] = -a[0] * a[6] * a[15] + a[0] * a[7] * a[14] + a[4] * a[2] * a[15]
+		- a[4] * a[3] * a[14] - a[12] * a[2] * a[7] + a[12] * a[3] * a[6];
+	inv[10] = a[0] * a[5] * a[15] - a[0] * a[7] * a[13] - a[4] * a[1] * a[15]
+		+ a[4] * a[3] * a[13] + a[12] * a[1] * a[7] - a[12] * a[3] * a[5];
+	inv[14] = -a[0] * a[5] * a[14] + a[0] * a[6] * a[13] + a[4] * a[1] * a[14]
+		- a[4] * a[2] * a[13] - a[12] * a[1] * a[6] + a[12] * a[2] * a[5];
+	inv[3] = -a[1] * a[6] * a[11] + a[1] * a[7] * a[10] + a[5] * a[2] * a[11]
+		- a[5] * a[3] * a[10] - a[9] * a[2] * a[7] + a[9] * a[3] * a[6];
+	inv[7] = a[0] * a[6] * a[11] - a[0] * a[7] * a[10] - a[4] * a[2] * a[11]
+		+ a[4] * a[3] * a[10] + a[8] * a[2] * a[7] - a[8] * a[3] * a[6];
+	inv[11] = -a[0] * a[5] * a[11] + a[0] * a[7] * a[9] + a[4] * a[1] * a[11]
+		- a[4] * a[3] * a[9] - a[8] * a[1] * a[7] + a[8] * a[3] * a[5];
+	inv[15] = a[0] * a[5] * a[10] - a[0] * a[6] * a[9] - a[4] * a[1] * a[10]
+		+ a[4] * a[2] * a[9] + a[8] * a[1] * a[6] - a[8] * a[2] * a[5];
+
+	const double Det = a[0] * inv[0] + a[1] * inv[4] + a[2] * inv[8]
+		+ a[3] * inv[12];
+	if (std::fabs(Det) < 1e-30)
+		return false;
+	for (int i = 0; i < 16; i++)
+		Out[i] = static_cast<float>(inv[i] / Det);
+	return true;
+}
+
+// The GL state Draw changes, put back as found for GLScene's state cache
+// (see StarFieldRenderer::Draw).
+struct SavedState
+{
+	GLboolean Blend, DepthTest;
+	GLint BlendSrcRGB, BlendDstRGB, BlendSrcAlpha, BlendDstAlpha;
+	GLint Program, ArrayBuffer, ActiveTexture, Texture, AttribEnabled;
+};
+} // namespace
+
+//---------------------------------------------------------------------------
+ConstellationRegionRenderer::ConstellationRegionRenderer()
+	: FGL(new GLFunctions)
+{
+	SetEpoch(EPOCH_J2000);
+}
+//---------------------------------------------------------------------------
+ConstellationRegionRenderer::~ConstellationRegionRenderer()
+{
+	delete FGL;
+}
+//---------------------------------------------------------------------------
+bool ConstellationRegionRenderer::Init(GetProcAddressFunc GetProcAddress)
+{
+	GLFunctions& gl = *FGL;
+#define CONSTREGIONS_LOAD(Type, Name) \
+	gl.Name = reinterpret_cast<Type>(GetProcAddress(#Name)); \
+	if (!gl.Name) \
+	{ \
+		FInfoLog = "OpenGL 2.1 entry point " #Name " is missing"; \
+		return false; \
+	}
+	CONSTREGIONS_GL_FUNCTIONS(CONSTREGIONS_LOAD)
+#undef CONSTREGIONS_LOAD
+
+	auto Compile = [this, &gl](GLenum Type, const char* Source) -> GLuint
+	{
+		GLuint Shader = gl.glCreateShader(Type);
+		GLint Ok = GL_FALSE;
+		gl.glShaderSource(Shader, 1, &Source, nullptr);
+		gl.glCompileShader(Shader);
+		gl.glGetShaderiv(Shader, GL_COMPILE_STATUS, &Ok);
+		if (!Ok)
+		{
+			char Log[1024];
+			gl.glGetShaderInfoLog(Shader, sizeof(Log), nullptr, Log);
+			FInfoLog = Log;
+			gl.glDeleteShader(Shader);
+			return 0;
+		}
+		return Shader;
+	};
+
+	GLuint Vertex = Compile(GL_VERTEX_SHADER, VertexShader);
+	GLuint Fragment = Vertex ? Compile(GL_FRAGMENT_SHADER, FragmentShader) : 0;
+	if (!Fragment)
+	{
+		if (Vertex)
+			gl.glDeleteShader(Vertex);
+		return false;
+	}
+	FProgram = gl.glCreateProgram();
+	gl.glAttachShader(FProgram, Vertex);
+	gl.glAttachShader(FProgram, Fragment);
+	gl.glLinkProgram(FProgram);
+	gl.glDeleteShader(Vertex);
+	gl.glDeleteShader(Fragment);
+
+	GLint Ok = GL_FALSE;
+	gl.glGetProgramiv(FProgram, GL_LINK_STATUS, &Ok);
+	if (!Ok)
+	{
+		char Log[1024];
+		gl.glGetProgramInfoLog(FProgram, sizeof(Log), nullptr, Log);
+		FInfoLog = Log;
+		gl.glDeleteProgram(FProgram);
+		FProgram = 0;
+		return false;
+	}
+	FCornerAttrib = gl.glGetAttribLocation(FProgram, "Corner");
+	FInverseUniform = gl.glGetUniformLocation(FProgram, "InverseMVP");
+	FToGridUniform = gl.glGetUniformLocation(FProgram, "ToGrid");
+	FRegionsUniform = gl.glGetUniformLocation(FProgram, "Regions");
+	FHighlightUniform = gl.glGetUniformLocation(FProgram, "Highlight");
+	FTintUniform = gl.glGetUniformLocation(FProgram, "TintColor");
+
+	const float Quad[8] = {-1, -1, 1, -1, -1, 1, 1, 1};
+	gl.glGenBuffers(1, &FQuadBuffer);
+	gl.glBindBuffer(GL_ARRAY_BUFFER, FQuadBuffer);
+	gl.glBufferData(GL_ARRAY_BUFFER, sizeof(Quad), Quad, GL_STATIC_DRAW);
+	gl.glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glGenTextures(1, &FTexture);
+	FHighlightChanged = FToGridChanged = true;
+	return true;
+}
+//---------------------------------------------------------------------------
+void ConstellationRegionRenderer::Upload(const congrid_t& Grid)
+{
+	if (!FTexture || !Grid.cells)
+		return;
+	glBindTexture(GL_TEXTURE_2D, FTexture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE8, Grid.width, Grid.height, 0,
+		GL_LUMINANCE, GL_UNSIGNED_BYTE, Grid.cells);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	// Indices can't be interpolated; and RA wraps while dec doesn't.
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+//---------------------------------------------------------------------------
+void ConstellationRegionRenderer::SetEpoch(double Year)
+{
+	double m[9];
+	setup_precession(m, Year, EPOCH_B1875);
+	for (int r = 0; r < 3; r++)
+		for (int c = 0; c < 3; c++)
+			FToGrid[c * 3 + r] = static_cast<float>(m[r * 3 + c]);
+	FToGridChanged = true;
+}
+//---------------------------------------------------------------------------
+void ConstellationRegionRenderer::SetHighlight(int Constellation, bool On)
+{
+	if (Constellation < 0 || Constellation >= N_CONSTELLATIONS
+		|| FHighlight[Constellation] == On)
+		return;
+	FHighlight[Constellation] = On;
+	FHighlightChanged = true;
+}
+//---------------------------------------------------------------------------
+void ConstellationRegionRenderer::ClearHighlight()
+{
+	if (FHighlight.none())
+		return;
+	FHighlight.reset();
+	FHighlightChanged = true;
+}
+//---------------------------------------------------------------------------
+bool ConstellationRegionRenderer::Highlighted(int Constellation) const
+{
+	return Constellation >= 0 && Constellation < N_CONSTELLATIONS
+		&& FHighlight[Constellation];
+}
+//---------------------------------------------------------------------------
+void ConstellationRegionRenderer::Draw(const float* ModelViewProjection,
+	const float* TintColor)
+{
+	float Inverse[16];
+	if (!FProgram || FHighlight.none() || !Invert(ModelViewProjection, Inverse))
+		return;
+	const GLFunctions& gl = *FGL;
+
+	SavedState Saved;
+	Saved.Blend = glIsEnabled(GL_BLEND);
+	Saved.DepthTest = glIsEnabled(GL_DEPTH_TEST);
+	glGetIntegerv(GL_BLEND_SRC_RGB, &Saved.BlendSrcRGB);
+	glGetIntegerv(GL_BLEND_DST_RGB, &Saved.BlendDstRGB);
+	glGetIntegerv(GL_BLEND_SRC_ALPHA, &Saved.BlendSrcAlpha);
+	glGetIntegerv(GL_BLEND_DST_ALPHA, &Saved.BlendDstAlpha);
+	glGetIntegerv(GL_CURRENT_PROGRAM, &Saved.Program);
+	glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &Saved.ArrayBuffer);
+	glGetIntegerv(GL_ACTIVE_TEXTURE, &Saved.ActiveTexture);
+	gl.glGetVertexAttribiv(FCornerAttrib, GL_VERTEX_ATTRIB_ARRAY_ENABLED,
+		&Saved.AttribEnabled);
+
+	gl.glUseProgram(FProgram);
+	if (FHighlightChanged)
+	{
+		float Mask[N_CONSTELLATIONS];
+		for (int i = 0; i < N_CONSTELLATIONS; i++)
+			Mask[i] = FHighlight[i] ? 1.f : 0.f;
+		gl.glUniform1fv(FHighlightUniform, N_CONSTELLATIONS, Mask);
+		FHighlightChanged = false;
+	}
+	if (FToGridChanged)
+	{
+		gl.glUniformMatrix3fv(FToGridUniform, 1, GL_FALSE, FToGrid);
+		FToGridChanged = false;
+	}
+	gl.glUniformMatrix4fv(FInverseUniform, 1, GL_FALSE, Inverse);
+	gl.glUniform4fv(FTintUniform, 1, TintColor);
+	gl.glUniform1i(FRegionsUniform, 0);
+	gl.glActiveTexture(GL_TEXTURE0);
+	// the unit 0 binding, once unit 0 is active
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &Saved.Texture);
+	glBindTexture(GL_TEXTURE_2D, FTexture);
+
+	gl.glBindBuffer(GL_ARRAY_BUFFER, FQuadBuffer);
+	gl.glEnableVertexAttribArray(FCornerAttrib);
+	gl.glVertexAttribPointer(FCornerAttrib, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+	glDisable(GL_DEPTH_TEST);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+	gl.glBlendFuncSeparate(Saved.BlendSrcRGB, Saved.BlendDstRGB,
+		Saved.BlendSrcAlpha, Saved.BlendDstAlpha);
+	if (!Saved.Blend)
+		glDisable(GL_BLEND);
+	if (Saved.DepthTest)
+		glEnable(GL_DEPTH_TEST);
+	if (!Saved.AttribEnabled)
+		gl.glDisableVertexAttribArray(FCornerAttrib);
+	gl.glBindBuffer(GL_ARRAY_BUFFER, Saved.ArrayBuffer);
+	glBindTexture(GL_TEXTURE_2D, Saved.Texture);
+	gl.glActiveTexture(Saved.ActiveTexture);
+	gl.glUseProgram(Saved.Program);
+}
+//---------------------------------------------------------------------------
+void ConstellationRegionRenderer::Release()
+{
+	if (FQuadBuffer)
+		FGL->glDeleteBuffers(1, &FQuadBuffer);
+	if (FTexture)
+		glDeleteTextures(1, &FTexture);
+	if (FProgram)
+		FGL->glDeleteProgram(FProgram);
+	FQuadBuffer = 0;
+	FTexture = 0;
+	FProgram = 0;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,74 @@
+//---------------------------------------------------------------------------
+// Per-fragment constellation region tinting.
+//
+// The congrid.h raster (built with fill_mixed set) goes up once as an 8-bit
+// texture of constellation indices.  Draw() covers the viewport with one
+// quad; the fragment shader turns each pixel back into a sky direction,
+// precesses it into the raster's B1875 frame, fetches the index and tints
+// the pixel if that constellation is in the highlight mask.  Highlighting
+// a region costs a bit flip on the CPU, like ConstellationLineRenderer.
+//
+// Texels are 180/height degrees, so region edges on screen are accurate
+// to half of that; the CPU-side lookups (picking) use the exact
+// constellation_grid_index_at() instead.
+//
+// Needs a current OpenGL 2.1 or compatibility context; entry points are
+// resolved through the GetProcAddress given to Init().
+//---------------------------------------------------------------------------
+
+#ifndef uConstellationRegionsH
+#define uConstellationRegionsH
+
+#include <bitset>
+#include <string>
+
+#include "congrid.h"
+
+//---------------------------------------------------------------------------
+class ConstellationRegionRenderer
+{
+public:
+	typedef void* (*GetProcAddressFunc)(const char* Name);
+
+	ConstellationRegionRenderer();
+	~ConstellationRegionRenderer();
+	ConstellationRegionRenderer(const ConstellationRegionRenderer&) = delete;
+	ConstellationRegionRenderer& operator=(const ConstellationRegionRenderer&) = delete;
+
+	bool Init(GetProcAddressFunc GetProcAddress);
+	// Grid must be built with fill_mixed != 0 (no CONSTELL_IDX_NONE holes).
+	void Upload(const congrid_t& Grid);
+	// Equinox of the scene's coordinates (Julian years); J2000 by default.
+	void SetEpoch(double Year);
+	void SetHighlight(int Constellation, bool On = true);
+	void ClearHighlight();
+	bool Highlighted(int Constellation) const;
+	// ModelViewProjection is the sky's, column-major; only directions
+	// matter, so any camera position works.  TintColor is RGBA and is
+	// blended over highlighted regions.
+	void Draw(const float* ModelViewProjection, const float* TintColor);
+	void Release();
+
+	const char* InfoLog() const { return FInfoLog.c_str(); }
+
+private:
+	struct GLFunctions;
+	GLFunctions* FGL;
+	unsigned FProgram = 0;
+	unsigned FQuadBuffer = 0;
+	unsigned FTexture = 0;
+	int FCornerAttrib = -1;
+	int FInverseUniform = -1;
+	int FToGridUniform = -1;
+	int FRegionsUniform = -1;
+	int FHighlightUniform = -1;
+	int FTintUniform = -1;
+	float FToGrid[9];  // column-major, scene epoch -> B1875
+	bool FToGridChanged = true;
+	std::bitset<N_CONSTELLATIONS> FHighlight;
+	bool FHighlightChanged = true;
+	std::string FInfoLog;
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,167 @@
+//---------------------------------------------------------------------------
+
+#include "uEpochCache.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "precess.h"
+
+//---------------------------------------------------------------------------
+namespace
+{
+const double Pi = 3.14159265358979323846;
+const double MasToRad = Pi / (180. * 3600. * 1000.);
+
+// Moves unit vectors along their tangents by Years, renormalises and
+// rotates by M.  Plain loops over the axis arrays, for the vectoriser.
+void Propagate(const float* M, const float* x0, const float* y0,
+	const float* z0, const float* vx, const float* vy, const float* vz,
+	float Years, float* __restrict x, float* __restrict y, float* __restrict z,
+	size_t Count)
+{
+	for (size_t i = 0; i < Count; i++)
+	{
+		const float px = x0[i] + vx[i] * Years;
+		const float py = y0[i] + vy[i] * Years;
+		const float pz = z0[i] + vz[i] * Years;
+		const float Scale = 1.f / std::sqrt(px * px + py * py + pz * pz);
+		x[i] = (M[0] * px + M[1] * py + M[2] * pz) * Scale;
+		y[i] = (M[3] * px + M[4] * py + M[5] * pz) * Scale;
+		z[i] = (M[6] * px + M[7] * py + M[8] * pz) * Scale;
+	}
+}
+}
+
+//---------------------------------------------------------------------------
+EpochCache::EpochCache(double BucketYears, size_t Capacity)
+	: FBucketYears(std::max(BucketYears, 1e-3)), FCapacity(std::max<size_t>(Capacity, 1))
+{
+	FEntries.reserve(FCapacity);
+}
+//---------------------------------------------------------------------------
+void EpochCache::SetCatalog(const HipCatalog& Catalog)
+{
+	FEntries.clear();
+	const size_t n = Catalog.Count();
+	const std::span<const HipMotion> Motions = Catalog.Motions();
+	for (SkyVectors* v : {&FBase, &FMotion})
+	{
+		v->X.resize(n);
+		v->Y.resize(n);
+		v->Z.resize(n);
+	}
+	for (size_t i = 0; i < n; i++)
+	{
+		const StarRecord& s = Catalog[i].Star;
+		const double RA = s.RA * (Pi / 18000.), Dec = s.DEC * (Pi / 18000.);
+		const double SinRA = std::sin(RA), CosRA = std::cos(RA);
+		const double SinDec = std::sin(Dec), CosDec = std::cos(Dec);
+		FBase.X[i] = static_cast<float>(CosDec * CosRA);
+		FBase.Y[i] = static_cast<float>(CosDec * SinRA);
+		FBase.Z[i] = static_cast<float>(SinDec);
+		// Along the unit vectors east (-sin ra, cos ra, 0) and north
+		// (-sin dec cos ra, -sin dec sin ra, cos dec)
+		const double East = i < Motions.size() ? Motions[i].PMRA * MasToRad : 0;
+		const double North = i < Motions.size() ? Motions[i].PMDec * MasToRad : 0;
+		FMotion.X[i] = static_cast<float>(-East * SinRA - North * SinDec * CosRA);
+		FMotion.Y[i] = static_cast<float>(East * CosRA - North * SinDec * SinRA);
+		FMotion.Z[i] = static_cast<float>(North * CosDec);
+	}
+	FVertexRecord.resize(ConstFigureVertices.size());
+	for (size_t v = 0; v < FVertexRecord.size(); v++)
+		FVertexRecord[v] = Catalog.RecordOfVertex(v);
+}
+//---------------------------------------------------------------------------
+void EpochCache::SetEquinoxOfDate(bool On)
+{
+	if (On != FEquinoxOfDate)
+		FEntries.clear();
+	FEquinoxOfDate = On;
+}
+//---------------------------------------------------------------------------
+double EpochCache::BucketYear(double Year) const
+{
+	Year = std::clamp(Year, MinYear, MaxYear);
+	return std::clamp(std::round(Year / FBucketYears) * FBucketYears, MinYear,
+		MaxYear);
+}
+//---------------------------------------------------------------------------
+EpochCache::Entry& EpochCache::Fetch(double Year)
+{
+	Year = BucketYear(Year);
+	for (Entry& e : FEntries)
+		if (e.Year == Year)
+		{
+			FHits++;
+			e.LastUse = ++FClock;
+			return e;
+		}
+	FMisses++;
+	Entry* Slot;
+	if (FEntries.size() < FCapacity)
+		Slot = &FEntries.emplace_back();
+	else
+		Slot = &*std::min_element(FEntries.begin(), FEntries.end(),
+			[](const Entry& a, const Entry& b) { return a.LastUse < b.LastUse; });
+	Slot->Year = Year;
+	Slot->LastUse = ++FClock;
+	Compute(*Slot);
+	return *Slot;
+}
+//---------------------------------------------------------------------------
+void EpochCache::Compute(Entry& e) const
+{
+	float M[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+	if (FEquinoxOfDate)
+	{
+		double P[9];
+		setup_precession(P, EPOCH_J2000, e.Year);
+		for (int i = 0; i < 9; i++)
+			M[i] = static_cast<float>(P[i]);
+	}
+	const float Years = static_cast<float>(e.Year - 2000.);
+
+	const size_t n = FBase.Count();
+	e.Stars.X.resize(n);
+	e.Stars.Y.resize(n);
+	e.Stars.Z.resize(n);
+	Propagate(M, FBase.X.data(), FBase.Y.data(), FBase.Z.data(),
+		FMotion.X.data(), FMotion.Y.data(), FMotion.Z.data(), Years,
+		e.Stars.X.data(), e.Stars.Y.data(), e.Stars.Z.data(), n);
+
+	// A vertex moves as its star does; it sits up to a few arcminutes off
+	// the catalog position, so carry the vertex rather than snap to the star.
+	const size_t v = FVertexRecord.size();
+	std::vector<float> Start(3 * v), Motion(3 * v, 0.f);
+	for (size_t i = 0; i < v; i++)
+	{
+		Start[i] = ConstFigureVertices[i].x;
+		Start[v + i] = ConstFigureVertices[i].y;
+		Start[2 * v + i] = ConstFigureVertices[i].z;
+		const uint32_t r = FVertexRecord[i];
+		if (r < n)
+		{
+			Motion[i] = FMotion.X[r];
+			Motion[v + i] = FMotion.Y[r];
+			Motion[2 * v + i] = FMotion.Z[r];
+		}
+	}
+	e.Figures.X.resize(v);
+	e.Figures.Y.resize(v);
+	e.Figures.Z.resize(v);
+	Propagate(M, &Start[0], &Start[v], &Start[2 * v], &Motion[0], &Motion[v],
+		&Motion[2 * v], Years, e.Figures.X.data(), e.Figures.Y.data(),
+		e.Figures.Z.data(), v);
+}
+//---------------------------------------------------------------------------
+const SkyVectors& EpochCache::Stars(double Year)
+{
+	return Fetch(Year).Stars;
+}
+//---------------------------------------------------------------------------
+const SkyVectors& EpochCache::FigureVertices(double Year)
+{
+	return Fetch(Year).Figures;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,89 @@
+//---------------------------------------------------------------------------
+// The sky of another era: catalog and figure positions carried to any
+// year from -3000 to +3000 by proper motion, optionally precessed to
+// that year's equinox.
+//
+// The catalog positions are J2000.  Each star is kept as a unit vector
+// plus its proper motion as a tangent vector (radians per year), and
+// moves in a straight line through space: radial velocities and
+// distances are unknown, so the motion is taken as purely transverse.
+// Moving the catalog to a year is then a multiply-add and a normalise per
+// axis array, and precession one 3x3 rotation more.  Both vectorise, and
+// Hipparcos takes about a millisecond.  Years are snapped to buckets of
+// BucketYears (even a fast 10"/yr star shifts only 100" in a decade) and
+// the last Capacity buckets are kept.  Scrubbing an epoch slider back
+// and forth then mostly costs lookups, and nothing is recomputed while
+// the bucket stays the same.
+//
+// Figure vertices (ConstFigureVertices) move with the stars HipCatalog
+// linked them to; unlinked vertices only precess.  Without hip_main.dat
+// the catalog has no proper motions and only precession changes.
+//
+// Leave EquinoxOfDate off when the result goes on to HorizonTransform,
+// which precesses by itself.  The IAU 1976 precession used here drifts
+// by arcminutes at the ends of the range, which is still well under
+// what naked-eye figures need.
+//---------------------------------------------------------------------------
+
+#ifndef uEpochCacheH
+#define uEpochCacheH
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "uHipCatalog.h"
+#include "uHorizon.h"
+
+//---------------------------------------------------------------------------
+class EpochCache
+{
+public:
+	static constexpr double MinYear = -3000;
+	static constexpr double MaxYear = 3000;
+
+	explicit EpochCache(double BucketYears = 10, size_t Capacity = 32);
+
+	// Takes the positions, motions and vertex links; drops everything
+	// cached.
+	void SetCatalog(const HipCatalog& Catalog);
+	// Refer positions to the mean equinox of the year rather than J2000.
+	void SetEquinoxOfDate(bool On);
+	bool EquinoxOfDate() const { return FEquinoxOfDate; }
+
+	// Positions for Year (clamped to the range and snapped to its
+	// bucket), computed on the bucket's first use.  The references stay
+	// valid until the next call that misses.
+	const SkyVectors& Stars(double Year);
+	const SkyVectors& FigureVertices(double Year);
+
+	double BucketYear(double Year) const;
+	size_t Hits() const { return FHits; }
+	size_t Misses() const { return FMisses; }
+
+private:
+	struct Entry
+	{
+		double Year;
+		uint64_t LastUse;
+		SkyVectors Stars;
+		SkyVectors Figures;
+	};
+
+	Entry& Fetch(double Year);
+	void Compute(Entry& e) const;
+
+	double FBucketYears;
+	size_t FCapacity;
+	bool FEquinoxOfDate = false;
+	SkyVectors FBase;                    // J2000 positions
+	SkyVectors FMotion;                  // radians per year
+	std::vector<uint32_t> FVertexRecord; // HipCatalog::RecordOfVertex
+	std::vector<Entry> FEntries;
+	uint64_t FClock = 0;
+	size_t FHits = 0;
+	size_t FMisses = 0;
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,151 @@
+unit uFrameScheduler;
+//--------------------------------------------------
+// Render-on-demand scheduling for the scene viewer
+//--------------------------------------------------
+(*
+  The cadencer ticks continuously, but a frame is only worth drawing when
+  something visible changed: the camera, the selection, the sky time, a
+  running animation or a newly loaded asset.  Callers mark what changed
+  with MarkDirty; the cadencer asks ShouldRender once per tick.  Frames
+  are capped at MaxFrameRate, and after IdleDelay seconds without changes
+  the scheduler reports Idle so the cadencer can sleep between ticks.
+
+  BeginFrame/EndFrame bracket the actual render (the viewer's
+  BeforeRender/AfterRender) to measure what each frame costs.
+*)
+
+interface
+
+uses
+  System.Classes,
+  System.Diagnostics;
+
+type
+  TDirtyReason = (drCamera, drSelection, drTime, drAnimation, drViewport,
+    drAssets);
+  TDirtyReasons = set of TDirtyReason;
+
+  TFrameScheduler = class
+  private
+    FDirty: TDirtyReasons;
+    FMaxFrameRate: Double;
+    FIdleDelay: Double;
+    FLastRenderTime: Double;
+    FLastChangeTime: Double;
+    FClock: TStopwatch; // seconds since Create, for the cap and idle timer
+    FStopwatch: TStopwatch;
+    FLastFrameMs: Double;
+    FAverageFrameMs: Double;
+    FFramesRendered: Int64;
+    FTicksSkipped: Int64;
+    function GetIdle: Boolean;
+    function Now: Double;
+  public
+    constructor Create;
+    procedure MarkDirty(Reason: TDirtyReason);
+    // Call once per cadencer tick; True when a frame should be drawn now.
+    // Dirty state not yet drawn because of the frame cap is kept.
+    function ShouldRender: Boolean;
+    procedure BeginFrame;
+    procedure EndFrame;
+    function StatusText: string;
+    // 0 = no cap
+    property MaxFrameRate: Double read FMaxFrameRate write FMaxFrameRate;
+    // seconds without changes before Idle turns True
+    property IdleDelay: Double read FIdleDelay write FIdleDelay;
+    property Idle: Boolean read GetIdle;
+    property Dirty: TDirtyReasons read FDirty;
+    property LastFrameMs: Double read FLastFrameMs;
+    property AverageFrameMs: Double read FAverageFrameMs;
+    property FramesRendered: Int64 read FFramesRendered;
+    property TicksSkipped: Int64 read FTicksSkipped;
+  end;
+
+//==========================================================================
+implementation
+//==========================================================================
+
+uses
+  System.SysUtils;
+
+constructor TFrameScheduler.Create;
+begin
+  inherited;
+  FMaxFrameRate := 60;
+  FIdleDelay := 2;
+  FLastRenderTime := -1;
+  FDirty := [drViewport]; // draw the first frame
+  FClock := TStopwatch.StartNew;
+end;
+
+//-----------------------------------------------------------------------
+
+function TFrameScheduler.Now: Double;
+begin
+  Result := FClock.Elapsed.TotalSeconds;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TFrameScheduler.MarkDirty(Reason: TDirtyReason);
+begin
+  Include(FDirty, Reason);
+  FLastChangeTime := Now;
+end;
+
+//-----------------------------------------------------------------------
+
+function TFrameScheduler.ShouldRender: Boolean;
+var
+  Time: Double;
+begin
+  Time := Now;
+  Result := (FDirty <> []) and ((FMaxFrameRate <= 0) or (FLastRenderTime < 0) or
+    (Time - FLastRenderTime >= 1 / FMaxFrameRate));
+  if Result then
+  begin
+    FDirty := [];
+    FLastRenderTime := Time;
+  end
+  else
+    Inc(FTicksSkipped);
+end;
+
+//-----------------------------------------------------------------------
+
+function TFrameScheduler.GetIdle: Boolean;
+begin
+  Result := (FDirty = []) and (Now - FLastChangeTime >= FIdleDelay);
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TFrameScheduler.BeginFrame;
+begin
+  FStopwatch := TStopwatch.StartNew;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TFrameScheduler.EndFrame;
+begin
+  FStopwatch.Stop;
+  FLastFrameMs := FStopwatch.Elapsed.TotalMilliseconds;
+  if FFramesRendered = 0 then
+    FAverageFrameMs := FLastFrameMs
+  else // exponential average over roughly the last 30 frames
+    FAverageFrameMs := FAverageFrameMs + (FLastFrameMs - FAverageFrameMs) / 30;
+  Inc(FFramesRendered);
+end;
+
+//-----------------------------------------------------------------------
+
+function TFrameScheduler.StatusText: string;
+const
+  cIdle: array [Boolean] of string = ('', ', idle');
+begin
+  Result := Format('%.2f ms/frame (avg %.2f), %d frames, %d ticks skipped%s',
+    [FLastFrameMs, FAverageFrameMs, FFramesRendered, FTicksSkipped, cIdle[Idle]]);
+end;
+
+end.
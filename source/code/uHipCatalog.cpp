@@ -0,0 +1,591 @@
+//---------------------------------------------------------------------------
+
+#include "uHipCatalog.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+#include "conbound.h"
+#include "uConstFigures.h"
+
+//---------------------------------------------------------------------------
+namespace
+{
+const double Pi = 3.14159265358979323846;
+const double DegToRad = Pi / 180.;
+const char CatalogMagic[4] = {'H', 'I', 'X', '3'};
+
+// Match tolerances.  Records hold positions to 0.01 degree and
+// magnitudes to 0.1, so a Hipparcos entry lands within a cell or two of
+// its record; IAU-CSN and the figure tables are coarser.
+const double HipRadius = 0.02;       // degrees
+const float HipMagnitudeDiff = 0.3f;
+const double NameRadius = 0.1;
+const float NameMagnitudeDiff = 1.f;
+const double VertexRadius = 0.15;
+
+// FNV-1a, to tie a .hipx file to its catalog and sources.
+uint64_t Fnv(uint64_t Hash, const void* Data, size_t Size)
+{
+	const uint8_t* p = static_cast<const uint8_t*>(Data);
+	for (size_t i = 0; i < Size; i++)
+		Hash = (Hash ^ p[i]) * 1099511628211ull;
+	return Hash;
+}
+
+uint64_t HashRecords(std::span<const StarRecord> Stars)
+{
+	return Fnv(14695981039346656037ull, Stars.data(), Stars.size_bytes());
+}
+
+// Size and modification time stand in for the contents: hip_main.dat is
+// 50 MB, too much to hash on every start.
+uint64_t HashSources(const HipCatalogSources& Sources)
+{
+	uint64_t Hash = 14695981039346656037ull;
+	for (const std::string* Name : {&Sources.IauCsn, &Sources.HipMain})
+	{
+		std::error_code Error;
+		int64_t Stamp[2] = {0, 0};
+		if (!Name->empty() && std::filesystem::exists(*Name, Error))
+		{
+			Stamp[0] = static_cast<int64_t>(std::filesystem::file_size(*Name, Error));
+			Stamp[1] = static_cast<int64_t>(std::filesystem::last_write_time(*Name,
+				Error).time_since_epoch().count());
+		}
+		Hash = Fnv(Hash, Stamp, sizeof(Stamp));
+	}
+	return Hash;
+}
+
+// Degrees between two positions in degrees (haversine, good at any size).
+double Separation(double RA1, double Dec1, double RA2, double Dec2)
+{
+	const double a = std::sin(0.5 * (Dec2 - Dec1) * DegToRad);
+	const double b = std::sin(0.5 * (RA2 - RA1) * DegToRad);
+	const double h = a * a + std::cos(Dec1 * DegToRad) * std::cos(Dec2 * DegToRad) * b * b;
+	return 2. * std::asin(std::sqrt(std::min(1., h))) / DegToRad;
+}
+
+//---------------------------------------------------------------------------
+// The records sorted by their own 0.01 degree cells, Dec-major, so the
+// cells of a box around a position are one key range per Dec row.
+class PositionGrid
+{
+public:
+	explicit PositionGrid(std::span<const StarRecord> Stars) : FStars(Stars)
+	{
+		FCells.reserve(Stars.size());
+		for (uint32_t i = 0; i < Stars.size(); i++)
+			FCells.push_back({Key(Stars[i].DEC, Stars[i].RA), i});
+		std::sort(FCells.begin(), FCells.end());
+	}
+
+	// Calls Visit(Record, Separation) for each record within Radius
+	// degrees of (RA, Dec).
+	template <class Visitor>
+	void ForEachNear(double RA, double Dec, double Radius, Visitor Visit) const
+	{
+		const int DecLo = std::max(-9000, static_cast<int>(std::floor((Dec - Radius) * 100.)));
+		const int DecHi = std::min(9000, static_cast<int>(std::ceil((Dec + Radius) * 100.)));
+		const double CosDec = std::cos(std::min(89.9, std::fabs(Dec) + Radius) * DegToRad);
+		const int Span = static_cast<int>(std::ceil(Radius * 100. / CosDec)) + 1;
+		const int Cell = static_cast<int>(std::floor(RA * 100.));
+		for (int d = DecLo; d <= DecHi; d++)
+		{
+			if (2 * Span + 1 >= 36000)
+			{
+				Scan(d, 0, 35999, RA, Dec, Radius, Visit);
+				continue;
+			}
+			int Lo = Cell - Span, Hi = Cell + Span;
+			if (Lo < 0)
+			{
+				Scan(d, Lo + 36000, 35999, RA, Dec, Radius, Visit);
+				Lo = 0;
+			}
+			if (Hi > 35999)
+			{
+				Scan(d, 0, Hi - 36000, RA, Dec, Radius, Visit);
+				Hi = 35999;
+			}
+			Scan(d, Lo, Hi, RA, Dec, Radius, Visit);
+		}
+	}
+
+private:
+	static uint32_t Key(int Dec, int RA)
+	{
+		return static_cast<uint32_t>(Dec + 9000) * 36000u + static_cast<uint32_t>(RA);
+	}
+
+	template <class Visitor>
+	void Scan(int Dec, int RALo, int RAHi, double RA, double DecDeg,
+		double Radius, Visitor& Visit) const
+	{
+		auto i = std::lower_bound(FCells.begin(), FCells.end(),
+			std::make_pair(Key(Dec, RALo), 0u));
+		const uint32_t Last = Key(Dec, RAHi);
+		for (; i != FCells.end() && i->first <= Last; ++i)
+		{
+			const StarRecord& s = FStars[i->second];
+			const double d = Separation(RA, DecDeg, s.RADegrees(), s.DecDegrees());
+			if (d <= Radius)
+				Visit(i->second, d);
+		}
+	}
+
+	std::span<const StarRecord> FStars;
+	std::vector<std::pair<uint32_t, uint32_t>> FCells;
+};
+
+//---------------------------------------------------------------------------
+struct CatalogEntry
+{
+	uint32_t HIP;
+	double RA, Dec;         // degrees, at epoch J2000
+	float Magnitude;        // NAN if unknown
+	HipMotion Motion;       // hip_main.dat only
+	float Parallax;         // mas, hip_main.dat only
+	std::string Name;       // IAU-CSN only
+};
+
+float ParseMagnitude(const std::string& Field)
+{
+	char* End;
+	const float m = std::strtof(Field.c_str(), &End);
+	return End == Field.c_str() ? NAN : m;
+}
+
+std::string Trim(const std::string& s)
+{
+	const size_t First = s.find_first_not_of(' ');
+	if (First == std::string::npos)
+		return std::string();
+	return s.substr(First, s.find_last_not_of(" \r\n") - First + 1);
+}
+
+// hip_main.dat: '|' separated, field H1 the HIP number, H5 Vmag, H8/H9
+// RA/Dec in degrees (ICRS, epoch J1991.25), H11 the parallax and H12/H13
+// the proper motion (mas/yr, in RA already times cos Dec).  Positions are
+// carried forward by the proper motion to J2000, the epoch of the .stars
+// records they are matched against; fast stars are otherwise left 8.75
+// years of motion away (Barnard's star 90").
+// Entries without an astrometric solution have no position and are
+// skipped.
+void ReadHipMain(const std::string& FileName, std::vector<CatalogEntry>& Out)
+{
+	FILE* File = std::fopen(FileName.c_str(), "r");
+	if (!File)
+		return;
+	char Line[1024];
+	std::vector<std::string> Fields;
+	while (std::fgets(Line, sizeof(Line), File))
+	{
+		Fields.clear();
+		for (const char* p = Line;;)
+		{
+			const char* Bar = std::strchr(p, '|');
+			Fields.push_back(Trim(Bar ? std::string(p, Bar) : std::string(p)));
+			if (!Bar || Fields.size() > 13)
+				break;
+			p = Bar + 1;
+		}
+		if (Fields.size() < 10 || Fields[8].empty() || Fields[9].empty())
+			continue;
+		CatalogEntry e;
+		e.HIP = static_cast<uint32_t>(std::strtoul(Fields[1].c_str(), nullptr, 10));
+		e.RA = std::atof(Fields[8].c_str());
+		e.Dec = std::atof(Fields[9].c_str());
+		e.Magnitude = ParseMagnitude(Fields[5]);
+		e.Motion = {0.f, 0.f};
+		e.Parallax = Fields.size() > 11 ? std::strtof(Fields[11].c_str(), nullptr) : 0.f;
+		if (Fields.size() > 13)
+			e.Motion = {std::strtof(Fields[12].c_str(), nullptr),
+				std::strtof(Fields[13].c_str(), nullptr)};
+		const double Years = 2000. - 1991.25, MasToDeg = 1. / 3.6e6;
+		const double CosDec = std::cos(e.Dec * DegToRad);
+		if (CosDec > 1e-9)
+			e.RA += e.Motion.PMRA * Years * MasToDeg / CosDec;
+		e.Dec += e.Motion.PMDec * Years * MasToDeg;
+		e.RA = std::fmod(e.RA + 360., 360.);
+		if (e.HIP > 0)
+			Out.push_back(e);
+	}
+	std::fclose(File);
+}
+
+// IAU-CSN.txt columns are fixed in characters, and the name and Greek
+// letter columns hold UTF-8, so offsets are counted in code points.
+std::string CsnField(const std::string& Line, size_t Start, size_t Width)
+{
+	size_t Byte = 0, Char = 0, First = std::string::npos;
+	for (; Byte < Line.size(); Byte++)
+		if ((static_cast<uint8_t>(Line[Byte]) & 0xc0) != 0x80)
+		{
+			if (Char == Start)
+				First = Byte;
+			if (Char == Start + Width)
+				break;
+			Char++;
+		}
+	if (First == std::string::npos)
+		return std::string();
+	const std::string Field = Trim(Line.substr(First, Byte - First));
+	return Field == "_" ? std::string() : Field;
+}
+
+void ReadIauCsn(const std::string& FileName, std::vector<CatalogEntry>& Out)
+{
+	FILE* File = std::fopen(FileName.c_str(), "r");
+	if (!File)
+		return;
+	char Line[1024];
+	while (std::fgets(Line, sizeof(Line), File))
+	{
+		const std::string s(Line);
+		if (s.empty() || s[0] == '#')
+			continue;
+		const std::string RA = CsnField(s, 104, 11), Dec = CsnField(s, 115, 11);
+		char* End;
+		CatalogEntry e;
+		e.Motion = {0.f, 0.f};
+		e.Parallax = 0.f;
+		e.RA = std::strtod(RA.c_str(), &End);
+		if (RA.empty() || *End)
+			continue;  // header or notes
+		e.Dec = std::strtod(Dec.c_str(), &End);
+		if (Dec.empty() || *End)
+			continue;
+		e.Name = CsnField(s, 18, 18);
+		e.HIP = static_cast<uint32_t>(std::strtoul(CsnField(s, 90, 7).c_str(), nullptr, 10));
+		e.Magnitude = ParseMagnitude(CsnField(s, 81, 6));
+		Out.push_back(e);
+	}
+	std::fclose(File);
+}
+
+bool SameAbbreviation(const char* a, const char* b)
+{
+	for (; *a && *b; a++, b++)
+		if (std::tolower(static_cast<unsigned char>(*a))
+			!= std::tolower(static_cast<unsigned char>(*b)))
+			return false;
+	return *a == *b;
+}
+} // namespace
+
+//---------------------------------------------------------------------------
+void HipCatalog::Build(std::span<const StarRecord> Stars,
+	const HipCatalogSources& Sources)
+{
+	FCatalogHash = HashRecords(Stars);
+	FSourceHash = HashSources(Sources);
+	FRecords.assign(Stars.size(), HipStarRecord());
+	for (size_t i = 0; i < Stars.size(); i++)
+	{
+		HipStarRecord& r = FRecords[i];
+		r.Star = Stars[i];
+		r.Constellation = CONSTELL_IDX_NONE;
+		r.Figure = NoFigure;
+		r.HIP = 0;
+		r.Name = -1;
+		r.FigureVertex = -1;
+	}
+	FMotions.assign(Stars.size(), HipMotion{0.f, 0.f});
+	FParallaxes.assign(Stars.size(), 0.f);
+	FRecordOfHip.assign(1, NoRecord);
+	FRecordOfVertex.assign(ConstFigureVertices.size(), NoRecord);
+	FNameOffsets.assign(1, 0);
+	FNames.clear();
+
+	auto SetHip = [this](uint32_t Record, uint32_t HIP)
+	{
+		if (HIP >= FRecordOfHip.size())
+			FRecordOfHip.resize(HIP + 1, NoRecord);
+		FRecordOfHip[HIP] = Record;
+		FRecords[Record].HIP = HIP;
+	};
+	// Records can't hold negative magnitudes; those stars are stored as 0.
+	auto MagnitudeDiff = [&Stars](uint32_t Record, float Magnitude)
+	{
+		return std::isnan(Magnitude) ? 0.f
+			: std::fabs(Stars[Record].Magnitude() - std::max(Magnitude, 0.f));
+	};
+	const PositionGrid Grid(Stars);
+
+	// Constellations, in one batch
+	{
+		std::vector<float> RA(Stars.size()), Dec(Stars.size());
+		std::vector<uint8_t> Index(Stars.size());
+		for (size_t i = 0; i < Stars.size(); i++)
+		{
+			RA[i] = Stars[i].RADegrees();
+			Dec[i] = Stars[i].DecDegrees();
+		}
+		constellation_classify_j2000(RA.data(), Dec.data(), Index.data(), Stars.size());
+		for (size_t i = 0; i < Stars.size(); i++)
+			FRecords[i].Constellation = Index[i];
+	}
+
+	// HIP numbers: every close enough pair is a candidate, and the best
+	// pairs are taken first so each record and HIP number is used once.
+	std::vector<CatalogEntry> Entries;
+	if (!Sources.HipMain.empty())
+		ReadHipMain(Sources.HipMain, Entries);
+	{
+		struct Candidate
+		{
+			float Score;
+			uint32_t Entry, Record;
+		};
+		std::vector<Candidate> Candidates;
+		for (uint32_t e = 0; e < Entries.size(); e++)
+			Grid.ForEachNear(Entries[e].RA, Entries[e].Dec, HipRadius,
+				[&](uint32_t Record, double Distance)
+				{
+					const float dm = MagnitudeDiff(Record, Entries[e].Magnitude);
+					if (dm <= HipMagnitudeDiff)
+						Candidates.push_back({static_cast<float>(Distance / HipRadius)
+							+ dm / HipMagnitudeDiff, e, Record});
+				});
+		std::sort(Candidates.begin(), Candidates.end(),
+			[](const Candidate& a, const Candidate& b) { return a.Score < b.Score; });
+		std::vector<bool> Taken(Entries.size());
+		for (const Candidate& c : Candidates)
+			if (!Taken[c.Entry] && FRecords[c.Record].HIP == 0
+				&& RecordOfHip(Entries[c.Entry].HIP) == NoRecord)
+			{
+				Taken[c.Entry] = true;
+				SetHip(c.Record, Entries[c.Entry].HIP);
+				FMotions[c.Record] = Entries[c.Entry].Motion;
+				FParallaxes[c.Record] = Entries[c.Entry].Parallax;
+			}
+	}
+
+	// Names, by HIP number where that's matched and by position otherwise;
+	// the position match also gives named stars their HIP numbers when
+	// there's no hip_main.dat.
+	Entries.clear();
+	if (!Sources.IauCsn.empty())
+		ReadIauCsn(Sources.IauCsn, Entries);
+	for (const CatalogEntry& e : Entries)
+	{
+		uint32_t Record = RecordOfHip(e.HIP);
+		if (Record == NoRecord)
+		{
+			float Best = 1e30f;
+			Grid.ForEachNear(e.RA, e.Dec, NameRadius,
+				[&](uint32_t r, double Distance)
+				{
+					const float dm = MagnitudeDiff(r, e.Magnitude);
+					const float Score = static_cast<float>(Distance / NameRadius)
+						+ dm / NameMagnitudeDiff;
+					if (dm <= NameMagnitudeDiff && Score < Best)
+					{
+						Best = Score;
+						Record = r;
+					}
+				});
+			if (Record == NoRecord)
+				continue;  // fainter than the catalog, or not a star
+			if (e.HIP > 0 && FRecords[Record].HIP == 0 && RecordOfHip(e.HIP) == NoRecord)
+				SetHip(Record, e.HIP);
+		}
+		if (FRecords[Record].Name >= 0 || FNameOffsets.size() > 0x7fff)
+			continue;
+		FRecords[Record].Name = static_cast<int16_t>(FNameOffsets.size() - 1);
+		FNames += e.Name;
+		FNameOffsets.push_back(static_cast<uint32_t>(FNames.size()));
+	}
+
+	// Figure vertices: the brightest record near each.  A star shared by
+	// two figures belongs to the one of the constellation it lies in.
+	for (size_t v = 0; v < ConstFigureVertices.size(); v++)
+	{
+		size_t First = 0;
+		while (ConstFigureRecordVertex[First] != v)
+			First++;
+		const ConstFigureRecord& Source = ConstFigureRecords[First];
+		uint32_t Record = NoRecord;
+		Grid.ForEachNear(Source.RA * 0.015, Source.Dec * 0.01, VertexRadius,
+			[&](uint32_t r, double)
+			{
+				if (Record == NoRecord || Stars[r].VMagnitude < Stars[Record].VMagnitude)
+					Record = r;
+			});
+		if (Record == NoRecord)
+			continue;
+		FRecordOfVertex[v] = Record;
+		HipStarRecord& r = FRecords[Record];
+		if (r.FigureVertex >= 0)
+			continue;
+		r.FigureVertex = static_cast<int16_t>(v);
+		for (size_t i = First; i < ConstFigureRecordVertex.size(); i++)
+			if (ConstFigureRecordVertex[i] == v
+				&& (r.Figure == NoFigure || SameAbbreviation(
+					ConstFigureNames[ConstFigureRecords[i].Figure],
+					constellation_name(r.Constellation))))
+				r.Figure = ConstFigureRecords[i].Figure;
+	}
+	CountLinks();
+}
+//---------------------------------------------------------------------------
+void HipCatalog::CountLinks()
+{
+	FIdentified = FNamed = FLinkedVertices = FMoving = 0;
+	for (const HipStarRecord& r : FRecords)
+	{
+		FIdentified += (r.HIP != 0);
+		FNamed += (r.Name >= 0);
+	}
+	for (uint32_t Record : FRecordOfVertex)
+		FLinkedVertices += (Record != NoRecord);
+	for (const HipMotion& m : FMotions)
+		FMoving += (m.PMRA != 0 || m.PMDec != 0);
+}
+//---------------------------------------------------------------------------
+std::string_view HipCatalog::Name(size_t Record) const
+{
+	const int n = FRecords[Record].Name;
+	if (n < 0)
+		return std::string_view();
+	return std::string_view(FNames).substr(FNameOffsets[n],
+		FNameOffsets[n + 1] - FNameOffsets[n]);
+}
+//---------------------------------------------------------------------------
+const char* HipCatalog::ConstellationName(size_t Record) const
+{
+	return constellation_name(FRecords[Record].Constellation);
+}
+//---------------------------------------------------------------------------
+const char* HipCatalog::FigureName(size_t Record) const
+{
+	const uint8_t f = FRecords[Record].Figure;
+	return f < ConstFigureCount ? ConstFigureNames[f] : "???";
+}
+//---------------------------------------------------------------------------
+bool HipCatalog::Save(const std::string& FileName) const
+{
+	FILE* File = std::fopen(FileName.c_str(), "wb");
+	if (!File)
+		return false;
+
+	HipCatalogHeader Header;
+	std::memcpy(Header.Magic, CatalogMagic, sizeof(Header.Magic));
+	Header.RecordSize = sizeof(HipStarRecord);
+	Header.RecordCount = static_cast<uint32_t>(FRecords.size());
+	Header.MaxHip = static_cast<uint32_t>(FRecordOfHip.size() - 1);
+	Header.VertexCount = static_cast<uint32_t>(FRecordOfVertex.size());
+	Header.NameCount = static_cast<uint32_t>(FNameOffsets.size() - 1);
+	Header.NameBytes = static_cast<uint32_t>(FNames.size());
+	Header.Reserved = 0;
+	Header.CatalogHash = FCatalogHash;
+	Header.SourceHash = FSourceHash;
+
+	bool Ok = std::fwrite(&Header, sizeof(Header), 1, File) == 1
+		&& std::fwrite(FRecords.data(), sizeof(HipStarRecord), FRecords.size(), File)
+			== FRecords.size()
+		&& std::fwrite(FRecordOfHip.data(), sizeof(uint32_t), FRecordOfHip.size(), File)
+			== FRecordOfHip.size()
+		&& std::fwrite(FRecordOfVertex.data(), sizeof(uint32_t),
+			FRecordOfVertex.size(), File) == FRecordOfVertex.size()
+		&& std::fwrite(FNameOffsets.data(), sizeof(uint32_t), FNameOffsets.size(), File)
+			== FNameOffsets.size()
+		&& std::fwrite(FNames.data(), 1, FNames.size(), File) == FNames.size()
+		&& std::fwrite(FMotions.data(), sizeof(HipMotion), FMotions.size(), File)
+			== FMotions.size()
+		&& std::fwrite(FParallaxes.data(), sizeof(float), FParallaxes.size(), File)
+			== FParallaxes.size();
+	Ok = (std::fclose(File) == 0) && Ok;
+	return Ok;
+}
+//---------------------------------------------------------------------------
+bool HipCatalog::Load(const std::string& FileName,
+	std::span<const StarRecord> Stars, const HipCatalogSources& Sources)
+{
+	FILE* File = std::fopen(FileName.c_str(), "rb");
+	if (!File)
+		return false;
+
+	HipCatalogHeader Header;
+	std::vector<HipStarRecord> Records;
+	std::vector<HipMotion> Motions;
+	std::vector<float> Parallaxes;
+	std::vector<uint32_t> RecordOfHip, RecordOfVertex, NameOffsets;
+	std::string Names;
+	bool Ok = std::fread(&Header, sizeof(Header), 1, File) == 1
+		&& !std::memcmp(Header.Magic, CatalogMagic, sizeof(Header.Magic))
+		&& Header.RecordSize == sizeof(HipStarRecord)
+		&& Header.RecordCount == Stars.size()
+		&& Header.MaxHip < 0x1000000  // Hipparcos stops at 120416
+		&& Header.VertexCount == ConstFigureVertices.size()
+		&& Header.NameCount <= 0x7fff
+		&& Header.CatalogHash == HashRecords(Stars)
+		&& Header.SourceHash == HashSources(Sources);
+	if (Ok)
+	{
+		Records.resize(Header.RecordCount);
+		RecordOfHip.resize(Header.MaxHip + 1);
+		RecordOfVertex.resize(Header.VertexCount);
+		NameOffsets.resize(Header.NameCount + 1);
+		Names.resize(Header.NameBytes);
+		Motions.resize(Header.RecordCount);
+		Parallaxes.resize(Header.RecordCount);
+		Ok = std::fread(Records.data(), sizeof(HipStarRecord), Records.size(), File)
+				== Records.size()
+			&& std::fread(RecordOfHip.data(), sizeof(uint32_t), RecordOfHip.size(), File)
+				== RecordOfHip.size()
+			&& std::fread(RecordOfVertex.data(), sizeof(uint32_t),
+				RecordOfVertex.size(), File) == RecordOfVertex.size()
+			&& std::fread(NameOffsets.data(), sizeof(uint32_t), NameOffsets.size(), File)
+				== NameOffsets.size()
+			&& std::fread(Names.data(), 1, Names.size(), File) == Names.size()
+			&& std::fread(Motions.data(), sizeof(HipMotion), Motions.size(), File)
+				== Motions.size()
+			&& std::fread(Parallaxes.data(), sizeof(float), Parallaxes.size(), File)
+				== Parallaxes.size();
+	}
+	std::fclose(File);
+
+	// Everything that's used as an index has to be in range.
+	for (size_t i = 0; Ok && i < RecordOfHip.size(); i++)
+		Ok = RecordOfHip[i] == NoRecord || RecordOfHip[i] < Records.size();
+	for (size_t i = 0; Ok && i < RecordOfVertex.size(); i++)
+		Ok = RecordOfVertex[i] == NoRecord || RecordOfVertex[i] < Records.size();
+	for (size_t i = 0; Ok && i < Header.NameCount; i++)
+		Ok = NameOffsets[i] <= NameOffsets[i + 1];
+	Ok = Ok && NameOffsets.front() == 0 && NameOffsets.back() == Names.size();
+	for (size_t i = 0; Ok && i < Records.size(); i++)
+		Ok = Records[i].Name < static_cast<int>(Header.NameCount)
+			&& Records[i].FigureVertex < static_cast<int>(Header.VertexCount)
+			&& Records[i].HIP <= Header.MaxHip;
+	if (!Ok)
+		return false;
+
+	FRecords = std::move(Records);
+	FMotions = std::move(Motions);
+	FParallaxes = std::move(Parallaxes);
+	FRecordOfHip = std::move(RecordOfHip);
+	FRecordOfVertex = std::move(RecordOfVertex);
+	FNameOffsets = std::move(NameOffsets);
+	FNames = std::move(Names);
+	FCatalogHash = Header.CatalogHash;
+	FSourceHash = Header.SourceHash;
+	CountLinks();
+	return true;
+}
+//---------------------------------------------------------------------------
+void HipCatalog::LoadOrBuild(const std::string& FileName,
+	std::span<const StarRecord> Stars, const HipCatalogSources& Sources)
+{
+	if (Load(FileName, Stars, Sources))
+		return;
+	Build(Stars, Sources);
+	Save(FileName);
+}
@@ -0,0 +1,150 @@
+//---------------------------------------------------------------------------
+// Extended star catalog: the records of a .stars file plus HIP numbers,
+// IAU names, constellations and links to the constellation figures.
+//
+// A GLScene .stars file (see uStarCatalog.h) has no identifiers, so
+// joining it with IAU-CSN.txt or the figure vertices of uConstFigures.h
+// means matching positions.  HipCatalog::Build() does that matching once,
+// against the Hipparcos main catalogue (CDS I/239 hip_main.dat) when
+// there is one and the IAU-CSN positions otherwise, and the .hipx file
+// keeps the result.  hip_main.dat is not in the tree (README.md says where
+// to get it); without it the motions and parallaxes are all zero.  The
+// file is laid out as:
+//
+//   HipCatalogHeader
+//   HipStarRecord[RecordCount]    same order as the .stars records
+//   uint32_t[MaxHip + 1]          record of each HIP number
+//   uint32_t[VertexCount]         record of each ConstFigureVertices entry
+//   uint32_t[NameCount + 1]       offsets into the name bytes
+//   char[NameBytes]               IAU names, UTF-8
+//   HipMotion[RecordCount]        proper motions, zero where unknown
+//   float[RecordCount]            parallaxes in mas, zero where unknown
+//
+// After that, resolving a picked star (a record index from SkyIndex or
+// StarField) to its HIP number, name, constellation and figure, or a HIP
+// number or figure vertex to its record, is an array lookup.
+//---------------------------------------------------------------------------
+
+#ifndef uHipCatalogH
+#define uHipCatalogH
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "uStarCatalog.h"
+
+//---------------------------------------------------------------------------
+#pragma pack(push, 1)
+struct HipStarRecord
+{
+	StarRecord Star;
+	uint8_t Constellation;  // boundary it lies in, 0..87 as conbound.h
+	uint8_t Figure;         // index into ConstFigureNames, 0xff = none
+	uint32_t HIP;           // 0 = not identified
+	int16_t Name;           // into the name table, -1 = none
+	int16_t FigureVertex;   // into ConstFigureVertices, -1 = none
+};
+#pragma pack(pop)
+
+static_assert(sizeof(HipStarRecord) == 16, "extended records must stay 16 bytes");
+
+// Hipparcos proper motion in mas/yr; PMRA is along the sky, i.e. already
+// multiplied by cos Dec.  Only hip_main.dat has these.
+struct HipMotion
+{
+	float PMRA;
+	float PMDec;
+};
+
+struct HipCatalogHeader
+{
+	char Magic[4];          // "HIX3"
+	uint32_t RecordSize;    // sizeof(HipStarRecord)
+	uint32_t RecordCount;
+	uint32_t MaxHip;
+	uint32_t VertexCount;
+	uint32_t NameCount;
+	uint32_t NameBytes;
+	uint32_t Reserved;
+	uint64_t CatalogHash;   // of the .stars records
+	uint64_t SourceHash;    // of the text catalogues' sizes and times
+};
+
+//---------------------------------------------------------------------------
+// Text catalogues to match against; either may be empty or missing.
+struct HipCatalogSources
+{
+	std::string IauCsn;     // data/star/IAU-CSN.txt
+	std::string HipMain;    // hip_main.dat from CDS I/239
+};
+
+//---------------------------------------------------------------------------
+class HipCatalog
+{
+public:
+	static constexpr uint32_t NoRecord = 0xffffffffu;
+	static constexpr uint8_t NoFigure = 0xff;
+
+	void Build(std::span<const StarRecord> Stars,
+		const HipCatalogSources& Sources);
+
+	// Load() refuses a file built from another catalog or other sources;
+	// LoadOrBuild() then builds and tries to Save().
+	bool Save(const std::string& FileName) const;
+	bool Load(const std::string& FileName, std::span<const StarRecord> Stars,
+		const HipCatalogSources& Sources);
+	void LoadOrBuild(const std::string& FileName,
+		std::span<const StarRecord> Stars, const HipCatalogSources& Sources);
+
+	std::span<const HipStarRecord> Records() const { return FRecords; }
+	const HipStarRecord& operator[](size_t Record) const
+	{
+		return FRecords[Record];
+	}
+	size_t Count() const { return FRecords.size(); }
+	std::span<const HipMotion> Motions() const { return FMotions; }
+	std::span<const float> Parallaxes() const { return FParallaxes; }
+
+	uint32_t RecordOfHip(uint32_t HIP) const
+	{
+		return HIP < FRecordOfHip.size() ? FRecordOfHip[HIP] : NoRecord;
+	}
+	uint32_t RecordOfVertex(size_t Vertex) const
+	{
+		return Vertex < FRecordOfVertex.size() ? FRecordOfVertex[Vertex]
+			: NoRecord;
+	}
+	// Empty for stars without an IAU name.
+	std::string_view Name(size_t Record) const;
+	// IAU abbreviations, "???" if unknown.
+	const char* ConstellationName(size_t Record) const;
+	const char* FigureName(size_t Record) const;
+
+	size_t IdentifiedCount() const { return FIdentified; }
+	size_t NamedCount() const { return FNamed; }
+	size_t LinkedVertexCount() const { return FLinkedVertices; }
+	size_t MovingCount() const { return FMoving; }
+
+private:
+	void CountLinks();
+
+	std::vector<HipStarRecord> FRecords;
+	std::vector<HipMotion> FMotions;
+	std::vector<float> FParallaxes;
+	std::vector<uint32_t> FRecordOfHip;
+	std::vector<uint32_t> FRecordOfVertex;
+	std::vector<uint32_t> FNameOffsets;
+	std::string FNames;
+	uint64_t FCatalogHash = 0;
+	uint64_t FSourceHash = 0;
+	size_t FIdentified = 0;
+	size_t FNamed = 0;
+	size_t FLinkedVertices = 0;
+	size_t FMoving = 0;
+};
+
+//---------------------------------------------------------------------------
+#endif
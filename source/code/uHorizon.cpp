@@ -0,0 +1,293 @@
+//---------------------------------------------------------------------------
+
+#include "uHorizon.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "precess.h"
+
+//---------------------------------------------------------------------------
+namespace
+{
+const double Pi = 3.14159265358979323846;
+const double J2000 = 2451545.0;
+
+// Points per unit of work handed to a thread; a few blocks per thread for
+// Hipparcos, small enough that the block's arrays stay in L1.
+const size_t BlockSize = 4096;
+
+void RotateBlock(const float* M, const float* __restrict x,
+	const float* __restrict y, const float* __restrict z,
+	float* __restrict e, float* __restrict n, float* __restrict u, size_t Count)
+{
+	const float m0 = M[0], m1 = M[1], m2 = M[2];
+	const float m3 = M[3], m4 = M[4], m5 = M[5];
+	const float m6 = M[6], m7 = M[7], m8 = M[8];
+	for (size_t i = 0; i < Count; i++)
+	{
+		e[i] = m0 * x[i] + m1 * y[i] + m2 * z[i];
+		n[i] = m3 * x[i] + m4 * y[i] + m5 * z[i];
+		u[i] = m6 * x[i] + m7 * y[i] + m8 * z[i];
+	}
+}
+
+// Writes the indices of points at or above MinUp; branch-free, so it
+// costs the same whatever the horizon cuts.
+size_t CullBlock(const float* u, float MinUp, uint32_t First, uint32_t* Out,
+	size_t Count)
+{
+	size_t k = 0;
+	for (size_t i = 0; i < Count; i++)
+	{
+		Out[k] = First + static_cast<uint32_t>(i);
+		k += u[i] >= MinUp;
+	}
+	return k;
+}
+}
+
+//---------------------------------------------------------------------------
+// Helpers that sleep until Run() hands them a job.  The calling thread
+// works too, so a pool of N - 1 helpers keeps N cores busy.
+struct HorizonTransform::Pool
+{
+	std::vector<std::thread> Threads;
+	std::mutex Lock;
+	std::condition_variable Start;
+	std::condition_variable Done;
+	const std::function<void()>* Job = nullptr;
+	uint64_t Generation = 0;
+	unsigned Running = 0;
+	bool Quit = false;
+
+	explicit Pool(unsigned Helpers)
+	{
+		for (unsigned i = 0; i < Helpers; i++)
+			Threads.emplace_back([this] { Loop(); });
+	}
+	~Pool()
+	{
+		{
+			std::lock_guard<std::mutex> Guard(Lock);
+			Quit = true;
+		}
+		Start.notify_all();
+		for (std::thread& t : Threads)
+			t.join();
+	}
+	void Loop()
+	{
+		uint64_t Seen = 0;
+		std::unique_lock<std::mutex> Guard(Lock);
+		for (;;)
+		{
+			Start.wait(Guard, [&] { return Quit || Generation != Seen; });
+			if (Quit)
+				return;
+			Seen = Generation;
+			const std::function<void()>* Work = Job;
+			Guard.unlock();
+			(*Work)();
+			Guard.lock();
+			if (--Running == 0)
+				Done.notify_one();
+		}
+	}
+	void Run(const std::function<void()>& Work)
+	{
+		{
+			std::lock_guard<std::mutex> Guard(Lock);
+			Job = &Work;
+			Running = static_cast<unsigned>(Threads.size());
+			Generation++;
+		}
+		Start.notify_all();
+		Work();
+		std::unique_lock<std::mutex> Guard(Lock);
+		Done.wait(Guard, [&] { return Running == 0; });
+	}
+};
+
+//---------------------------------------------------------------------------
+void MakeSkyVectors(const StarArrays& Stars, SkyVectors& Out)
+{
+	const size_t n = Stars.Count();
+	Out.X.resize(n);
+	Out.Y.resize(n);
+	Out.Z.resize(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		const float CosDec = std::cos(Stars.Dec[i]);
+		Out.X[i] = CosDec * std::cos(Stars.RA[i]);
+		Out.Y[i] = CosDec * std::sin(Stars.RA[i]);
+		Out.Z[i] = std::sin(Stars.Dec[i]);
+	}
+}
+//---------------------------------------------------------------------------
+void MakeSkyVectors(std::span<const ConstFigureVertex> Vertices,
+	SkyVectors& Out)
+{
+	Out.X.resize(Vertices.size());
+	Out.Y.resize(Vertices.size());
+	Out.Z.resize(Vertices.size());
+	for (size_t i = 0; i < Vertices.size(); i++)
+	{
+		Out.X[i] = Vertices[i].x;
+		Out.Y[i] = Vertices[i].y;
+		Out.Z[i] = Vertices[i].z;
+	}
+}
+//---------------------------------------------------------------------------
+double JulianDate(int Year, int Month, int Day, double Hours)
+{
+	// Meeus, Astronomical Algorithms, ch. 7
+	if (Month <= 2)
+	{
+		Year--;
+		Month += 12;
+	}
+	int B = 0;
+	if (Year > 1582 || (Year == 1582 && (Month > 10 || (Month == 10 && Day >= 15))))
+	{
+		const int A = static_cast<int>(std::floor(Year / 100.));
+		B = 2 - A + static_cast<int>(std::floor(A / 4.));
+	}
+	return std::floor(365.25 * (Year + 4716)) + std::floor(30.6001 * (Month + 1))
+		+ Day + B - 1524.5 + Hours / 24.;
+}
+//---------------------------------------------------------------------------
+double GreenwichSiderealTime(double JD)
+{
+	// IAU 1982, Meeus (12.4); degrees
+	const double d = JD - J2000;
+	const double T = d / 36525.;
+	double Degrees = 280.46061837 + 360.98564736629 * d
+		+ T * T * (0.000387933 - T / 38710000.);
+	Degrees = std::fmod(Degrees, 360.);
+	if (Degrees < 0)
+		Degrees += 360.;
+	return Degrees * (Pi / 180.);
+}
+
+//---------------------------------------------------------------------------
+HorizonTransform::HorizonTransform(unsigned ThreadCount)
+{
+	if (ThreadCount == 0)
+		ThreadCount = std::max(1u, std::thread::hardware_concurrency());
+	FPool = new Pool(ThreadCount - 1);
+	UpdateMatrix();
+}
+//---------------------------------------------------------------------------
+HorizonTransform::~HorizonTransform()
+{
+	delete FPool;
+}
+//---------------------------------------------------------------------------
+unsigned HorizonTransform::ThreadCount() const
+{
+	return static_cast<unsigned>(FPool->Threads.size()) + 1;
+}
+//---------------------------------------------------------------------------
+void HorizonTransform::SetObserver(double Latitude, double Longitude)
+{
+	FLatitude = Latitude * (Pi / 180.);
+	FLongitude = Longitude * (Pi / 180.);
+	UpdateMatrix();
+}
+//---------------------------------------------------------------------------
+void HorizonTransform::SetTime(double JD)
+{
+	FJD = JD;
+	UpdateMatrix();
+}
+//---------------------------------------------------------------------------
+void HorizonTransform::SetMinAltitude(double Altitude)
+{
+	FMinUp = static_cast<float>(std::sin(Altitude));
+}
+//---------------------------------------------------------------------------
+void HorizonTransform::UpdateMatrix()
+{
+	// Precession to the equinox of date; the IAU 1976 angles hold up for a
+	// few thousand years either side of J2000.
+	double P[9];
+	setup_precession(P, EPOCH_J2000, 2000. + (FJD - J2000) / 365.25);
+
+	// Turn about the pole so x points at the meridian (hour angle 0),
+	// then tip by the latitude:
+	//   East  = -cos dec sin H
+	//   North =  cos lat sin dec - sin lat cos dec cos H
+	//   Up    =  sin lat sin dec + cos lat cos dec cos H
+	FLocalSiderealTime = std::fmod(GreenwichSiderealTime(FJD) + FLongitude
+		+ 2 * Pi, 2 * Pi);
+	const double CosL = std::cos(FLocalSiderealTime);
+	const double SinL = std::sin(FLocalSiderealTime);
+	const double CosLat = std::cos(FLatitude), SinLat = std::sin(FLatitude);
+	const double H[9] = {
+		-SinL, CosL, 0,
+		-SinLat * CosL, -SinLat * SinL, CosLat,
+		CosLat * CosL, CosLat * SinL, SinLat};
+	for (int r = 0; r < 3; r++)
+		for (int c = 0; c < 3; c++)
+			FMatrix[3 * r + c] = static_cast<float>(H[3 * r] * P[c]
+				+ H[3 * r + 1] * P[3 + c] + H[3 * r + 2] * P[6 + c]);
+}
+//---------------------------------------------------------------------------
+void HorizonTransform::Apply(const SkyVectors& In, HorizonVectors& Out)
+{
+	const size_t n = In.Count();
+	Out.East.resize(n);
+	Out.North.resize(n);
+	Out.Up.resize(n);
+	Out.Visible.resize(n);
+	const size_t BlockCount = (n + BlockSize - 1) / BlockSize;
+	std::vector<size_t> BlockVisible(BlockCount);
+
+	std::atomic<size_t> Next{0};
+	const std::function<void()> Work = [&]
+	{
+		size_t b;
+		while ((b = Next.fetch_add(1)) < BlockCount)
+		{
+			const size_t First = b * BlockSize;
+			const size_t Count = std::min(BlockSize, n - First);
+			RotateBlock(FMatrix, &In.X[First], &In.Y[First], &In.Z[First],
+				&Out.East[First], &Out.North[First], &Out.Up[First], Count);
+			BlockVisible[b] = CullBlock(&Out.Up[First], FMinUp,
+				static_cast<uint32_t>(First), &Out.Visible[First], Count);
+		}
+	};
+	if (BlockCount > 1 && !FPool->Threads.empty())
+		FPool->Run(Work);
+	else
+		Work();
+
+	// Close up the gaps each block left after its visible indices
+	size_t Visible = 0;
+	for (size_t b = 0; b < BlockCount; b++)
+	{
+		const uint32_t* Block = &Out.Visible[b * BlockSize];
+		if (Visible != b * BlockSize)
+			std::copy(Block, Block + BlockVisible[b], &Out.Visible[Visible]);
+		Visible += BlockVisible[b];
+	}
+	Out.Visible.resize(Visible);
+}
+//---------------------------------------------------------------------------
+double HorizonTransform::Altitude(float Up)
+{
+	return std::asin(std::clamp(Up, -1.f, 1.f));
+}
+//---------------------------------------------------------------------------
+double HorizonTransform::Azimuth(float East, float North)
+{
+	const double Az = std::atan2(East, North);
+	return Az < 0 ? Az + 2 * Pi : Az;
+}
+//---------------------------------------------------------------------------
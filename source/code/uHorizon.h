@@ -0,0 +1,99 @@
+//---------------------------------------------------------------------------
+// The sky from a place on Earth at a given time: equatorial to horizon
+// coordinates for whole catalogs at once.
+//
+// For a given instant and observer, going from RA/Dec to Alt/Az is a
+// single rotation: precession from J2000 to the date, local sidereal
+// time about the pole, then latitude.  HorizonTransform builds that
+// matrix once per time step and applies it to equatorial unit vectors
+// held one array per axis (SkyVectors, made once from a decoded catalog
+// or from ConstFigureVertices).  Each star then costs nine multiply-adds
+// in a loop the compiler vectorises, with no trig.  Blocks of stars are
+// shared among worker threads.  The same pass writes the indices of
+// stars above MinAltitude, so culling below the horizon comes for free.
+//
+// Results are unit vectors East, North, Up (Up = sin Alt); Altitude()
+// and Azimuth() turn one into angles when a readout needs them.
+// Matrix() is there for renderers that would rather rotate on the GPU.
+//---------------------------------------------------------------------------
+
+#ifndef uHorizonH
+#define uHorizonH
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "uConstFigures.h"
+#include "uStarCatalog.h"
+
+//---------------------------------------------------------------------------
+// Equatorial (J2000) unit vectors: x = cos dec cos ra, y = cos dec sin ra,
+// z = sin dec.
+struct SkyVectors
+{
+	std::vector<float> X, Y, Z;
+	size_t Count() const { return X.size(); }
+};
+
+void MakeSkyVectors(const StarArrays& Stars, SkyVectors& Out);
+void MakeSkyVectors(std::span<const ConstFigureVertex> Vertices,
+	SkyVectors& Out);
+
+struct HorizonVectors
+{
+	std::vector<float> East, North, Up;
+	std::vector<uint32_t> Visible;  // ascending indices with Up >= sin(MinAltitude)
+	size_t Count() const { return Up.size(); }
+};
+
+//---------------------------------------------------------------------------
+// Julian date (UT) of a calendar date; Gregorian from 1582-10-15, Julian
+// before, astronomical years (1 BC = 0).
+double JulianDate(int Year, int Month, int Day, double Hours = 0);
+// Greenwich mean sidereal time, radians in [0, 2 pi).
+double GreenwichSiderealTime(double JD);
+
+//---------------------------------------------------------------------------
+class HorizonTransform
+{
+public:
+	// ThreadCount 0 uses every hardware thread.
+	explicit HorizonTransform(unsigned ThreadCount = 0);
+	~HorizonTransform();
+	HorizonTransform(const HorizonTransform&) = delete;
+	HorizonTransform& operator=(const HorizonTransform&) = delete;
+
+	// Degrees; longitude east positive.
+	void SetObserver(double Latitude, double Longitude);
+	void SetTime(double JD);
+	// Radians; stars lower than this stay out of Visible.  Slightly
+	// negative keeps stars that are rising into view.
+	void SetMinAltitude(double Altitude);
+
+	void Apply(const SkyVectors& In, HorizonVectors& Out);
+
+	// Row-major, equatorial J2000 to (East, North, Up).
+	const float* Matrix() const { return FMatrix; }
+	double LocalSiderealTime() const { return FLocalSiderealTime; }
+	unsigned ThreadCount() const;
+
+	static double Altitude(float Up);
+	static double Azimuth(float East, float North);  // from north through east
+
+private:
+	struct Pool;
+	void UpdateMatrix();
+
+	Pool* FPool;
+	double FLatitude = 0;
+	double FLongitude = 0;
+	double FJD = 2451545.0;
+	float FMinUp = 0.f;
+	double FLocalSiderealTime = 0;
+	float FMatrix[9];
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,398 @@
+unit uLabelLayout;
+//--------------------------------------------------
+// Placement of star names and Bayer letters
+//--------------------------------------------------
+(*
+  Each frame the viewer projects the stars it could label (the Bayer
+  letters of the figure vertices in uConstellations, the names of
+  uStarNames) to viewport pixels and adds them as candidates along with
+  the size of their text.  Layout then keeps the ones that fit:
+
+  - Candidates are taken most important first: the selection, then by
+    magnitude.  They are bucketed by tenths of a magnitude, so ordering
+    them is a counting pass rather than a sort.
+  - Each label tries a few slots around its star.  A slot is free when
+    nothing placed so far (labels, and the stars they belong to) overlaps
+    it in the grid cells it covers.  The grid is a spatial hash of CellSize
+    pixels, so a test looks at a few rectangles instead of every label
+    placed so far.
+  - Labels shown last frame try their old slot first and rank Hysteresis
+    magnitudes brighter, so they neither jump nor blink as the camera
+    moves.
+  - Layout gives up after BudgetMs.  Whatever it has not reached by then
+    is the faintest.
+
+  Only call it again when the scheduler has drCamera, drViewport or
+  drSelection dirty; otherwise last frame's placement still holds.
+*)
+
+interface
+
+uses
+  System.Types,
+  System.Diagnostics;
+
+type
+  // where the text sits relative to its star
+  TLabelSlot = (lsRight, lsLeft, lsAbove, lsBelow);
+
+  TPlacedLabel = record
+    Key: Integer;
+    Candidate: Integer; // order of the Add call this frame
+    Bounds: TRectF;     // of the text, viewport pixels
+    Slot: TLabelSlot;
+  end;
+
+  TLabelLayout = class
+  private
+    type
+      TCandidate = record
+        Key: Integer;
+        X, Y, Width, Height: Single;
+        Rank: Integer;
+        LastSlot: Integer; // -1 if not shown last frame
+      end;
+  private
+    FWidth, FHeight: Integer;
+    FCellSize: Integer;
+    FColumns, FRows: Integer;
+    FCandidates: TArray<TCandidate>;
+    FCandidateCount: Integer;
+    FOrder: TArray<Integer>;
+    FPlaced: TArray<TPlacedLabel>;
+    FPlacedCount: Integer;
+    // placed text and star rectangles, and the grid cells listing them
+    FRects: TArray<TRectF>;
+    FRectCount: Integer;
+    FCellHead: TArray<Integer>;
+    FEntryRect, FEntryNext: TArray<Integer>;
+    FEntryCount: Integer;
+    // Key * 256 + slot of last frame's labels, ascending
+    FLastSlots: TArray<Int64>;
+    FBudgetMs: Double;
+    FHysteresis: Single;
+    FGap: Single;
+    FStarRadius: Single;
+    FLastLayoutMs: Double;
+    FTruncated: Boolean;
+    function LastSlotOf(Key: Integer): Integer;
+    function SlotRect(const C: TCandidate; Slot: TLabelSlot): TRectF;
+    function IsFree(const R: TRectF): Boolean;
+    function Fits(const C: TCandidate; Slot: TLabelSlot; out R: TRectF): Boolean;
+    procedure Insert(const R: TRectF);
+    function GetPlaced(Index: Integer): TPlacedLabel;
+    procedure SetCellSize(Value: Integer);
+  public
+    constructor Create;
+    // Clears the candidates and the grid; keeps last frame's slots
+    procedure BeginFrame(ViewportWidth, ViewportHeight: Integer);
+    // X, Y is the star and Width x Height its text, viewport pixels.  Key
+    // has to name the same label from frame to frame.
+    procedure Add(Key: Integer; X, Y, Width, Height, Magnitude: Single;
+      Selected: Boolean = False);
+    // Returns the number of labels placed
+    function Layout: Integer;
+    function StatsText: string;
+    property Placed[Index: Integer]: TPlacedLabel read GetPlaced; default;
+    property PlacedCount: Integer read FPlacedCount;
+    property CandidateCount: Integer read FCandidateCount;
+    property CellSize: Integer read FCellSize write SetCellSize;
+    property BudgetMs: Double read FBudgetMs write FBudgetMs;
+    // magnitudes of head start for labels shown last frame
+    property Hysteresis: Single read FHysteresis write FHysteresis;
+    // pixels between a star and its text
+    property Gap: Single read FGap write FGap;
+    // pixels around a labelled star that other text keeps clear of
+    property StarRadius: Single read FStarRadius write FStarRadius;
+    property LastLayoutMs: Double read FLastLayoutMs;
+    // True when the budget ran out before every candidate was tried
+    property Truncated: Boolean read FTruncated;
+  end;
+
+//==========================================================================
+implementation
+//==========================================================================
+
+uses
+  System.SysUtils,
+  System.Math,
+  System.Generics.Collections;
+
+const
+  // rank 0 is the selection, then tenths of a magnitude up from -2
+  RankCount = 256;
+  RankOrigin = -2;
+  // candidates laid out between looks at the clock
+  BudgetStride = 64;
+
+//-----------------------------------------------------------------------
+
+constructor TLabelLayout.Create;
+begin
+  inherited;
+  FCellSize := 32;
+  FBudgetMs := 0.5;
+  FHysteresis := 0.5;
+  FGap := 3;
+  FStarRadius := 2;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TLabelLayout.SetCellSize(Value: Integer);
+begin
+  FCellSize := Max(Value, 4);
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TLabelLayout.BeginFrame(ViewportWidth, ViewportHeight: Integer);
+var
+  I: Integer;
+begin
+  FWidth := Max(ViewportWidth, 1);
+  FHeight := Max(ViewportHeight, 1);
+  FColumns := (FWidth + FCellSize - 1) div FCellSize;
+  FRows := (FHeight + FCellSize - 1) div FCellSize;
+  if Length(FCellHead) < FColumns * FRows then
+    SetLength(FCellHead, FColumns * FRows);
+  for I := 0 to FColumns * FRows - 1 do
+    FCellHead[I] := -1;
+  FCandidateCount := 0;
+  FRectCount := 0;
+  FEntryCount := 0;
+end;
+
+//-----------------------------------------------------------------------
+
+function TLabelLayout.LastSlotOf(Key: Integer): Integer;
+var
+  Lo, Hi, Mid: Integer;
+  Base: Int64;
+begin
+  // first entry >= Key * 256
+  Base := Int64(Key) * 256;
+  Lo := 0;
+  Hi := Length(FLastSlots);
+  while Lo < Hi do
+  begin
+    Mid := (Lo + Hi) shr 1;
+    if FLastSlots[Mid] < Base then
+      Lo := Mid + 1
+    else
+      Hi := Mid;
+  end;
+  if (Lo < Length(FLastSlots)) and (FLastSlots[Lo] < Base + 256) then
+    Result := FLastSlots[Lo] - Base
+  else
+    Result := -1;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TLabelLayout.Add(Key: Integer; X, Y, Width, Height, Magnitude: Single;
+  Selected: Boolean);
+var
+  C: TCandidate;
+begin
+  C.Key := Key;
+  C.X := X;
+  C.Y := Y;
+  C.Width := Width;
+  C.Height := Height;
+  C.LastSlot := LastSlotOf(Key);
+  if Selected then
+    C.Rank := 0
+  else
+  begin
+    if C.LastSlot >= 0 then
+      Magnitude := Magnitude - FHysteresis;
+    C.Rank := EnsureRange(1 + Round((Magnitude - RankOrigin) * 10), 1, RankCount - 1);
+  end;
+  if FCandidateCount = Length(FCandidates) then
+    SetLength(FCandidates, Max(256, 2 * FCandidateCount));
+  FCandidates[FCandidateCount] := C;
+  Inc(FCandidateCount);
+end;
+
+//-----------------------------------------------------------------------
+
+function TLabelLayout.SlotRect(const C: TCandidate; Slot: TLabelSlot): TRectF;
+begin
+  case Slot of
+    lsRight:
+      Result := RectF(C.X + FGap, C.Y - C.Height / 2, C.X + FGap + C.Width,
+        C.Y + C.Height / 2);
+    lsLeft:
+      Result := RectF(C.X - FGap - C.Width, C.Y - C.Height / 2, C.X - FGap,
+        C.Y + C.Height / 2);
+    lsAbove:
+      Result := RectF(C.X - C.Width / 2, C.Y - FGap - C.Height, C.X + C.Width / 2,
+        C.Y - FGap);
+  else
+    Result := RectF(C.X - C.Width / 2, C.Y + FGap, C.X + C.Width / 2,
+      C.Y + FGap + C.Height);
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+function TLabelLayout.IsFree(const R: TRectF): Boolean;
+var
+  Column, Row, Entry: Integer;
+  Other: TRectF;
+begin
+  for Row := Max(Floor(R.Top) div FCellSize, 0) to
+    Min(Floor(R.Bottom) div FCellSize, FRows - 1) do
+    for Column := Max(Floor(R.Left) div FCellSize, 0) to
+      Min(Floor(R.Right) div FCellSize, FColumns - 1) do
+    begin
+      Entry := FCellHead[Row * FColumns + Column];
+      while Entry >= 0 do
+      begin
+        Other := FRects[FEntryRect[Entry]];
+        if (R.Left < Other.Right) and (Other.Left < R.Right) and
+          (R.Top < Other.Bottom) and (Other.Top < R.Bottom) then
+          Exit(False);
+        Entry := FEntryNext[Entry];
+      end;
+    end;
+  Result := True;
+end;
+
+//-----------------------------------------------------------------------
+
+function TLabelLayout.Fits(const C: TCandidate; Slot: TLabelSlot;
+  out R: TRectF): Boolean;
+begin
+  // on screen as a whole and clear of everything placed
+  R := SlotRect(C, Slot);
+  Result := (R.Left >= 0) and (R.Top >= 0) and (R.Right <= FWidth) and
+    (R.Bottom <= FHeight) and IsFree(R);
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TLabelLayout.Insert(const R: TRectF);
+var
+  Column, Row, Cell: Integer;
+begin
+  if FRectCount = Length(FRects) then
+    SetLength(FRects, Max(256, 2 * FRectCount));
+  FRects[FRectCount] := R;
+  for Row := Max(Floor(R.Top) div FCellSize, 0) to
+    Min(Floor(R.Bottom) div FCellSize, FRows - 1) do
+    for Column := Max(Floor(R.Left) div FCellSize, 0) to
+      Min(Floor(R.Right) div FCellSize, FColumns - 1) do
+    begin
+      if FEntryCount = Length(FEntryRect) then
+      begin
+        SetLength(FEntryRect, Max(1024, 2 * FEntryCount));
+        SetLength(FEntryNext, Length(FEntryRect));
+      end;
+      Cell := Row * FColumns + Column;
+      FEntryRect[FEntryCount] := FRectCount;
+      FEntryNext[FEntryCount] := FCellHead[Cell];
+      FCellHead[Cell] := FEntryCount;
+      Inc(FEntryCount);
+    end;
+  Inc(FRectCount);
+end;
+
+//-----------------------------------------------------------------------
+
+function TLabelLayout.Layout: Integer;
+var
+  Stopwatch: TStopwatch;
+  Counts: array [0 .. RankCount] of Integer;
+  I, Rank: Integer;
+  C: TCandidate;
+  Slot, Chosen: TLabelSlot;
+  R: TRectF;
+  Found: Boolean;
+begin
+  Stopwatch := TStopwatch.StartNew;
+  FPlacedCount := 0;
+  FTruncated := False;
+
+  // Counting sort on Rank; equal ranks keep the order they were added in
+  FillChar(Counts, SizeOf(Counts), 0);
+  for I := 0 to FCandidateCount - 1 do
+    Inc(Counts[FCandidates[I].Rank + 1]);
+  for Rank := 1 to RankCount do
+    Inc(Counts[Rank], Counts[Rank - 1]);
+  if Length(FOrder) < FCandidateCount then
+    SetLength(FOrder, Length(FCandidates));
+  for I := 0 to FCandidateCount - 1 do
+  begin
+    Rank := FCandidates[I].Rank;
+    FOrder[Counts[Rank]] := I;
+    Inc(Counts[Rank]);
+  end;
+
+  for I := 0 to FCandidateCount - 1 do
+  begin
+    if (I > 0) and (I mod BudgetStride = 0) and
+      (Stopwatch.Elapsed.TotalMilliseconds > FBudgetMs) then
+    begin
+      FTruncated := True;
+      Break;
+    end;
+    C := FCandidates[FOrder[I]];
+    Chosen := lsRight;
+    // last frame's slot first, so a label that still fits stays put
+    Found := (C.LastSlot >= 0) and Fits(C, TLabelSlot(C.LastSlot), R);
+    if Found then
+      Chosen := TLabelSlot(C.LastSlot)
+    else
+      for Slot := Low(TLabelSlot) to High(TLabelSlot) do
+        if (Ord(Slot) <> C.LastSlot) and Fits(C, Slot, R) then
+        begin
+          Chosen := Slot;
+          Found := True;
+          Break;
+        end;
+    if not Found then
+      Continue;
+
+    Insert(R);
+    Insert(RectF(C.X - FStarRadius, C.Y - FStarRadius, C.X + FStarRadius,
+      C.Y + FStarRadius));
+    if FPlacedCount = Length(FPlaced) then
+      SetLength(FPlaced, Max(256, 2 * FPlacedCount));
+    FPlaced[FPlacedCount].Key := C.Key;
+    FPlaced[FPlacedCount].Candidate := FOrder[I];
+    FPlaced[FPlacedCount].Bounds := R;
+    FPlaced[FPlacedCount].Slot := Chosen;
+    Inc(FPlacedCount);
+  end;
+
+  // What stays on screen now is what keeps its place next frame
+  SetLength(FLastSlots, FPlacedCount);
+  for I := 0 to FPlacedCount - 1 do
+    FLastSlots[I] := Int64(FPlaced[I].Key) * 256 + Ord(FPlaced[I].Slot);
+  TArray.Sort<Int64>(FLastSlots);
+
+  Stopwatch.Stop;
+  FLastLayoutMs := Stopwatch.Elapsed.TotalMilliseconds;
+  Result := FPlacedCount;
+end;
+
+//-----------------------------------------------------------------------
+
+function TLabelLayout.GetPlaced(Index: Integer): TPlacedLabel;
+begin
+  Result := FPlaced[Index];
+end;
+
+//-----------------------------------------------------------------------
+
+function TLabelLayout.StatsText: string;
+const
+  cTruncated: array [Boolean] of string = ('', ', over budget');
+begin
+  Result := Format('labels %d of %d in %.2f ms%s', [FPlacedCount, FCandidateCount,
+    FLastLayoutMs, cTruncated[FTruncated]]);
+end;
+
+end.
@@ -0,0 +1,474 @@
+//---------------------------------------------------------------------------
+
+#include "uSkyIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+//---------------------------------------------------------------------------
+namespace
+{
+const double Pi = 3.14159265358979323846;
+const char IndexMagic[4] = {'H', 'P', 'X', '1'};
+
+enum
+{
+	Outside,
+	Partial,
+	Inside
+};
+
+struct IndexHeader
+{
+	char Magic[4];
+	int32_t Order;
+	uint64_t StarCount;
+	uint64_t CatalogHash;
+};
+
+// FNV-1a over the raw records, to tie an index file to its catalog.
+uint64_t HashRecords(std::span<const StarRecord> Stars)
+{
+	const uint8_t* p = reinterpret_cast<const uint8_t*>(Stars.data());
+	uint64_t Hash = 14695981039346656037ull;
+	for (size_t i = 0; i < Stars.size_bytes(); i++)
+		Hash = (Hash ^ p[i]) * 1099511628211ull;
+	return Hash;
+}
+
+void RecordToVector(const StarRecord& Star, float* Pos)
+{
+	const double RA = Star.RA * (Pi / 18000.);
+	const double Dec = Star.DEC * (Pi / 18000.);
+	Pos[0] = static_cast<float>(std::cos(Dec) * std::cos(RA));
+	Pos[1] = static_cast<float>(std::cos(Dec) * std::sin(RA));
+	Pos[2] = static_cast<float>(std::sin(Dec));
+}
+
+uint32_t SpreadBits(uint32_t v)
+{
+	v = (v | (v << 8)) & 0x00ff00ff;
+	v = (v | (v << 4)) & 0x0f0f0f0f;
+	v = (v | (v << 2)) & 0x33333333;
+	v = (v | (v << 1)) & 0x55555555;
+	return v;
+}
+
+float Dot(const float* a, const float* b)
+{
+	return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+// Angle between unit vectors from their chord; unlike acos of the dot
+// product it stays accurate down to milliarcseconds, which picking needs.
+float Separation(const float* a, const float* b)
+{
+	const float dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+	const float Chord = std::sqrt(dx * dx + dy * dy + dz * dz);
+	return 2.f * std::asin(std::min(0.5f * Chord, 1.f));
+}
+
+// Node tests for the two query shapes.  Cap() classifies a node's bounding
+// cap; Star() tests a single star in a partially covered node.
+struct ConeTest
+{
+	float Axis[3];
+	float Radius;
+	float CosRadius;
+
+	int Cap(const float* Center, float CapRadius) const
+	{
+		const float Angle = std::acos(std::clamp(Dot(Axis, Center), -1.f, 1.f));
+		if (Angle - CapRadius > Radius)
+			return Outside;
+		return (Angle + CapRadius <= Radius) ? Inside : Partial;
+	}
+	bool Star(const float* Pos) const { return Dot(Axis, Pos) >= CosRadius; }
+};
+
+struct FrustumTest
+{
+	const SkyPlane* Planes;
+	int PlaneCount;
+
+	int Cap(const float* Center, float CapRadius) const
+	{
+		// The cap lies within a ball of this radius around its centre.
+		const float Chord = 2.f * std::sin(0.5f * CapRadius);
+		int Result = Inside;
+		for (int i = 0; i < PlaneCount; i++)
+		{
+			const float s = Dot(Planes[i].Normal, Center) + Planes[i].D;
+			if (s < -Chord)
+				return Outside;
+			if (s < Chord)
+				Result = Partial;
+		}
+		return Result;
+	}
+	bool Star(const float* Pos) const
+	{
+		for (int i = 0; i < PlaneCount; i++)
+			if (Dot(Planes[i].Normal, Pos) + Planes[i].D < 0.f)
+				return false;
+		return true;
+	}
+};
+} // namespace
+
+//---------------------------------------------------------------------------
+// ang2pix_nest from the HEALPix C library (Gorski et al. 2005), taking a
+// unit vector: z = sin(dec), phi = RA.
+uint32_t SkyIndex::PixelOf(int Order, double x, double y, double z)
+{
+	const int Nside = 1 << Order;
+	const double za = std::fabs(z);
+	double tt = std::atan2(y, x) * (2. / Pi);  // in [-2, 2)
+	if (tt < 0.)
+		tt += 4.;
+	int Face, ix, iy;
+
+	if (za <= 2. / 3.)
+	{
+		const double t1 = Nside * (0.5 + tt);
+		const double t2 = Nside * (z * 0.75);
+		const int jp = static_cast<int>(t1 - t2);  // ascending edge line
+		const int jm = static_cast<int>(t1 + t2);  // descending edge line
+		const int ifp = jp >> Order;
+		const int ifm = jm >> Order;
+		Face = (ifp == ifm) ? (ifp | 4) : ((ifp < ifm) ? ifp : (ifm + 8));
+		ix = jm & (Nside - 1);
+		iy = Nside - (jp & (Nside - 1)) - 1;
+	}
+	else
+	{
+		int ntt = std::min(static_cast<int>(tt), 3);
+		const double tp = tt - ntt;
+		const double tmp = Nside * std::sqrt(3. * (1. - za));
+		const int jp = std::min(static_cast<int>(tp * tmp), Nside - 1);
+		const int jm = std::min(static_cast<int>((1. - tp) * tmp), Nside - 1);
+		if (z >= 0.)
+		{
+			Face = ntt;
+			ix = Nside - jm - 1;
+			iy = Nside - jp - 1;
+		}
+		else
+		{
+			Face = ntt + 8;
+			ix = jp;
+			iy = jm;
+		}
+	}
+	return (static_cast<uint32_t>(Face) << (2 * Order)) + SpreadBits(ix)
+		+ (SpreadBits(iy) << 1);
+}
+//---------------------------------------------------------------------------
+void SkyIndex::Build(std::span<const StarRecord> Stars, int Order)
+{
+	FOrder = std::clamp(Order, 0, 13);
+	FCatalogHash = HashRecords(Stars);
+	FStars.resize(Stars.size());
+
+	std::vector<uint32_t> Pixel(Stars.size());
+	for (size_t i = 0; i < Stars.size(); i++)
+	{
+		IndexedStar& s = FStars[i];
+		RecordToVector(Stars[i], s.Pos);
+		s.VMagnitude = Stars[i].VMagnitude;
+		s.Record = static_cast<uint32_t>(i);
+		Pixel[i] = PixelOf(FOrder, s.Pos[0], s.Pos[1], s.Pos[2]);
+	}
+	std::stable_sort(FStars.begin(), FStars.end(),
+		[&Pixel](const IndexedStar& a, const IndexedStar& b)
+		{
+			if (Pixel[a.Record] != Pixel[b.Record])
+				return Pixel[a.Record] < Pixel[b.Record];
+			return a.VMagnitude < b.VMagnitude;
+		});
+	BuildNodes();
+}
+//---------------------------------------------------------------------------
+// Leaf ranges come from a scan of the sorted stars; each coarser level's
+// node covers its four children's ranges.  Caps are centred on the mean
+// of the member stars, with the radius to the farthest one (plus a hair
+// for float rounding).
+void SkyIndex::BuildNodes()
+{
+	FLevelStart.assign(FOrder + 2, 0);
+	for (int Level = 0; Level <= FOrder; Level++)
+		FLevelStart[Level + 1] = FLevelStart[Level] + (12u << (2 * Level));
+	FNodes.assign(FLevelStart[FOrder + 1], Node());
+
+	Node* Leaves = &FNodes[FLevelStart[FOrder]];
+	const uint32_t LeafCount = 12u << (2 * FOrder);
+	uint32_t Star = 0;
+	for (uint32_t p = 0; p < LeafCount; p++)
+	{
+		Leaves[p].First = Star;
+		while (Star < FStars.size() && PixelOf(FOrder, FStars[Star].Pos[0],
+			FStars[Star].Pos[1], FStars[Star].Pos[2]) == p)
+			Star++;
+		Leaves[p].Last = Star;
+	}
+	for (int Level = FOrder - 1; Level >= 0; Level--)
+		for (uint32_t p = 0; p < (12u << (2 * Level)); p++)
+		{
+			Node& n = FNodes[FLevelStart[Level] + p];
+			n.First = NodeAt(Level + 1, 4 * p).First;
+			n.Last = NodeAt(Level + 1, 4 * p + 3).Last;
+		}
+
+	for (Node& n : FNodes)
+	{
+		double Sum[3] = {0., 0., 0.};
+		n.Brightest = 255;
+		for (uint32_t i = n.First; i < n.Last; i++)
+		{
+			for (int k = 0; k < 3; k++)
+				Sum[k] += FStars[i].Pos[k];
+			n.Brightest = std::min(n.Brightest, FStars[i].VMagnitude);
+		}
+		const double Len = std::sqrt(Sum[0] * Sum[0] + Sum[1] * Sum[1]
+			+ Sum[2] * Sum[2]);
+		for (int k = 0; k < 3; k++)
+			n.Center[k] = Len > 0. ? static_cast<float>(Sum[k] / Len) : 0.f;
+		float MinDot = 1.f;
+		for (uint32_t i = n.First; i < n.Last; i++)
+			MinDot = std::min(MinDot, Dot(n.Center, FStars[i].Pos));
+		n.Radius = std::acos(std::clamp(MinDot, -1.f, 1.f)) + 1e-5f;
+	}
+}
+//---------------------------------------------------------------------------
+bool SkyIndex::Save(const std::string& FileName) const
+{
+	FILE* File = std::fopen(FileName.c_str(), "wb");
+	if (!File)
+		return false;
+
+	IndexHeader Header;
+	std::memcpy(Header.Magic, IndexMagic, sizeof(Header.Magic));
+	Header.Order = FOrder;
+	Header.StarCount = FStars.size();
+	Header.CatalogHash = FCatalogHash;
+	std::vector<uint32_t> Records(FStars.size());
+	for (size_t i = 0; i < FStars.size(); i++)
+		Records[i] = FStars[i].Record;
+
+	bool Ok = std::fwrite(&Header, sizeof(Header), 1, File) == 1
+		&& std::fwrite(Records.data(), sizeof(uint32_t), Records.size(), File)
+			== Records.size();
+	Ok = (std::fclose(File) == 0) && Ok;
+	return Ok;
+}
+//---------------------------------------------------------------------------
+// Only the star order is stored; positions and node caps are rebuilt from
+// the (mapped) catalog, which takes about as long as reading them would.
+bool SkyIndex::Load(const std::string& FileName,
+	std::span<const StarRecord> Stars)
+{
+	FILE* File = std::fopen(FileName.c_str(), "rb");
+	if (!File)
+		return false;
+
+	IndexHeader Header;
+	std::vector<uint32_t> Records;
+	bool Ok = std::fread(&Header, sizeof(Header), 1, File) == 1
+		&& !std::memcmp(Header.Magic, IndexMagic, sizeof(Header.Magic))
+		&& Header.Order >= 0 && Header.Order <= 13
+		&& Header.StarCount == Stars.size()
+		&& Header.CatalogHash == HashRecords(Stars);
+	if (Ok)
+	{
+		Records.resize(Stars.size());
+		Ok = std::fread(Records.data(), sizeof(uint32_t), Records.size(), File)
+			== Records.size();
+	}
+	std::fclose(File);
+	for (size_t i = 0; Ok && i < Records.size(); i++)
+		Ok = Records[i] < Stars.size();
+	if (!Ok)
+		return false;
+
+	FOrder = Header.Order;
+	FCatalogHash = Header.CatalogHash;
+	FStars.resize(Records.size());
+	for (size_t i = 0; i < Records.size(); i++)
+	{
+		IndexedStar& s = FStars[i];
+		RecordToVector(Stars[Records[i]], s.Pos);
+		s.VMagnitude = Stars[Records[i]].VMagnitude;
+		s.Record = Records[i];
+	}
+	BuildNodes();
+	return true;
+}
+//---------------------------------------------------------------------------
+void SkyIndex::LoadOrBuild(const std::string& FileName,
+	std::span<const StarRecord> Stars, int Order)
+{
+	if (Load(FileName, Stars) && FOrder == Order)
+		return;
+	Build(Stars, Order);
+	Save(FileName);
+}
+//---------------------------------------------------------------------------
+template <class Classify>
+void SkyIndex::Query(Classify Test, float MaxMagnitude,
+	std::vector<uint32_t>& Out) const
+{
+	if (FNodes.empty())
+		return;
+	// Magnitudes are stored x10; compare in that unit.
+	const int Limit = static_cast<int>(std::floor(MaxMagnitude * 10.f + 1e-3f));
+	struct Pending
+	{
+		int Level;
+		uint32_t Pixel;
+	};
+	std::vector<Pending> Stack;
+	Stack.reserve(4 * (FOrder + 1) + 12);
+	for (uint32_t p = 12; p-- > 0;)
+		Stack.push_back({0, p});
+
+	while (!Stack.empty())
+	{
+		const Pending Item = Stack.back();
+		Stack.pop_back();
+		const Node& n = NodeAt(Item.Level, Item.Pixel);
+		if (n.First == n.Last || n.Brightest > Limit)
+			continue;
+		const int Coverage = Test.Cap(n.Center, n.Radius);
+		if (Coverage == Outside)
+			continue;
+		if (Item.Level < FOrder)
+		{
+			// Fully covered nodes still descend, so that faint leaves get
+			// dropped by their Brightest without looking at their stars.
+			for (uint32_t c = 4; c-- > 0;)
+				Stack.push_back({Item.Level + 1, 4 * Item.Pixel + c});
+			continue;
+		}
+		for (uint32_t i = n.First; i < n.Last; i++)
+		{
+			const IndexedStar& s = FStars[i];
+			if (s.VMagnitude > Limit)
+				break;  // the rest of the pixel is fainter still
+			if (Coverage == Inside || Test.Star(s.Pos))
+				Out.push_back(s.Record);
+		}
+	}
+}
+//---------------------------------------------------------------------------
+void SkyIndex::QueryCone(double RA, double Dec, double Radius,
+	float MaxMagnitude, std::vector<uint32_t>& Out) const
+{
+	ConeTest Test;
+	Test.Axis[0] = static_cast<float>(std::cos(Dec) * std::cos(RA));
+	Test.Axis[1] = static_cast<float>(std::cos(Dec) * std::sin(RA));
+	Test.Axis[2] = static_cast<float>(std::sin(Dec));
+	// Past Pi the cosine turns back up and the cone would shrink again
+	Radius = std::clamp(Radius, 0.0, Pi);
+	Test.Radius = static_cast<float>(Radius);
+	Test.CosRadius = static_cast<float>(std::cos(Radius));
+	Query(Test, MaxMagnitude, Out);
+}
+//---------------------------------------------------------------------------
+void SkyIndex::QueryFrustum(const SkyPlane* Planes, int PlaneCount,
+	float MaxMagnitude, std::vector<uint32_t>& Out) const
+{
+	Query(FrustumTest{Planes, PlaneCount}, MaxMagnitude, Out);
+}
+//---------------------------------------------------------------------------
+void SkyIndex::QueryNearest(double x, double y, double z, size_t K,
+	double MaxAngle, float MaxMagnitude, float MagnitudeWeight,
+	std::vector<SkyNeighbour>& Out) const
+{
+	Out.clear();
+	const double Length = std::sqrt(x * x + y * y + z * z);
+	if (FNodes.empty() || K == 0 || Length == 0)
+		return;
+	const float Axis[3] = {static_cast<float>(x / Length),
+		static_cast<float>(y / Length), static_cast<float>(z / Length)};
+	const float Reach = static_cast<float>(MaxAngle);
+	const int Limit = static_cast<int>(std::floor(MaxMagnitude * 10.f + 1e-3f));
+	// Per stored unit of magnitude (x10).  The bounds below take fainter
+	// as worse, so a negative (or NaN) weight is clamped to 0.
+	const float Weight = MagnitudeWeight > 0.f ? MagnitudeWeight * 0.1f : 0.f;
+
+	struct Pending
+	{
+		float Bound;   // no star below the node can score less
+		int Level;
+		uint32_t Pixel;
+	};
+	const auto Later = [](const Pending& a, const Pending& b)
+	{
+		return a.Bound > b.Bound;
+	};
+	const auto Better = [](const SkyNeighbour& a, const SkyNeighbour& b)
+	{
+		return a.Score < b.Score;
+	};
+	std::vector<Pending> Heap;
+	Heap.reserve(64);
+	const auto Push = [&](int Level, uint32_t Pixel)
+	{
+		const Node& n = NodeAt(Level, Pixel);
+		if (n.First == n.Last || n.Brightest > Limit)
+			return;
+		const float Angle = std::max(0.f, Separation(Axis, n.Center) - n.Radius);
+		if (Angle > Reach)
+			return;
+		Heap.push_back({Angle + Weight * n.Brightest, Level, Pixel});
+		std::push_heap(Heap.begin(), Heap.end(), Later);
+	};
+	for (uint32_t p = 0; p < 12; p++)
+		Push(0, p);
+
+	// Out is kept as a max-heap on Score while it fills, so its front is
+	// the candidate to beat.
+	while (!Heap.empty())
+	{
+		std::pop_heap(Heap.begin(), Heap.end(), Later);
+		const Pending Item = Heap.back();
+		Heap.pop_back();
+		if (Out.size() == K && Item.Bound >= Out.front().Score)
+			break;
+		if (Item.Level < FOrder)
+		{
+			for (uint32_t c = 0; c < 4; c++)
+				Push(Item.Level + 1, 4 * Item.Pixel + c);
+			continue;
+		}
+		const Node& n = NodeAt(Item.Level, Item.Pixel);
+		for (uint32_t i = n.First; i < n.Last; i++)
+		{
+			const IndexedStar& s = FStars[i];
+			if (s.VMagnitude > Limit)
+				break;
+			const float Faintness = Weight * s.VMagnitude;
+			if (Out.size() == K && Faintness >= Out.front().Score)
+				break;  // fainter stars of the pixel can't do better
+			const float Angle = Separation(Axis, s.Pos);
+			if (Angle > Reach)
+				continue;
+			const SkyNeighbour Candidate{s.Record, Angle, Angle + Faintness};
+			if (Out.size() < K)
+			{
+				Out.push_back(Candidate);
+				std::push_heap(Out.begin(), Out.end(), Better);
+			}
+			else if (Candidate.Score < Out.front().Score)
+			{
+				std::pop_heap(Out.begin(), Out.end(), Better);
+				Out.back() = Candidate;
+				std::push_heap(Out.begin(), Out.end(), Better);
+			}
+		}
+	}
+	std::sort_heap(Out.begin(), Out.end(), Better);
+}
+//---------------------------------------------------------------------------
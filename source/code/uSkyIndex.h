@@ -0,0 +1,121 @@
+//---------------------------------------------------------------------------
+// Hierarchical sky index over a star catalog (see uStarCatalog.h).
+//
+// Stars are binned into nested HEALPix pixels of order Order (Nside =
+// 2^Order; order 5 gives 12288 pixels, about seven Hipparcos stars
+// each), and within a pixel sorted bright to faint.  Because the scheme
+// is nested, every coarser pixel covers a contiguous run of those stars,
+// so the tree needs no pointers: each node just keeps a bounding cap
+// (centre and angular radius of the stars actually in it) and the
+// magnitude of its brightest star.  Queries walk down from the 12 base
+// pixels, dropping nodes that are outside the region or have nothing
+// bright enough, and taking whole runs without per-star tests when a
+// node is entirely inside.
+//
+// Results are indices into the catalog's record span.  The index is meant
+// to live next to its catalog, e.g. data/catalog/hipparcos.hpx for
+// hipparcos.stars, via LoadOrBuild().
+//---------------------------------------------------------------------------
+
+#ifndef uSkyIndexH
+#define uSkyIndexH
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "uStarCatalog.h"
+
+//---------------------------------------------------------------------------
+// Half-space n.x + d >= 0; a frustum is up to six of these.  For a camera
+// at the centre of the sky sphere d is zero for the side planes.
+struct SkyPlane
+{
+	float Normal[3];
+	float D;
+};
+
+// One result of SkyIndex::QueryNearest().
+struct SkyNeighbour
+{
+	uint32_t Record;    // into the catalog's record span
+	float Angle;        // radians from the query point
+	float Score;        // Angle + MagnitudeWeight * magnitude; lower is better
+};
+
+//---------------------------------------------------------------------------
+class SkyIndex
+{
+public:
+	static const int DefaultOrder = 5;
+
+	void Build(std::span<const StarRecord> Stars, int Order = DefaultOrder);
+
+	// The index file records the catalog's size and hash; Load() refuses a
+	// file built from some other catalog.  LoadOrBuild() falls back to
+	// Build() and then tries to Save(), so the work is done once.
+	bool Save(const std::string& FileName) const;
+	bool Load(const std::string& FileName, std::span<const StarRecord> Stars);
+	void LoadOrBuild(const std::string& FileName,
+		std::span<const StarRecord> Stars, int Order = DefaultOrder);
+
+	// RA, Dec and Radius in radians, Radius clamped to [0, Pi].  Appends
+	// catalog indices of stars no fainter than MaxMagnitude, bright to faint
+	// within each pixel.
+	void QueryCone(double RA, double Dec, double Radius, float MaxMagnitude,
+		std::vector<uint32_t>& Out) const;
+	void QueryFrustum(const SkyPlane* Planes, int PlaneCount,
+		float MaxMagnitude, std::vector<uint32_t>& Out) const;
+
+	// The K stars nearest the unit vector (x, y, z), within MaxAngle
+	// radians and no fainter than MaxMagnitude, best Score first.  With a
+	// MagnitudeWeight (radians per magnitude, clamped to >= 0) a bright
+	// star can win over a faint one that is slightly closer.  Nodes are
+	// visited best-first by the lowest score their cap and Brightest allow,
+	// so a query stops after a handful of pixels around the point.
+	// Replaces Out.
+	void QueryNearest(double x, double y, double z, size_t K, double MaxAngle,
+		float MaxMagnitude, float MagnitudeWeight,
+		std::vector<SkyNeighbour>& Out) const;
+
+	int Order() const { return FOrder; }
+	size_t StarCount() const { return FStars.size(); }
+
+	// Nested HEALPix pixel of a unit vector at the given order.
+	static uint32_t PixelOf(int Order, double x, double y, double z);
+
+private:
+	struct Node
+	{
+		float Center[3];
+		float Radius;       // radians, from Center to the farthest star
+		uint32_t First;     // star range [First, Last) in FStars
+		uint32_t Last;
+		uint8_t Brightest;  // lowest VMagnitude in the node
+	};
+	struct IndexedStar
+	{
+		float Pos[3];
+		uint8_t VMagnitude;
+		uint32_t Record;
+	};
+
+	template <class Classify>
+	void Query(Classify Test, float MaxMagnitude,
+		std::vector<uint32_t>& Out) const;
+	void BuildNodes();
+	const Node& NodeAt(int Level, uint32_t Pixel) const
+	{
+		return FNodes[FLevelStart[Level] + Pixel];
+	}
+
+	int FOrder = 0;
+	std::vector<IndexedStar> FStars;     // sorted by (pixel, magnitude)
+	std::vector<Node> FNodes;            // all levels, coarse first
+	std::vector<uint32_t> FLevelStart;   // first node of each level
+	uint64_t FCatalogHash = 0;
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,172 @@
+//---------------------------------------------------------------------------
+
+#include "uStarCatalog.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//---------------------------------------------------------------------------
+StarCatalog::StarCatalog(StarCatalog&& Other) noexcept
+{
+	*this = std::move(Other);
+}
+//---------------------------------------------------------------------------
+StarCatalog& StarCatalog::operator=(StarCatalog&& Other) noexcept
+{
+	if (this != &Other)
+	{
+		Close();
+		std::swap(FData, Other.FData);
+		std::swap(FSize, Other.FSize);
+#ifdef _WIN32
+		std::swap(FFile, Other.FFile);
+		std::swap(FMapping, Other.FMapping);
+#endif
+		FLastError = std::move(Other.FLastError);
+	}
+	return *this;
+}
+//---------------------------------------------------------------------------
+bool StarCatalog::Open(const std::string& FileName)
+{
+	Close();
+	FLastError.clear();
+#ifdef _WIN32
+	HANDLE File = CreateFileA(FileName.c_str(), GENERIC_READ, FILE_SHARE_READ,
+		nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (File == INVALID_HANDLE_VALUE)
+	{
+		FLastError = "Cannot open " + FileName;
+		return false;
+	}
+	LARGE_INTEGER Size;
+	if (!GetFileSizeEx(File, &Size))
+	{
+		CloseHandle(File);
+		FLastError = "Cannot get size of " + FileName;
+		return false;
+	}
+	FFile = File;
+	FSize = static_cast<size_t>(Size.QuadPart);
+#else
+	int File = open(FileName.c_str(), O_RDONLY);
+	if (File < 0)
+	{
+		FLastError = "Cannot open " + FileName;
+		return false;
+	}
+	struct stat Info;
+	if (fstat(File, &Info) != 0)
+	{
+		close(File);
+		FLastError = "Cannot get size of " + FileName;
+		return false;
+	}
+	FSize = static_cast<size_t>(Info.st_size);
+#endif
+
+	if (FSize == 0 || FSize % sizeof(StarRecord) != 0)
+	{
+		FLastError = FileName + " is not a star file (size "
+			+ std::to_string(FSize) + " is not a multiple of "
+			+ std::to_string(sizeof(StarRecord)) + ")";
+#ifdef _WIN32
+		Close();
+#else
+		close(File);
+		FSize = 0;
+#endif
+		return false;
+	}
+
+#ifdef _WIN32
+	FMapping = CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (FMapping)
+		FData = MapViewOfFile(FMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!FData)
+	{
+		Close();
+		FLastError = "Cannot map " + FileName;
+		return false;
+	}
+#else
+	void* Data = mmap(nullptr, FSize, PROT_READ, MAP_PRIVATE, File, 0);
+	close(File);  // the mapping keeps its own reference
+	if (Data == MAP_FAILED)
+	{
+		FSize = 0;
+		FLastError = "Cannot map " + FileName;
+		return false;
+	}
+	madvise(Data, FSize, MADV_WILLNEED);
+	FData = Data;
+#endif
+	return true;
+}
+//---------------------------------------------------------------------------
+void StarCatalog::Close()
+{
+#ifdef _WIN32
+	if (FData)
+		UnmapViewOfFile(FData);
+	if (FMapping)
+		CloseHandle(FMapping);
+	if (FFile)
+		CloseHandle(FFile);
+	FMapping = nullptr;
+	FFile = nullptr;
+#else
+	if (FData)
+		munmap(const_cast<void*>(FData), FSize);
+#endif
+	FData = nullptr;
+	FSize = 0;
+}
+//---------------------------------------------------------------------------
+size_t StarCatalog::Validate(std::vector<size_t>* BadRecords) const
+{
+	size_t Bad = 0;
+	uint8_t PrevMagnitude = 0;
+	const std::span<const StarRecord> Stars = Records();
+
+	for (size_t i = 0; i < Stars.size(); i++)
+	{
+		const StarRecord& Star = Stars[i];
+		if (Star.RA >= 36000 || Star.DEC < -9000 || Star.DEC > 9000
+			|| Star.VMagnitude < PrevMagnitude)
+		{
+			Bad++;
+			if (BadRecords)
+				BadRecords->push_back(i);
+		}
+		PrevMagnitude = Star.VMagnitude;
+	}
+	return Bad;
+}
+//---------------------------------------------------------------------------
+void DecodeStars(std::span<const StarRecord> Stars, StarArrays& Out)
+{
+	const float Scale = 3.14159265358979f / 18000.f;  // x100 degrees to radians
+	const size_t n = Stars.size();
+
+	Out.RA.resize(n);
+	Out.Dec.resize(n);
+	Out.Magnitude.resize(n);
+	Out.ColorIndex.resize(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		Out.RA[i] = Stars[i].RA * Scale;
+		Out.Dec[i] = Stars[i].DEC * Scale;
+		Out.Magnitude[i] = Stars[i].VMagnitude * 0.1f;
+		Out.ColorIndex[i] = (Stars[i].BVColorIndex - 50) * 0.01f;
+	}
+}
+//---------------------------------------------------------------------------
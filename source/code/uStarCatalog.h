@@ -0,0 +1,96 @@
+//---------------------------------------------------------------------------
+// Zero-copy reader for GLScene star files (data/catalog/hipparcos.stars).
+//
+// The file is a flat array of 6-byte little-endian records, sorted from
+// the brightest star down.  StarCatalog maps it into memory and hands out
+// a span over the records, so opening it costs one mmap rather than a
+// parse and a list entry per star.  DecodeStars() unpacks to SoA floats
+// for code that wants radians and magnitudes.
+//---------------------------------------------------------------------------
+
+#ifndef uStarCatalogH
+#define uStarCatalogH
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+//---------------------------------------------------------------------------
+#pragma pack(push, 1)
+struct StarRecord
+{
+	uint16_t RA;           // degrees x100, [0..36000)
+	int16_t DEC;           // degrees x100, [-9000..9000]
+	uint8_t BVColorIndex;  // (B-V + 0.5) x100
+	uint8_t VMagnitude;    // x10
+
+	float RADegrees() const { return RA * 0.01f; }
+	float DecDegrees() const { return DEC * 0.01f; }
+	float ColorIndex() const { return (BVColorIndex - 50) * 0.01f; }
+	float Magnitude() const { return VMagnitude * 0.1f; }
+};
+#pragma pack(pop)
+
+static_assert(sizeof(StarRecord) == 6, "star records must stay 6 bytes");
+
+//---------------------------------------------------------------------------
+// Decoded catalog, one array per field.
+struct StarArrays
+{
+	std::vector<float> RA;          // radians
+	std::vector<float> Dec;         // radians
+	std::vector<float> Magnitude;
+	std::vector<float> ColorIndex;  // B-V
+
+	size_t Count() const { return RA.size(); }
+};
+
+//---------------------------------------------------------------------------
+class StarCatalog
+{
+public:
+	StarCatalog() = default;
+	~StarCatalog() { Close(); }
+	StarCatalog(const StarCatalog&) = delete;
+	StarCatalog& operator=(const StarCatalog&) = delete;
+	StarCatalog(StarCatalog&& Other) noexcept;
+	StarCatalog& operator=(StarCatalog&& Other) noexcept;
+
+	// Maps FileName read-only.  Returns false (with LastError() set) if it
+	// can't be opened or its size isn't a whole number of records.
+	bool Open(const std::string& FileName);
+	void Close();
+
+	bool IsOpen() const { return FData != nullptr; }
+	const std::string& LastError() const { return FLastError; }
+
+	std::span<const StarRecord> Records() const
+	{
+		return std::span<const StarRecord>(
+			static_cast<const StarRecord*>(FData), FSize / sizeof(StarRecord));
+	}
+	size_t Count() const { return FSize / sizeof(StarRecord); }
+
+	// Checks every record for out-of-range RA/Dec and for the
+	// bright-to-faint ordering the file promises.  Returns the number of
+	// offending records; their indices go to BadRecords if given.
+	size_t Validate(std::vector<size_t>* BadRecords = nullptr) const;
+
+private:
+	const void* FData = nullptr;
+	size_t FSize = 0;
+#ifdef _WIN32
+	void* FFile = nullptr;
+	void* FMapping = nullptr;
+#endif
+	std::string FLastError;
+};
+
+//---------------------------------------------------------------------------
+// Unpacks Stars into Out (resized to match).
+void DecodeStars(std::span<const StarRecord> Stars, StarArrays& Out);
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,304 @@
+//---------------------------------------------------------------------------
+
+#include "uStarField.h"
+
+#include <cmath>
+#include <cstddef>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+//---------------------------------------------------------------------------
+// GL 1.1 calls come straight from the system library; everything newer is
+// resolved at Init() time, since wglGetProcAddress won't hand out 1.1.
+#define STARFIELD_GL_FUNCTIONS(F) \
+	F(PFNGLGENBUFFERSPROC, glGenBuffers) \
+	F(PFNGLBINDBUFFERPROC, glBindBuffer) \
+	F(PFNGLBUFFERDATAPROC, glBufferData) \
+	F(PFNGLDELETEBUFFERSPROC, glDeleteBuffers) \
+	F(PFNGLCREATESHADERPROC, glCreateShader) \
+	F(PFNGLSHADERSOURCEPROC, glShaderSource) \
+	F(PFNGLCOMPILESHADERPROC, glCompileShader) \
+	F(PFNGLGETSHADERIVPROC, glGetShaderiv) \
+	F(PFNGLGETSHADERINFOLOGPROC, glGetShaderInfoLog) \
+	F(PFNGLDELETESHADERPROC, glDeleteShader) \
+	F(PFNGLCREATEPROGRAMPROC, glCreateProgram) \
+	F(PFNGLATTACHSHADERPROC, glAttachShader) \
+	F(PFNGLLINKPROGRAMPROC, glLinkProgram) \
+	F(PFNGLGETPROGRAMIVPROC, glGetProgramiv) \
+	F(PFNGLGETPROGRAMINFOLOGPROC, glGetProgramInfoLog) \
+	F(PFNGLDELETEPROGRAMPROC, glDeleteProgram) \
+	F(PFNGLUSEPROGRAMPROC, glUseProgram) \
+	F(PFNGLGETATTRIBLOCATIONPROC, glGetAttribLocation) \
+	F(PFNGLGETUNIFORMLOCATIONPROC, glGetUniformLocation) \
+	F(PFNGLUNIFORM1FPROC, glUniform1f) \
+	F(PFNGLUNIFORMMATRIX4FVPROC, glUniformMatrix4fv) \
+	F(PFNGLVERTEXATTRIBPOINTERPROC, glVertexAttribPointer) \
+	F(PFNGLENABLEVERTEXATTRIBARRAYPROC, glEnableVertexAttribArray) \
+	F(PFNGLDISABLEVERTEXATTRIBARRAYPROC, glDisableVertexAttribArray) \
+	F(PFNGLGETVERTEXATTRIBIVPROC, glGetVertexAttribiv) \
+	F(PFNGLBLENDFUNCSEPARATEPROC, glBlendFuncSeparate)
+
+struct StarFieldRenderer::GLFunctions
+{
+#define STARFIELD_DECLARE(Type, Name) Type Name = nullptr;
+	STARFIELD_GL_FUNCTIONS(STARFIELD_DECLARE)
+#undef STARFIELD_DECLARE
+};
+
+//---------------------------------------------------------------------------
+namespace
+{
+// Magnitude and B-V arrive as the raw catalog bytes.  The colour ramp is
+// a piecewise-linear fit to blackbody colours over B-V -0.4 .. 2.0.
+// Stars past the limit keep a legal point size but are put beyond the
+// far plane, so they are clipped before any fragment is made.
+const char* VertexShader =
+	"#version 120\n"
+	"uniform mat4 MVP;\n"
+	"uniform float MagLimit;\n"
+	"uniform float PointScale;\n"
+	"attribute vec3 Position;\n"
+	"attribute vec2 Photometry;\n"
+	"varying vec4 Color;\n"
+	"vec3 BVToRGB(float bv)\n"
+	"{\n"
+	"  vec3 c = mix(vec3(0.61, 0.71, 1.0), vec3(1.0), smoothstep(-0.4, 0.3, bv));\n"
+	"  c = mix(c, vec3(1.0, 0.86, 0.6), smoothstep(0.3, 1.2, bv));\n"
+	"  return mix(c, vec3(1.0, 0.6, 0.4), smoothstep(1.2, 2.0, bv));\n"
+	"}\n"
+	"void main()\n"
+	"{\n"
+	"  float bv = Photometry.x * 0.01 - 0.5;\n"
+	"  float mag = Photometry.y * 0.1;\n"
+	"  float excess = MagLimit - mag;\n"
+	"  gl_Position = MVP * vec4(Position, 1.0);\n"
+	"  if (excess < 0.0)\n"
+	"    gl_Position = vec4(0.0, 0.0, 2.0, 1.0);\n"
+	"  gl_PointSize = clamp(PointScale * pow(10.0, 0.1 * excess), 1.0, 16.0);\n"
+	"  Color = vec4(BVToRGB(bv), excess < 0.0 ? 0.0\n"
+	"    : clamp(0.25 + excess, 0.0, 1.0));\n"
+	"}\n";
+
+const char* FragmentShader =
+	"#version 120\n"
+	"varying vec4 Color;\n"
+	"void main()\n"
+	"{\n"
+	"  vec2 d = gl_PointCoord * 2.0 - 1.0;\n"
+	"  float r2 = dot(d, d);\n"
+	"  if (r2 > 1.0 || Color.a <= 0.0)\n"
+	"    discard;\n"
+	"  gl_FragColor = vec4(Color.rgb, Color.a * (1.0 - r2 * r2));\n"
+	"}\n";
+
+// The GL state Draw changes, as it was before.  GLScene caches its state
+// (TGLStateCache) and trusts the context to still hold what it last set,
+// so everything goes back exactly as found rather than to defaults.
+struct SavedState
+{
+	GLboolean ProgramPointSize, PointSprite, Blend, DepthMask;
+	GLint BlendSrcRGB, BlendDstRGB, BlendSrcAlpha, BlendDstAlpha;
+	GLint Program, ArrayBuffer;
+	GLint AttribEnabled[2];
+};
+
+#ifndef GL_VERTEX_PROGRAM_POINT_SIZE
+#define GL_VERTEX_PROGRAM_POINT_SIZE 0x8642
+#endif
+#ifndef GL_POINT_SPRITE
+#define GL_POINT_SPRITE 0x8861
+#endif
+} // namespace
+
+//---------------------------------------------------------------------------
+void BuildStarVertices(std::span<const StarRecord> Stars,
+	std::vector<StarVertex>& Out)
+{
+	const double Scale = 3.14159265358979323846 / 18000.;
+
+	Out.resize(Stars.size());
+	for (size_t i = 0; i < Stars.size(); i++)
+	{
+		const double RA = Stars[i].RA * Scale;
+		const double Dec = Stars[i].DEC * Scale;
+		StarVertex& v = Out[i];
+		v.Pos[0] = static_cast<float>(std::cos(Dec) * std::cos(RA));
+		v.Pos[1] = static_cast<float>(std::cos(Dec) * std::sin(RA));
+		v.Pos[2] = static_cast<float>(std::sin(Dec));
+		v.BVColorIndex = Stars[i].BVColorIndex;
+		v.VMagnitude = Stars[i].VMagnitude;
+		v.Pad[0] = v.Pad[1] = 0;
+	}
+}
+
+//---------------------------------------------------------------------------
+StarFieldRenderer::StarFieldRenderer() : FGL(new GLFunctions)
+{
+}
+//---------------------------------------------------------------------------
+StarFieldRenderer::~StarFieldRenderer()
+{
+	// GL objects can only be freed with the context current, which isn't
+	// guaranteed here; Release() is the owner's job.
+	delete FGL;
+}
+//---------------------------------------------------------------------------
+bool StarFieldRenderer::Init(GetProcAddressFunc GetProcAddress)
+{
+	GLFunctions& gl = *FGL;
+#define STARFIELD_LOAD(Type, Name) \
+	gl.Name = reinterpret_cast<Type>(GetProcAddress(#Name)); \
+	if (!gl.Name) \
+	{ \
+		FInfoLog = "OpenGL 2.1 entry point " #Name " is missing"; \
+		return false; \
+	}
+	STARFIELD_GL_FUNCTIONS(STARFIELD_LOAD)
+#undef STARFIELD_LOAD
+
+	auto Compile = [this, &gl](GLenum Type, const char* Source) -> GLuint
+	{
+		GLuint Shader = gl.glCreateShader(Type);
+		GLint Ok = GL_FALSE;
+		gl.glShaderSource(Shader, 1, &Source, nullptr);
+		gl.glCompileShader(Shader);
+		gl.glGetShaderiv(Shader, GL_COMPILE_STATUS, &Ok);
+		if (!Ok)
+		{
+			char Log[1024];
+			gl.glGetShaderInfoLog(Shader, sizeof(Log), nullptr, Log);
+			FInfoLog = Log;
+			gl.glDeleteShader(Shader);
+			return 0;
+		}
+		return Shader;
+	};
+
+	GLuint Vertex = Compile(GL_VERTEX_SHADER, VertexShader);
+	GLuint Fragment = Vertex ? Compile(GL_FRAGMENT_SHADER, FragmentShader) : 0;
+	if (!Fragment)
+	{
+		if (Vertex)
+			gl.glDeleteShader(Vertex);
+		return false;
+	}
+	FProgram = gl.glCreateProgram();
+	gl.glAttachShader(FProgram, Vertex);
+	gl.glAttachShader(FProgram, Fragment);
+	gl.glLinkProgram(FProgram);
+	gl.glDeleteShader(Vertex);  // the program keeps them alive
+	gl.glDeleteShader(Fragment);
+
+	GLint Ok = GL_FALSE;
+	gl.glGetProgramiv(FProgram, GL_LINK_STATUS, &Ok);
+	if (!Ok)
+	{
+		char Log[1024];
+		gl.glGetProgramInfoLog(FProgram, sizeof(Log), nullptr, Log);
+		FInfoLog = Log;
+		gl.glDeleteProgram(FProgram);
+		FProgram = 0;
+		return false;
+	}
+	FPositionAttrib = gl.glGetAttribLocation(FProgram, "Position");
+	FPhotometryAttrib = gl.glGetAttribLocation(FProgram, "Photometry");
+	FMVPUniform = gl.glGetUniformLocation(FProgram, "MVP");
+	FLimitUniform = gl.glGetUniformLocation(FProgram, "MagLimit");
+	FScaleUniform = gl.glGetUniformLocation(FProgram, "PointScale");
+	gl.glGenBuffers(1, &FBuffer);
+	return true;
+}
+//---------------------------------------------------------------------------
+void StarFieldRenderer::Upload(std::span<const StarRecord> Stars)
+{
+	if (!FBuffer)
+		return;
+	std::vector<StarVertex> Vertices;
+	BuildStarVertices(Stars, Vertices);
+	FGL->glBindBuffer(GL_ARRAY_BUFFER, FBuffer);
+	FGL->glBufferData(GL_ARRAY_BUFFER, Vertices.size() * sizeof(StarVertex),
+		Vertices.data(), GL_STATIC_DRAW);
+	FGL->glBindBuffer(GL_ARRAY_BUFFER, 0);
+	FCount = Vertices.size();
+}
+//---------------------------------------------------------------------------
+void StarFieldRenderer::Draw(const float* ModelViewProjection,
+	float MagnitudeLimit, float PointScale) const
+{
+	if (!FProgram || !FCount)
+		return;
+	const GLFunctions& gl = *FGL;
+	const GLint Attribs[2] = {FPositionAttrib, FPhotometryAttrib};
+
+	SavedState Saved;
+	Saved.ProgramPointSize = glIsEnabled(GL_VERTEX_PROGRAM_POINT_SIZE);
+	Saved.PointSprite = glIsEnabled(GL_POINT_SPRITE);
+	Saved.Blend = glIsEnabled(GL_BLEND);
+	glGetBooleanv(GL_DEPTH_WRITEMASK, &Saved.DepthMask);
+	glGetIntegerv(GL_BLEND_SRC_RGB, &Saved.BlendSrcRGB);
+	glGetIntegerv(GL_BLEND_DST_RGB, &Saved.BlendDstRGB);
+	glGetIntegerv(GL_BLEND_SRC_ALPHA, &Saved.BlendSrcAlpha);
+	glGetIntegerv(GL_BLEND_DST_ALPHA, &Saved.BlendDstAlpha);
+	glGetIntegerv(GL_CURRENT_PROGRAM, &Saved.Program);
+	glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &Saved.ArrayBuffer);
+	for (int i = 0; i < 2; i++)
+		gl.glGetVertexAttribiv(Attribs[i], GL_VERTEX_ATTRIB_ARRAY_ENABLED,
+			&Saved.AttribEnabled[i]);
+
+	gl.glUseProgram(FProgram);
+	gl.glUniformMatrix4fv(FMVPUniform, 1, GL_FALSE, ModelViewProjection);
+	gl.glUniform1f(FLimitUniform, MagnitudeLimit);
+	gl.glUniform1f(FScaleUniform, PointScale);
+
+	gl.glBindBuffer(GL_ARRAY_BUFFER, FBuffer);
+	gl.glEnableVertexAttribArray(FPositionAttrib);
+	gl.glVertexAttribPointer(FPositionAttrib, 3, GL_FLOAT, GL_FALSE,
+		sizeof(StarVertex), reinterpret_cast<const void*>(offsetof(StarVertex, Pos)));
+	gl.glEnableVertexAttribArray(FPhotometryAttrib);
+	gl.glVertexAttribPointer(FPhotometryAttrib, 2, GL_UNSIGNED_BYTE, GL_FALSE,
+		sizeof(StarVertex),
+		reinterpret_cast<const void*>(offsetof(StarVertex, BVColorIndex)));
+
+	glEnable(GL_VERTEX_PROGRAM_POINT_SIZE);
+	glEnable(GL_POINT_SPRITE);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+	glDepthMask(GL_FALSE);
+
+	glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(FCount));
+
+	auto Restore = [](GLenum Cap, GLboolean Enabled)
+	{
+		if (Enabled)
+			glEnable(Cap);
+		else
+			glDisable(Cap);
+	};
+	glDepthMask(Saved.DepthMask);
+	gl.glBlendFuncSeparate(Saved.BlendSrcRGB, Saved.BlendDstRGB,
+		Saved.BlendSrcAlpha, Saved.BlendDstAlpha);
+	Restore(GL_BLEND, Saved.Blend);
+	Restore(GL_POINT_SPRITE, Saved.PointSprite);
+	Restore(GL_VERTEX_PROGRAM_POINT_SIZE, Saved.ProgramPointSize);
+	for (int i = 0; i < 2; i++)
+		if (!Saved.AttribEnabled[i])
+			gl.glDisableVertexAttribArray(Attribs[i]);
+	gl.glBindBuffer(GL_ARRAY_BUFFER, Saved.ArrayBuffer);
+	gl.glUseProgram(Saved.Program);
+}
+//---------------------------------------------------------------------------
+void StarFieldRenderer::Release()
+{
+	if (FBuffer)
+		FGL->glDeleteBuffers(1, &FBuffer);
+	if (FProgram)
+		FGL->glDeleteProgram(FProgram);
+	FBuffer = 0;
+	FProgram = 0;
+	FCount = 0;
+}
+//---------------------------------------------------------------------------
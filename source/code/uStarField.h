@@ -0,0 +1,85 @@
+//---------------------------------------------------------------------------
+// Star field renderer: the whole catalog in one static vertex buffer,
+// drawn with a single point-sprite call.
+//
+// Each star is uploaded once as a unit vector plus its raw B-V and
+// magnitude bytes; the vertex shader turns those into colour and point
+// size, and drops stars fainter than the current limit.  Nothing is
+// touched on the CPU per frame, so the frame cost no longer grows with
+// the catalog depth.
+//
+// The renderer needs a current OpenGL 2.1 (or compatibility profile)
+// context, e.g. inside a TGLDirectOpenGL.OnRender handler.  It doesn't
+// link against a GL loader; Init() takes the context's GetProcAddress
+// (wglGetProcAddress, glXGetProcAddress, ...) and resolves what it needs.
+//---------------------------------------------------------------------------
+
+#ifndef uStarFieldH
+#define uStarFieldH
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "uStarCatalog.h"
+
+//---------------------------------------------------------------------------
+struct StarVertex
+{
+	float Pos[3];          // unit vector, equatorial
+	uint8_t BVColorIndex;  // as in StarRecord
+	uint8_t VMagnitude;    // as in StarRecord
+	uint8_t Pad[2];
+};
+
+static_assert(sizeof(StarVertex) == 16, "star vertices must stay 16 bytes");
+
+void BuildStarVertices(std::span<const StarRecord> Stars,
+	std::vector<StarVertex>& Out);
+
+//---------------------------------------------------------------------------
+class StarFieldRenderer
+{
+public:
+	typedef void* (*GetProcAddressFunc)(const char* Name);
+
+	StarFieldRenderer();
+	~StarFieldRenderer();
+	StarFieldRenderer(const StarFieldRenderer&) = delete;
+	StarFieldRenderer& operator=(const StarFieldRenderer&) = delete;
+
+	// Resolves entry points and compiles the shaders.  False if the
+	// context is too old or a shader fails (see InfoLog()).
+	bool Init(GetProcAddressFunc GetProcAddress);
+	// Replaces the vertex buffer contents; call once per catalog (or when
+	// a StarTierStream changes its resident set).
+	void Upload(std::span<const StarRecord> Stars);
+	// ModelViewProjection is column-major, as OpenGL wants it.  Stars
+	// fainter than MagnitudeLimit aren't drawn; PointScale is the size
+	// in pixels of a star right at the limit.  Leaves the GL state as it
+	// found it.
+	void Draw(const float* ModelViewProjection, float MagnitudeLimit,
+		float PointScale = 1.5f) const;
+	// Frees the GL objects; the context must still be current.
+	void Release();
+
+	size_t StarCount() const { return FCount; }
+	const char* InfoLog() const { return FInfoLog.c_str(); }
+
+private:
+	struct GLFunctions;
+	GLFunctions* FGL;
+	unsigned FProgram = 0;
+	unsigned FBuffer = 0;
+	int FPositionAttrib = -1;
+	int FPhotometryAttrib = -1;
+	int FMVPUniform = -1;
+	int FLimitUniform = -1;
+	int FScaleUniform = -1;
+	size_t FCount = 0;
+	std::string FInfoLog;
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,1000 @@
+unit uStarNames;
+//--------------------------------------------------
+// Star name search over one compiled index
+//--------------------------------------------------
+(*
+  Star names come from three lists: data/star/IAU-CSN.txt (the IAU names,
+  fixed columns with designation, HIP, HD and J2000 position),
+  data/constellation/StarsNames.dat ("Name, HR n, ...") and
+  data/star/starnames.wiki (traditional names by HIP number).  Build merges
+  them into one star table, by HIP number where there is one and by name
+  otherwise, and files every star under all its keys:
+
+    names and aliases          sirius, alnair, achird, ...
+    catalog numbers            hr2491, hd48915, hip32349
+    designations               gj699, xo5, psrb063317
+    Bayer and Flamsteed        alfcma, alphacma, tet01eri, theta1eri, 61cyg
+
+  Keys are normalised: lowercase ASCII letters and digits only, diacritics
+  folded (Aldebarān -> aldebaran) and Greek letters spelled out, so what is
+  typed matches however the lists wrote it.
+
+  The keys form a trie stored as flat arrays.  Nodes are numbered in
+  depth-first order and so are the postings (the stars under each key), so
+  every node's subtree owns one contiguous run of postings: a prefix query
+  walks down Length(Query) nodes and reads its run.  Typo-tolerant queries
+  walk the trie with one Damerau-Levenshtein row per depth and give up on a
+  branch once every entry of its row exceeds the edit budget.
+
+  LoadOrBuild keeps the compiled index next to the sources, tied to them by
+  a hash, so the text files are only parsed again when one of them changes.
+  Queries share scratch arrays: use an index from one thread at a time.
+*)
+
+interface
+
+uses
+  System.Classes,
+  System.SysUtils,
+  System.Generics.Collections;
+
+type
+  TStarName = record
+    Name: string;          // as the IAU writes it, diacritics included
+    Aliases: string;       // other names, comma separated
+    Bayer: string;         // 'θ1 Eri', '61 Cyg', 'V2500 Oph'
+    Designation: string;   // 'HR 897', 'GJ 699', 'XO-5'
+    Constellation: string; // IAU abbreviation
+    HIP, HD, HR: Integer;  // 0 when unknown
+    RA, Dec: Single;       // J2000 degrees, NaN when unknown
+    Magnitude: Single;     // V, NaN when unknown
+    function HasPosition: Boolean;
+  end;
+
+  TStarNameMatch = record
+    Star: Integer;     // into TStarNameIndex.Stars
+    Distance: Integer; // edits between the query and the key
+    Exact: Boolean;    // the whole key matched, not only a prefix of it
+  end;
+
+  TStarNameIndex = class
+  private type
+    TNode = packed record
+      Ch: Char;
+      FirstChild, NextSibling: Integer;   // -1 = none
+      // postings [PostFirst, OwnEnd) end here, [PostFirst, PostEnd) below
+      PostFirst, OwnEnd, PostEnd: Integer;
+    end;
+    TKeyPosting = record
+      Key: string;
+      Star: Integer;
+    end;
+  private
+    FStars: TList<TStarName>;
+    FNodes: TArray<TNode>;
+    FPostings: TArray<Integer>;
+    FKeyCount: Integer;
+    FSourceHash: UInt64;
+    // Build only
+    FKeys: TList<TKeyPosting>;
+    FByHip: TDictionary<Integer, Integer>;
+    FByName: TDictionary<string, Integer>;
+    FNodeCount: Integer;
+    FPostCount: Integer;
+    // query scratch, one slot per star
+    FStamp: TArray<Integer>;
+    FSlot: TArray<Integer>;
+    FQueryNo: Integer;
+    function GetStar(Index: Integer): TStarName;
+    function GetStarCount: Integer;
+    function AddStar(const Star: TStarName): Integer;
+    procedure AddKey(const Key: string; Star: Integer);
+    procedure AddAlias(Star: Integer; const Name: string);
+    procedure ReadIauCsn(const FileName: string);
+    procedure ReadStarsNames(const FileName: string);
+    procedure ReadWiki(const FileName: string);
+    function BuildNode(Ch: Char; Depth, Lo, Hi: Integer): Integer;
+    procedure BuildTrie;
+    procedure NewQuery;
+    procedure Collect(Node, Distance: Integer; Found: TList<TStarNameMatch>);
+    function Ranked(Found: TList<TStarNameMatch>; MaxResults: Integer): TArray<TStarNameMatch>;
+  public
+    constructor Create;
+    destructor Destroy; override;
+    class function Normalize(const S: string): string;
+    // Missing files are skipped; False when none could be read
+    function Build(const IauCsnFile, StarsNamesFile, WikiFile: string): Boolean;
+    procedure SaveToFile(const FileName: string);
+    // False (and the index unchanged) when the file is missing, damaged or
+    // was built from other sources
+    function LoadFromFile(const FileName: string; SourceHash: UInt64): Boolean;
+    procedure LoadOrBuild(const IndexFile, IauCsnFile, StarsNamesFile, WikiFile: string);
+    // Stars with a key starting with Query, whole-key matches first, then
+    // brightest first
+    function Find(const Query: string; MaxResults: Integer): TArray<TStarNameMatch>;
+    // As Find, but keys within MaxEdits insertions, deletions, substitutions
+    // or swaps of Query match too, fewest edits first
+    function FindFuzzy(const Query: string; MaxEdits, MaxResults: Integer): TArray<TStarNameMatch>;
+    // FindFuzzy with an edit budget that grows with the query's length
+    function Search(const Query: string; MaxResults: Integer): TArray<TStarNameMatch>;
+    class function SourceHashOf(const Files: array of string): UInt64;
+    property Stars[Index: Integer]: TStarName read GetStar; default;
+    property StarCount: Integer read GetStarCount;
+    property KeyCount: Integer read FKeyCount;
+    property NodeCount: Integer read FNodeCount;
+    property SourceHash: UInt64 read FSourceHash;
+  end;
+
+//==========================================================================
+implementation
+//==========================================================================
+
+uses
+  System.Math,
+  System.IOUtils,
+  System.Generics.Defaults;
+
+const
+  IndexMagic = $31584E53; // 'SNX1'
+
+  // Bayer letters as IAU-CSN abbreviates them, in alphabet order
+  GreekAbbr: array [0 .. 23] of string = ('alf', 'bet', 'gam', 'del', 'eps',
+    'zet', 'eta', 'tet', 'iot', 'kap', 'lam', 'mu', 'nu', 'ksi', 'omi', 'pi',
+    'rho', 'sig', 'tau', 'ups', 'phi', 'chi', 'psi', 'ome');
+  GreekName: array [0 .. 23] of string = ('alpha', 'beta', 'gamma', 'delta',
+    'epsilon', 'zeta', 'eta', 'theta', 'iota', 'kappa', 'lambda', 'mu', 'nu',
+    'xi', 'omicron', 'pi', 'rho', 'sigma', 'tau', 'upsilon', 'phi', 'chi',
+    'psi', 'omega');
+
+  // Base letter of U+00C0..U+017F, '.' where there is none
+  LatinFold =
+    'aaaaaa.ceeeeiiiidnooooo.ouuuuyt.' + 'aaaaaa.ceeeeiiiidnooooo.ouuuuyty' +
+    'aaaaaaccccccccddddeeeeeeeeeegggg' + 'gggghhhhiiiiiiiiii..jjkkklllllll' +
+    'lllnnnnnn.nnoooooo..rrrrrrssssss' + 'ssttttttuuuuuuuuuuuuwwyyyzzzzzz.';
+
+  // Columns of IAU-CSN.txt (1-based start, width)
+  CsnName = 19;        CsnNameLen = 18;  // the diacritics form
+  CsnDesignation = 37; CsnDesignationLen = 13;
+  CsnId = 50;          CsnIdLen = 6;
+  CsnIdGreek = 56;     CsnIdGreekLen = 6;
+  CsnCon = 62;         CsnConLen = 4;
+  CsnMag = 82;         CsnMagLen = 6;
+  CsnHip = 91;         CsnHipLen = 7;
+  CsnHd = 98;          CsnHdLen = 7;
+  CsnRA = 105;         CsnRALen = 11;
+  CsnDec = 116;        CsnDecLen = 11;
+
+function TStarName.HasPosition: Boolean;
+begin
+  Result := not IsNan(RA) and not IsNan(Dec);
+end;
+
+//-----------------------------------------------------------------------
+
+function GreekIndex(const Abbr: string): Integer;
+var
+  I: Integer;
+begin
+  for I := 0 to High(GreekAbbr) do
+    if GreekAbbr[I] = Abbr then
+      Exit(I);
+  Result := -1;
+end;
+
+//-----------------------------------------------------------------------
+
+// '_' is IAU-CSN's empty field
+function CsnField(const Line: string; Start, Len: Integer): string;
+begin
+  Result := Trim(Copy(Line, Start, Len));
+  if Result = '_' then
+    Result := '';
+end;
+
+//-----------------------------------------------------------------------
+
+function CsnFloat(const Line: string; Start, Len: Integer): Single;
+begin
+  Result := StrToFloatDef(CsnField(Line, Start, Len), NaN, TFormatSettings.Invariant);
+end;
+
+//-----------------------------------------------------------------------
+
+function NewStar(const Name: string): TStarName;
+begin
+  Result := Default(TStarName);
+  Result.Name := Name;
+  Result.RA := NaN;
+  Result.Dec := NaN;
+  Result.Magnitude := NaN;
+end;
+
+//-----------------------------------------------------------------------
+
+// Ranking magnitude: stars of unknown brightness last
+function SortMagnitude(const Star: TStarName): Single;
+begin
+  if IsNan(Star.Magnitude) then
+    Result := 99
+  else
+    Result := Star.Magnitude;
+end;
+
+//-----------------------------------------------------------------------
+
+constructor TStarNameIndex.Create;
+begin
+  inherited;
+  FStars := TList<TStarName>.Create;
+  SetLength(FNodes, 1);
+  FNodes[0].FirstChild := -1;
+  FNodes[0].NextSibling := -1;
+  FNodeCount := 1;
+end;
+
+//-----------------------------------------------------------------------
+
+destructor TStarNameIndex.Destroy;
+begin
+  FStars.Free;
+  inherited;
+end;
+
+//-----------------------------------------------------------------------
+
+function TStarNameIndex.GetStar(Index: Integer): TStarName;
+begin
+  Result := FStars[Index];
+end;
+
+//-----------------------------------------------------------------------
+
+function TStarNameIndex.GetStarCount: Integer;
+begin
+  Result := FStars.Count;
+end;
+
+//-----------------------------------------------------------------------
+
+class function TStarNameIndex.Normalize(const S: string): string;
+var
+  Buf: string;
+  Len: Integer;
+
+  procedure Append(const Part: string);
+  var
+    P: Char;
+  begin
+    for P in Part do
+    begin
+      Inc(Len);
+      if Len > Length(Buf) then
+        SetLength(Buf, 2 * Len);
+      Buf[Len] := P;
+    end;
+  end;
+
+var
+  C: Char;
+  Code: Integer;
+begin
+  SetLength(Buf, Length(S));
+  Len := 0;
+  for C in S do
+  begin
+    Code := Ord(C);
+    case Code of
+      Ord('a') .. Ord('z'), Ord('0') .. Ord('9'):
+        Append(C);
+      Ord('A') .. Ord('Z'):
+        Append(Char(Code + 32));
+      $DF:
+        Append('ss');
+      $C6, $E6:
+        Append('ae');
+      $152, $153:
+        Append('oe');
+      $C0 .. $C5, $C7 .. $DE, $E0 .. $E5, $E7 .. $151, $154 .. $17F:
+        if LatinFold[Code - $C0 + 1] <> '.' then
+          Append(LatinFold[Code - $C0 + 1]);
+      $391 .. $3A1, $3A3 .. $3A9: // capitals, U+03A2 is unassigned
+        Append(GreekName[Code - $391 - Ord(Code > $3A2)]);
+      $3B1 .. $3C1:
+        Append(GreekName[Code - $3B1]);
+      $3C2, $3C3: // final and medial sigma
+        Append('sigma');
+      $3C4 .. $3C9:
+        Append(GreekName[Code - $3B2]);
+      $3D5: // the phi symbol
+        Append('phi');
+    end;
+  end;
+  Result := Copy(Buf, 1, Len);
+end;
+
+//-----------------------------------------------------------------------
+
+class function TStarNameIndex.SourceHashOf(const Files: array of string): UInt64;
+var
+  FileName: string;
+  Bytes: TBytes;
+  B: Byte;
+begin
+  // FNV-1a over the contents, with the length of each so a missing file
+  // and an empty one differ from their neighbours' bytes moving over
+  Result := UInt64($CBF29CE484222325);
+  for FileName in Files do
+  begin
+    if FileExists(FileName) then
+      Bytes := TFile.ReadAllBytes(FileName)
+    else
+      Bytes := nil;
+    for B in Bytes do
+      Result := (Result xor B) * UInt64($100000001B3);
+    Result := (Result xor UInt64(Length(Bytes) + 1)) * UInt64($100000001B3);
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+function TStarNameIndex.AddStar(const Star: TStarName): Integer;
+var
+  NameKey: string;
+begin
+  Result := FStars.Add(Star);
+  if Star.HIP > 0 then
+    FByHip.AddOrSetValue(Star.HIP, Result);
+  NameKey := Normalize(Star.Name);
+  if (NameKey <> '') and not FByName.ContainsKey(NameKey) then
+    FByName.Add(NameKey, Result);
+  AddKey(NameKey, Result);
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TStarNameIndex.AddKey(const Key: string; Star: Integer);
+var
+  Posting: TKeyPosting;
+begin
+  if Key = '' then
+    Exit;
+  Posting.Key := Key;
+  Posting.Star := Star;
+  FKeys.Add(Posting);
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TStarNameIndex.AddAlias(Star: Integer; const Name: string);
+var
+  Entry: TStarName;
+  Key: string;
+begin
+  Key := Normalize(Name);
+  Entry := FStars[Star];
+  if (Key = '') or (Key = Normalize(Entry.Name)) then
+    Exit;
+  if Pos(Name, Entry.Aliases) = 0 then
+  begin
+    if Entry.Aliases <> '' then
+      Entry.Aliases := Entry.Aliases + ', ';
+    Entry.Aliases := Entry.Aliases + Name;
+    FStars[Star] := Entry;
+  end;
+  if not FByName.ContainsKey(Key) then
+    FByName.Add(Key, Star);
+  AddKey(Key, Star);
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TStarNameIndex.ReadIauCsn(const FileName: string);
+var
+  Lines: TStringList;
+  Line, Id, Letters, Digits, Con: string;
+  Star: TStarName;
+  Index, Greek, I: Integer;
+begin
+  Lines := TStringList.Create;
+  try
+    Lines.LoadFromFile(FileName, TEncoding.UTF8);
+    for Line in Lines do
+    begin
+      if (Length(Line) < CsnDec + CsnDecLen - 1) or (Line[1] = '#') then
+        Continue;
+      Star := NewStar(CsnField(Line, CsnName, CsnNameLen));
+      Star.RA := CsnFloat(Line, CsnRA, CsnRALen);
+      Star.Dec := CsnFloat(Line, CsnDec, CsnDecLen);
+      if not Star.HasPosition then // header and notes
+        Continue;
+      Star.Designation := CsnField(Line, CsnDesignation, CsnDesignationLen);
+      Star.Constellation := CsnField(Line, CsnCon, CsnConLen);
+      Star.HIP := StrToIntDef(CsnField(Line, CsnHip, CsnHipLen), 0);
+      Star.HD := StrToIntDef(CsnField(Line, CsnHd, CsnHdLen), 0);
+      if Star.HD = 999999 then // placeholder for no HD number
+        Star.HD := 0;
+      if Star.Designation.StartsWith('HR ') then
+        Star.HR := StrToIntDef(Copy(Star.Designation, 4, MaxInt), 0);
+      Star.Magnitude := CsnFloat(Line, CsnMag, CsnMagLen);
+
+      // alf, tet01, 61, V2500, Y; the Greek column spells alf as α
+      Id := CsnField(Line, CsnId, CsnIdLen);
+      Con := LowerCase(Star.Constellation);
+      if (Id <> '') and (Con <> '') then
+      begin
+        Star.Bayer := CsnField(Line, CsnIdGreek, CsnIdGreekLen);
+        if Star.Bayer = '' then
+          Star.Bayer := Id;
+        Star.Bayer := Star.Bayer + ' ' + Star.Constellation;
+      end;
+
+      Index := AddStar(Star);
+      AddKey(Normalize(CsnField(Line, 1, CsnNameLen)), Index);
+      AddKey(Normalize(Star.Designation), Index);
+      if Star.HIP > 0 then
+        AddKey('hip' + IntToStr(Star.HIP), Index);
+      if Star.HD > 0 then
+        AddKey('hd' + IntToStr(Star.HD), Index);
+      if (Id = '') or (Con = '') then
+        Continue;
+
+      I := 1;
+      while (I <= Length(Id)) and not CharInSet(Id[I], ['0' .. '9']) do
+        Inc(I);
+      Letters := Copy(Id, 1, I - 1);
+      Digits := Copy(Id, I, MaxInt);
+      Greek := GreekIndex(Letters);
+      if Greek < 0 then
+      begin
+        AddKey(Normalize(Id) + Con, Index); // Flamsteed or variable
+        Continue;
+      end;
+      // tet01 Eri: tet01eri, tet1eri, theta1eri, and teteri, thetaeri
+      // for whoever leaves the superscript out
+      AddKey(Letters + Digits + Con, Index);
+      AddKey(GreekName[Greek] + Digits + Con, Index);
+      if Digits <> '' then
+      begin
+        Digits := IntToStr(StrToIntDef(Digits, 0));
+        AddKey(Letters + Digits + Con, Index);
+        AddKey(GreekName[Greek] + Digits + Con, Index);
+        AddKey(Letters + Con, Index);
+        AddKey(GreekName[Greek] + Con, Index);
+      end;
+    end;
+  finally
+    Lines.Free;
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TStarNameIndex.ReadStarsNames(const FileName: string);
+var
+  Lines, Fields: TStringList;
+  Line, Id: string;
+  Star: TStarName;
+  Index, I, Number: Integer;
+begin
+  Lines := TStringList.Create;
+  Fields := TStringList.Create;
+  try
+    Lines.LoadFromFile(FileName, TEncoding.UTF8);
+    Fields.StrictDelimiter := True;
+    // Name, HR n[, other designations]
+    for Line in Lines do
+    begin
+      Fields.CommaText := Line;
+      if (Fields.Count = 0) or (Trim(Fields[0]) = '') then
+        Continue;
+      if not FByName.TryGetValue(Normalize(Fields[0]), Index) then
+      begin
+        Star := NewStar(Trim(Fields[0]));
+        if Fields.Count > 1 then
+          Star.Designation := Trim(Fields[1]);
+        Index := AddStar(Star);
+      end;
+      for I := 1 to Fields.Count - 1 do
+      begin
+        Id := Trim(Fields[I]);
+        AddKey(Normalize(Id), Index);
+        Star := FStars[Index];
+        if Id.StartsWith('HR ') and TryStrToInt(Copy(Id, 4, MaxInt), Number) and
+          (Star.HR = 0) then
+          Star.HR := Number
+        else if Id.StartsWith('HD ') and TryStrToInt(Copy(Id, 4, MaxInt), Number) and
+          (Star.HD = 0) then
+          Star.HD := Number
+        else
+          Continue;
+        FStars[Index] := Star;
+      end;
+    end;
+  finally
+    Fields.Free;
+    Lines.Free;
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TStarNameIndex.ReadWiki(const FileName: string);
+var
+  Lines: TStringList;
+  Line, Name, Con: string;
+  Star: TStarName;
+  Bar, First, Last, Hip, Index: Integer;
+begin
+  Lines := TStringList.Create;
+  try
+    Lines.LoadFromFile(FileName, TEncoding.UTF8);
+    // # Andromeda (And)
+    //    677|_("Alpheratz") 1,2,5,6,11,12
+    for Line in Lines do
+    begin
+      if Line.StartsWith('#') then
+      begin
+        First := Pos('(', Line);
+        Last := Pos(')', Line);
+        if (First > 0) and (Last > First) then
+          Con := Copy(Line, First + 1, Last - First - 1);
+        Continue;
+      end;
+      Bar := Pos('|', Line);
+      First := Pos('_("', Line);
+      Last := Pos('")', Line);
+      if (Bar = 0) or (First = 0) or (Last < First) then
+        Continue;
+      Hip := StrToIntDef(Trim(Copy(Line, 1, Bar - 1)), 0);
+      Name := Copy(Line, First + 3, Last - First - 3);
+      if (Hip > 0) and FByHip.TryGetValue(Hip, Index) then
+        AddAlias(Index, Name)
+      else if FByName.TryGetValue(Normalize(Name), Index) then
+      begin
+        Star := FStars[Index];
+        if (Star.HIP = 0) and (Hip > 0) then
+        begin
+          Star.HIP := Hip;
+          FStars[Index] := Star;
+          FByHip.AddOrSetValue(Hip, Index);
+          AddKey('hip' + IntToStr(Hip), Index);
+        end;
+      end
+      else
+      begin
+        Star := NewStar(Name);
+        Star.HIP := Hip;
+        Star.Constellation := Con;
+        Index := AddStar(Star);
+        if Hip > 0 then
+          AddKey('hip' + IntToStr(Hip), Index);
+      end;
+    end;
+  finally
+    Lines.Free;
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+// FKeys[Lo..Hi) are sorted and share their first Depth characters
+function TStarNameIndex.BuildNode(Ch: Char; Depth, Lo, Hi: Integer): Integer;
+var
+  I, J, Child, Prev: Integer;
+begin
+  Result := FNodeCount;
+  Inc(FNodeCount);
+  FNodes[Result].Ch := Ch;
+  FNodes[Result].FirstChild := -1;
+  FNodes[Result].NextSibling := -1;
+  FNodes[Result].PostFirst := FPostCount;
+  // a key that ends here sorts before the longer ones
+  I := Lo;
+  while (I < Hi) and (Length(FKeys[I].Key) = Depth) do
+  begin
+    FPostings[FPostCount] := FKeys[I].Star;
+    Inc(FPostCount);
+    Inc(I);
+  end;
+  FNodes[Result].OwnEnd := FPostCount;
+  Prev := -1;
+  while I < Hi do
+  begin
+    J := I + 1;
+    while (J < Hi) and (FKeys[J].Key[Depth + 1] = FKeys[I].Key[Depth + 1]) do
+      Inc(J);
+    Child := BuildNode(FKeys[I].Key[Depth + 1], Depth + 1, I, J);
+    if Prev < 0 then
+      FNodes[Result].FirstChild := Child
+    else
+      FNodes[Prev].NextSibling := Child;
+    Prev := Child;
+    I := J;
+  end;
+  FNodes[Result].PostEnd := FPostCount;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TStarNameIndex.BuildTrie;
+var
+  Unique: TList<TKeyPosting>;
+  Posting: TKeyPosting;
+  Chars: Integer;
+begin
+  FKeys.Sort(TComparer<TKeyPosting>.Construct(
+    function(const A, B: TKeyPosting): Integer
+    begin
+      Result := CompareStr(A.Key, B.Key);
+      if Result = 0 then
+        Result := A.Star - B.Star;
+    end));
+  // one posting per key and star
+  Unique := TList<TKeyPosting>.Create;
+  try
+    Chars := 0;
+    for Posting in FKeys do
+      if (Unique.Count = 0) or (Unique.Last.Key <> Posting.Key) or
+        (Unique.Last.Star <> Posting.Star) then
+      begin
+        Unique.Add(Posting);
+        Inc(Chars, Length(Posting.Key));
+      end;
+    FKeys.Clear;
+    FKeys.AddRange(Unique);
+  finally
+    Unique.Free;
+  end;
+
+  FKeyCount := FKeys.Count;
+  SetLength(FNodes, Chars + 1); // no more nodes than key characters
+  SetLength(FPostings, FKeys.Count);
+  FNodeCount := 0;
+  FPostCount := 0;
+  BuildNode(#0, 0, 0, FKeys.Count);
+  SetLength(FNodes, FNodeCount);
+end;
+
+//-----------------------------------------------------------------------
+
+function TStarNameIndex.Build(const IauCsnFile, StarsNamesFile, WikiFile: string): Boolean;
+begin
+  FStars.Clear;
+  FKeys := TList<TKeyPosting>.Create;
+  FByHip := TDictionary<Integer, Integer>.Create;
+  FByName := TDictionary<string, Integer>.Create;
+  try
+    // IAU first: its names and positions win
+    if FileExists(IauCsnFile) then
+      ReadIauCsn(IauCsnFile);
+    if FileExists(StarsNamesFile) then
+      ReadStarsNames(StarsNamesFile);
+    if FileExists(WikiFile) then
+      ReadWiki(WikiFile);
+    BuildTrie;
+  finally
+    FreeAndNil(FKeys);
+    FreeAndNil(FByHip);
+    FreeAndNil(FByName);
+  end;
+  FSourceHash := SourceHashOf([IauCsnFile, StarsNamesFile, WikiFile]);
+  SetLength(FStamp, 0);
+  Result := FStars.Count > 0;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TStarNameIndex.SaveToFile(const FileName: string);
+var
+  Writer: TBinaryWriter;
+  Star: TStarName;
+begin
+  Writer := TBinaryWriter.Create(FileName, False, TEncoding.UTF8);
+  try
+    Writer.Write(Cardinal(IndexMagic));
+    Writer.Write(FSourceHash);
+    Writer.Write(FStars.Count);
+    for Star in FStars do
+    begin
+      Writer.Write(Star.Name);
+      Writer.Write(Star.Aliases);
+      Writer.Write(Star.Bayer);
+      Writer.Write(Star.Designation);
+      Writer.Write(Star.Constellation);
+      Writer.Write(Star.HIP);
+      Writer.Write(Star.HD);
+      Writer.Write(Star.HR);
+      Writer.Write(Star.RA);
+      Writer.Write(Star.Dec);
+      Writer.Write(Star.Magnitude);
+    end;
+    Writer.Write(FKeyCount);
+    Writer.Write(Length(FNodes));
+    Writer.Write(Length(FPostings));
+    Writer.BaseStream.WriteBuffer(FNodes[0], Length(FNodes) * SizeOf(TNode));
+    if Length(FPostings) > 0 then
+      Writer.BaseStream.WriteBuffer(FPostings[0], Length(FPostings) * SizeOf(Integer));
+  finally
+    Writer.Free;
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+function TStarNameIndex.LoadFromFile(const FileName: string; SourceHash: UInt64): Boolean;
+var
+  Reader: TBinaryReader;
+  Stars: TList<TStarName>;
+  Star: TStarName;
+  Nodes: TArray<TNode>;
+  Postings: TArray<Integer>;
+  I, Count, Keys, NodeCount, PostingCount: Integer;
+begin
+  Result := False;
+  if not FileExists(FileName) then
+    Exit;
+  Stars := TList<TStarName>.Create;
+  try
+    try
+      Reader := TBinaryReader.Create(FileName, TEncoding.UTF8);
+      try
+        if (Reader.ReadCardinal <> IndexMagic) or (Reader.ReadUInt64 <> SourceHash) then
+          Exit;
+        Count := Reader.ReadInteger;
+        for I := 0 to Count - 1 do
+        begin
+          Star.Name := Reader.ReadString;
+          Star.Aliases := Reader.ReadString;
+          Star.Bayer := Reader.ReadString;
+          Star.Designation := Reader.ReadString;
+          Star.Constellation := Reader.ReadString;
+          Star.HIP := Reader.ReadInteger;
+          Star.HD := Reader.ReadInteger;
+          Star.HR := Reader.ReadInteger;
+          Star.RA := Reader.ReadSingle;
+          Star.Dec := Reader.ReadSingle;
+          Star.Magnitude := Reader.ReadSingle;
+          Stars.Add(Star);
+        end;
+        Keys := Reader.ReadInteger;
+        NodeCount := Reader.ReadInteger;
+        PostingCount := Reader.ReadInteger;
+        // sizes that don't fit what is left of the file are corrupt
+        if (NodeCount <= 0) or (PostingCount < 0) or
+          (Int64(NodeCount) * SizeOf(TNode) + Int64(PostingCount) * SizeOf(Integer) >
+          Reader.BaseStream.Size - Reader.BaseStream.Position) then
+          Exit;
+        SetLength(Nodes, NodeCount);
+        SetLength(Postings, PostingCount);
+        Reader.BaseStream.ReadBuffer(Nodes[0], Length(Nodes) * SizeOf(TNode));
+        if Length(Postings) > 0 then
+          Reader.BaseStream.ReadBuffer(Postings[0], Length(Postings) * SizeOf(Integer));
+      finally
+        Reader.Free;
+      end;
+    except
+      on EStreamError do
+        Exit; // unreadable or truncated
+      on EEncodingError do
+        Exit;
+    end;
+    // postings must point at stars
+    for I := 0 to High(Postings) do
+      if (Postings[I] < 0) or (Postings[I] >= Stars.Count) then
+        Exit;
+    // Links must stay inside the trie and, as BuildNode numbers nodes
+    // depth first, point forward, so no walk can loop; runs must stay
+    // inside the postings
+    for I := 0 to High(Nodes) do
+      with Nodes[I] do
+        if ((FirstChild <> -1) and ((FirstChild <= I) or (FirstChild > High(Nodes)))) or
+          ((NextSibling <> -1) and ((NextSibling <= I) or (NextSibling > High(Nodes)))) or
+          (PostFirst < 0) or (OwnEnd < PostFirst) or (PostEnd < OwnEnd) or
+          (PostEnd > Length(Postings)) then
+          Exit;
+    FStars.Clear;
+    FStars.AddRange(Stars);
+    FNodes := Nodes;
+    FNodeCount := Length(Nodes);
+    FPostings := Postings;
+    FKeyCount := Keys;
+    FSourceHash := SourceHash;
+    SetLength(FStamp, 0);
+    Result := True;
+  finally
+    Stars.Free;
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TStarNameIndex.LoadOrBuild(const IndexFile, IauCsnFile, StarsNamesFile,
+  WikiFile: string);
+begin
+  if LoadFromFile(IndexFile, SourceHashOf([IauCsnFile, StarsNamesFile, WikiFile])) then
+    Exit;
+  if Build(IauCsnFile, StarsNamesFile, WikiFile) then
+    try
+      SaveToFile(IndexFile);
+    except
+      on EStreamError do
+        ; // read-only data directory: build again next time
+    end;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TStarNameIndex.NewQuery;
+begin
+  if Length(FStamp) <> FStars.Count then
+  begin
+    SetLength(FStamp, FStars.Count);
+    SetLength(FSlot, FStars.Count);
+    FillChar(FStamp[0], Length(FStamp) * SizeOf(Integer), 0);
+    FQueryNo := 0;
+  end;
+  Inc(FQueryNo);
+end;
+
+//-----------------------------------------------------------------------
+
+// Adds the stars under Node, keeping each star's best match
+procedure TStarNameIndex.Collect(Node, Distance: Integer; Found: TList<TStarNameMatch>);
+var
+  P, Star: Integer;
+  Match: TStarNameMatch;
+begin
+  for P := FNodes[Node].PostFirst to FNodes[Node].PostEnd - 1 do
+  begin
+    Star := FPostings[P];
+    Match.Star := Star;
+    Match.Distance := Distance;
+    Match.Exact := P < FNodes[Node].OwnEnd;
+    if FStamp[Star] <> FQueryNo then
+    begin
+      FStamp[Star] := FQueryNo;
+      FSlot[Star] := Found.Add(Match);
+    end
+    else if (Distance < Found[FSlot[Star]].Distance) or
+      ((Distance = Found[FSlot[Star]].Distance) and Match.Exact and
+      not Found[FSlot[Star]].Exact) then
+      Found[FSlot[Star]] := Match;
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+function TStarNameIndex.Ranked(Found: TList<TStarNameMatch>;
+  MaxResults: Integer): TArray<TStarNameMatch>;
+begin
+  Found.Sort(TComparer<TStarNameMatch>.Construct(
+    function(const A, B: TStarNameMatch): Integer
+    begin
+      Result := A.Distance - B.Distance;
+      if Result = 0 then
+        Result := Ord(B.Exact) - Ord(A.Exact);
+      if Result = 0 then
+        Result := CompareValue(SortMagnitude(FStars.List[A.Star]),
+          SortMagnitude(FStars.List[B.Star]));
+      if Result = 0 then
+        Result := CompareText(FStars.List[A.Star].Name, FStars.List[B.Star].Name);
+    end));
+  if Found.Count > MaxResults then
+    Found.DeleteRange(MaxResults, Found.Count - MaxResults);
+  Result := Found.ToArray;
+end;
+
+//-----------------------------------------------------------------------
+
+function TStarNameIndex.Find(const Query: string; MaxResults: Integer): TArray<TStarNameMatch>;
+var
+  Key: string;
+  C: Char;
+  Node: Integer;
+  Found: TList<TStarNameMatch>;
+begin
+  Result := nil;
+  Key := Normalize(Query);
+  if (Key = '') or (FStars.Count = 0) then
+    Exit;
+  Node := 0;
+  for C in Key do
+  begin
+    Node := FNodes[Node].FirstChild;
+    while (Node >= 0) and (FNodes[Node].Ch <> C) do
+      Node := FNodes[Node].NextSibling;
+    if Node < 0 then
+      Exit;
+  end;
+  NewQuery;
+  Found := TList<TStarNameMatch>.Create;
+  try
+    Collect(Node, 0, Found);
+    Result := Ranked(Found, MaxResults);
+  finally
+    Found.Free;
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+function TStarNameIndex.FindFuzzy(const Query: string;
+  MaxEdits, MaxResults: Integer): TArray<TStarNameMatch>;
+var
+  Key, Path: string;
+  N, D: Integer;
+  Rows: TArray<TArray<Integer>>;
+  Found: TList<TStarNameMatch>;
+
+  // Rows[Depth] holds the distances from the key spelled by Path[1..Depth]
+  // to each prefix of the query
+  procedure Visit(Node, Depth: Integer);
+  var
+    Child, J, V, Best: Integer;
+    C: Char;
+  begin
+    Child := FNodes[Node].FirstChild;
+    while Child >= 0 do
+    begin
+      C := FNodes[Child].Ch;
+      Path[Depth + 1] := C;
+      Rows[Depth + 1][0] := Depth + 1;
+      Best := Depth + 1;
+      for J := 1 to N do
+      begin
+        V := Min(Rows[Depth][J], Rows[Depth + 1][J - 1]) + 1;
+        V := Min(V, Rows[Depth][J - 1] + Ord(Key[J] <> C));
+        // two neighbours swapped are one edit
+        if (Depth > 0) and (J > 1) and (Key[J] = Path[Depth]) and (Key[J - 1] = C) then
+          V := Min(V, Rows[Depth - 1][J - 2] + 1);
+        Rows[Depth + 1][J] := V;
+        Best := Min(Best, V);
+      end;
+      // the whole query is within reach: everything below completes it
+      if Rows[Depth + 1][N] <= MaxEdits then
+        Collect(Child, Rows[Depth + 1][N], Found);
+      if Best <= MaxEdits then
+        Visit(Child, Depth + 1);
+      Child := FNodes[Child].NextSibling;
+    end;
+  end;
+
+begin
+  Result := nil;
+  Key := Normalize(Query);
+  N := Length(Key);
+  if (N = 0) or (FStars.Count = 0) then
+    Exit;
+  // with N edits or more any key would do
+  MaxEdits := Max(0, Min(MaxEdits, N - 1));
+  SetLength(Rows, N + MaxEdits + 2, N + 1);
+  SetLength(Path, N + MaxEdits + 2);
+  for D := 0 to N do
+    Rows[0][D] := D;
+  NewQuery;
+  Found := TList<TStarNameMatch>.Create;
+  try
+    Visit(0, 0);
+    Result := Ranked(Found, MaxResults);
+  finally
+    Found.Free;
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+function TStarNameIndex.Search(const Query: string; MaxResults: Integer): TArray<TStarNameMatch>;
+var
+  Len: Integer;
+begin
+  // a typo in two or three letters matches half the sky
+  Len := Length(Normalize(Query));
+  if Len <= 3 then
+    Result := Find(Query, MaxResults)
+  else if Len <= 6 then
+    Result := FindFuzzy(Query, 1, MaxResults)
+  else
+    Result := FindFuzzy(Query, 2, MaxResults);
+end;
+
+end.
@@ -0,0 +1,260 @@
+//---------------------------------------------------------------------------
+
+#include "uStarOctree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+//---------------------------------------------------------------------------
+namespace
+{
+const double Pi = 3.14159265358979323846;
+const int MortonBits = 21;  // per axis, 63 in all
+
+uint64_t SpreadBits3(uint64_t v)
+{
+	v &= 0x1fffff;
+	v = (v | (v << 32)) & 0x1f00000000ffffull;
+	v = (v | (v << 16)) & 0x1f0000ff0000ffull;
+	v = (v | (v << 8)) & 0x100f00f00f00f00full;
+	v = (v | (v << 4)) & 0x10c30c30c30c30c3ull;
+	v = (v | (v << 2)) & 0x1249249249249249ull;
+	return v;
+}
+
+float Dot(const float* a, const float* b)
+{
+	return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+float DistanceSquared(const float* a, const float* b)
+{
+	const float dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+	return dx * dx + dy * dy + dz * dz;
+}
+
+// Flux floor below which a light is fainter than MaxMagnitude: apparent
+// magnitude m = -2.5 log10(L / d^2) - 5, so m <= MaxMagnitude exactly
+// when L >= Floor * d^2, which needs no logarithm per node.
+float FluxFloor(float MaxMagnitude)
+{
+	return static_cast<float>(std::pow(10., -0.4 * (MaxMagnitude + 5.)));
+}
+
+float ApparentMagnitude(float Luminosity, float DistanceSq)
+{
+	return -2.5f * std::log10(Luminosity / std::max(DistanceSq, 1e-6f)) - 5.f;
+}
+}
+
+//---------------------------------------------------------------------------
+void StarOctree::Build(const HipCatalog& Catalog, float MinParallax,
+	int LeafSize)
+{
+	FStars.clear();
+	FNodes.clear();
+	FDepth = 0;
+	const std::span<const float> Parallaxes = Catalog.Parallaxes();
+	for (uint32_t i = 0; i < Parallaxes.size(); i++)
+	{
+		const float Parallax = Parallaxes[i];
+		if (!(Parallax >= MinParallax))
+			continue;
+		const StarRecord& r = Catalog[i].Star;
+		const double RA = r.RA * (Pi / 18000.), Dec = r.DEC * (Pi / 18000.);
+		const double Distance = 1000. / Parallax;
+		Star s;
+		s.Pos[0] = static_cast<float>(Distance * std::cos(Dec) * std::cos(RA));
+		s.Pos[1] = static_cast<float>(Distance * std::cos(Dec) * std::sin(RA));
+		s.Pos[2] = static_cast<float>(Distance * std::sin(Dec));
+		// Absolute magnitude M = m + 5 log10(parallax / 1000 mas) + 5
+		const double Absolute = r.Magnitude() + 5. * std::log10(Parallax) - 10.;
+		s.Luminosity = static_cast<float>(std::pow(10., -0.4 * Absolute));
+		s.ColorIndex = r.ColorIndex();
+		s.Record = i;
+		FStars.push_back(s);
+	}
+	if (FStars.empty())
+		return;
+
+	// Morton codes within the bounding cube
+	float Lo[3], Hi[3];
+	for (int a = 0; a < 3; a++)
+	{
+		Lo[a] = Hi[a] = FStars[0].Pos[a];
+		for (const Star& s : FStars)
+		{
+			Lo[a] = std::min(Lo[a], s.Pos[a]);
+			Hi[a] = std::max(Hi[a], s.Pos[a]);
+		}
+	}
+	const float Size = std::max({Hi[0] - Lo[0], Hi[1] - Lo[1], Hi[2] - Lo[2], 1e-3f});
+	const double Scale = ((1 << MortonBits) - 1) / static_cast<double>(Size);
+	std::vector<uint64_t> Codes(FStars.size());
+	for (size_t i = 0; i < FStars.size(); i++)
+	{
+		uint64_t Code = 0;
+		for (int a = 0; a < 3; a++)
+			Code |= SpreadBits3(static_cast<uint64_t>((FStars[i].Pos[a] - Lo[a]) * Scale))
+				<< (2 - a);
+		Codes[i] = Code;
+	}
+	std::vector<uint32_t> Order(FStars.size());
+	std::iota(Order.begin(), Order.end(), 0u);
+	std::sort(Order.begin(), Order.end(),
+		[&Codes](uint32_t a, uint32_t b) { return Codes[a] < Codes[b]; });
+	std::vector<Star> Sorted(FStars.size());
+	std::vector<uint64_t> SortedCodes(FStars.size());
+	for (size_t i = 0; i < Order.size(); i++)
+	{
+		Sorted[i] = FStars[Order[i]];
+		SortedCodes[i] = Codes[Order[i]];
+	}
+	FStars.swap(Sorted);
+
+	FNodes.emplace_back();
+	BuildNode(0, 0, static_cast<uint32_t>(FStars.size()), 0, SortedCodes,
+		std::max(LeafSize, 1));
+}
+//---------------------------------------------------------------------------
+void StarOctree::BuildNode(uint32_t Index, uint32_t First, uint32_t Last,
+	int Level, const std::vector<uint64_t>& Codes, int LeafSize)
+{
+	FDepth = std::max(FDepth, Level + 1);
+	Node n;
+	n.First = First;
+	n.Last = Last;
+	n.FirstChild = 0;
+	n.ChildCount = 0;
+	n.Luminosity = 0;
+	n.ColorIndex = 0;
+	double Centroid[3] = {0, 0, 0}, Color = 0, Light = 0;
+	for (int a = 0; a < 3; a++)
+	{
+		n.Min[a] = FStars[First].Pos[a];
+		n.Max[a] = FStars[First].Pos[a];
+	}
+	for (uint32_t i = First; i < Last; i++)
+	{
+		const Star& s = FStars[i];
+		for (int a = 0; a < 3; a++)
+		{
+			n.Min[a] = std::min(n.Min[a], s.Pos[a]);
+			n.Max[a] = std::max(n.Max[a], s.Pos[a]);
+			Centroid[a] += s.Luminosity * s.Pos[a];
+		}
+		Color += s.Luminosity * s.ColorIndex;
+		Light += s.Luminosity;
+	}
+	for (int a = 0; a < 3; a++)
+		n.Centroid[a] = static_cast<float>(Light > 0 ? Centroid[a] / Light
+			: 0.5 * (n.Min[a] + n.Max[a]));
+	n.Luminosity = static_cast<float>(Light);
+	n.ColorIndex = static_cast<float>(Light > 0 ? Color / Light : 0);
+	FNodes[Index] = n;
+	if (Last - First <= static_cast<uint32_t>(LeafSize) || Level == MortonBits)
+		return;
+
+	// Children are the runs sharing the next three code bits
+	const int Shift = 3 * (MortonBits - 1 - Level);
+	uint32_t Bounds[9];
+	uint32_t Count = 0;
+	for (uint32_t i = First; i < Last;)
+	{
+		const uint64_t CellLast = Codes[i] | ((1ull << Shift) - 1);
+		const uint32_t End = static_cast<uint32_t>(std::upper_bound(
+			Codes.begin() + i, Codes.begin() + Last, CellLast) - Codes.begin());
+		Bounds[Count++] = i;
+		i = End;
+	}
+	Bounds[Count] = Last;
+	if (Count == 1)
+	{
+		// Everything in one octant: skip the level rather than add a node
+		BuildNode(Index, First, Last, Level + 1, Codes, LeafSize);
+		return;
+	}
+	const uint32_t FirstChild = static_cast<uint32_t>(FNodes.size());
+	FNodes[Index].FirstChild = FirstChild;
+	FNodes[Index].ChildCount = Count;
+	FNodes.resize(FNodes.size() + Count);
+	for (uint32_t c = 0; c < Count; c++)
+		BuildNode(FirstChild + c, Bounds[c], Bounds[c + 1], Level + 1, Codes,
+			LeafSize);
+}
+//---------------------------------------------------------------------------
+void StarOctree::Query(const float* Eye, float LodAngle, float MaxMagnitude,
+	const SkyPlane* Planes, int PlaneCount, std::vector<SpaceLight>& Out) const
+{
+	if (FNodes.empty())
+		return;
+	const float Floor = FluxFloor(MaxMagnitude);
+	std::vector<uint32_t> Stack;
+	Stack.reserve(8 * FDepth + 1);
+	Stack.push_back(0);
+	while (!Stack.empty())
+	{
+		const Node& n = FNodes[Stack.back()];
+		Stack.pop_back();
+
+		// Nearest point of the bounds; the eye may be inside
+		float Nearest[3];
+		for (int a = 0; a < 3; a++)
+			Nearest[a] = std::clamp(Eye[a], n.Min[a], n.Max[a]);
+		const float NearSq = DistanceSquared(Eye, Nearest);
+		if (n.Luminosity < Floor * NearSq)
+			continue;
+		// Corners farthest and nearest along each plane's normal
+		bool Outside = false, Inside = true;
+		for (int p = 0; p < PlaneCount && !Outside; p++)
+		{
+			float Far = Planes[p].D, Near = Planes[p].D;
+			for (int a = 0; a < 3; a++)
+			{
+				const bool Up = Planes[p].Normal[a] >= 0;
+				Far += Planes[p].Normal[a] * (Up ? n.Max[a] : n.Min[a]);
+				Near += Planes[p].Normal[a] * (Up ? n.Min[a] : n.Max[a]);
+			}
+			Outside = Far < 0;
+			Inside = Inside && Near >= 0;
+		}
+		if (Outside)
+			continue;
+
+		if (NearSq > 0)
+		{
+			const float CentroidSq = DistanceSquared(Eye, n.Centroid);
+			const float HalfDiagonalSq = 0.25f * DistanceSquared(n.Min, n.Max);
+			if (HalfDiagonalSq < LodAngle * LodAngle * CentroidSq)
+			{
+				if (n.Luminosity >= Floor * CentroidSq)
+					Out.push_back({{n.Centroid[0], n.Centroid[1], n.Centroid[2]},
+						ApparentMagnitude(n.Luminosity, CentroidSq), n.ColorIndex,
+						NoStar, n.Last - n.First});
+				continue;
+			}
+		}
+		if (n.ChildCount > 0)
+		{
+			for (uint32_t c = 0; c < n.ChildCount; c++)
+				Stack.push_back(n.FirstChild + c);
+			continue;
+		}
+		for (uint32_t i = n.First; i < n.Last; i++)
+		{
+			const Star& s = FStars[i];
+			const float DistanceSq = DistanceSquared(Eye, s.Pos);
+			if (s.Luminosity < Floor * DistanceSq)
+				continue;
+			bool Visible = true;
+			for (int p = 0; p < PlaneCount && !Inside && Visible; p++)
+				Visible = Dot(Planes[p].Normal, s.Pos) + Planes[p].D >= 0;
+			if (Visible)
+				Out.push_back({{s.Pos[0], s.Pos[1], s.Pos[2]},
+					ApparentMagnitude(s.Luminosity, DistanceSq), s.ColorIndex,
+					s.Record, 1});
+		}
+	}
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,97 @@
+//---------------------------------------------------------------------------
+// The solar neighbourhood in 3D: stars placed by their Hipparcos
+// parallaxes in an octree that keeps the summed light of each node, for
+// flying through at interactive rates.
+//
+// Positions are parsecs from the Sun on the equatorial axes (x to RA 0,
+// z to the north pole), the same axes as the sky vectors.  Stars are
+// ordered along a Morton curve, so every node owns one contiguous run of
+// them and the tree needs no per-star pointers, much as SkyIndex does on
+// the sphere.  Stars are points, so a loose octree's enlarged cells would
+// buy nothing.  Instead each node keeps the tight bounds of what it holds,
+// which are usually smaller than its cell, plus the summed luminosity and
+// the light-weighted centroid and colour of its stars.
+//
+// Query() walks from the root with the eye anywhere in the tree:
+//   - nodes that could not reach MaxMagnitude even at their nearest
+//     point, or that lie outside the frustum, are dropped;
+//   - nodes that look smaller than LodAngle come back as one impostor
+//     with the node's summed light at its centroid;
+//   - only the rest open up, down to single stars.
+// The output size therefore follows the screen rather than the catalog.
+//
+// The parallaxes come only from hip_main.dat (see uHipCatalog.h), which is
+// not in the tree; built from a catalog without it, the tree is empty.
+//---------------------------------------------------------------------------
+
+#ifndef uStarOctreeH
+#define uStarOctreeH
+
+#include <cstdint>
+#include <vector>
+
+#include "uHipCatalog.h"
+#include "uSkyIndex.h"
+
+//---------------------------------------------------------------------------
+// One light to draw: a star, or a whole node seen from afar.
+struct SpaceLight
+{
+	float Pos[3];        // parsecs
+	float Magnitude;     // apparent, from the eye
+	float ColorIndex;    // B-V
+	uint32_t Record;     // into the catalog, StarOctree::NoStar for a node
+	uint32_t Count;      // stars it stands for
+};
+
+//---------------------------------------------------------------------------
+class StarOctree
+{
+public:
+	static constexpr uint32_t NoStar = 0xffffffffu;
+
+	// Stars with a parallax under MinParallax (mas) are too far, or
+	// measured too poorly, to place; 1 mas is 1 kpc.
+	void Build(const HipCatalog& Catalog, float MinParallax = 1.f,
+		int LeafSize = 16);
+
+	// Eye in parsecs.  LodAngle in radians, e.g. a few pixels' worth;
+	// 0 opens every node.  Planes as SkyIndex::QueryFrustum, but with
+	// the eye off the origin their D is no longer zero; null for none.
+	void Query(const float* Eye, float LodAngle, float MaxMagnitude,
+		const SkyPlane* Planes, int PlaneCount,
+		std::vector<SpaceLight>& Out) const;
+
+	size_t StarCount() const { return FStars.size(); }
+	size_t NodeCount() const { return FNodes.size(); }
+	int Depth() const { return FDepth; }
+
+private:
+	struct Star
+	{
+		float Pos[3];
+		float Luminosity;    // relative to absolute magnitude 0
+		float ColorIndex;
+		uint32_t Record;
+	};
+	struct Node
+	{
+		float Min[3], Max[3];  // bounds of its stars
+		float Centroid[3];     // light-weighted
+		float Luminosity;
+		float ColorIndex;      // light-weighted
+		uint32_t First, Last;  // star range in FStars
+		uint32_t FirstChild;   // children are contiguous; 0 for a leaf
+		uint32_t ChildCount;
+	};
+
+	void BuildNode(uint32_t Index, uint32_t First, uint32_t Last, int Level,
+		const std::vector<uint64_t>& Codes, int LeafSize);
+
+	std::vector<Star> FStars;  // in Morton order
+	std::vector<Node> FNodes;  // FNodes[0] is the root
+	int FDepth = 0;
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,85 @@
+//---------------------------------------------------------------------------
+
+#include "uStarPicker.h"
+
+#include <cmath>
+
+#include "precess.h"
+
+//---------------------------------------------------------------------------
+namespace
+{
+const double Pi = 3.14159265358979323846;
+}
+
+//---------------------------------------------------------------------------
+StarPicker::StarPicker()
+{
+	FGrid.width = FGrid.height = 0;
+	FGrid.cells = nullptr;
+	FGrid.n_mixed = 0;
+	FGrid.n_coarse = 0;
+	setup_precession(FToB1875, EPOCH_J2000, EPOCH_B1875);
+}
+//---------------------------------------------------------------------------
+StarPicker::~StarPicker()
+{
+	constellation_grid_free(&FGrid);
+}
+//---------------------------------------------------------------------------
+bool StarPicker::Init(const SkyIndex& Index, std::span<const StarRecord> Stars,
+	int GridHeight)
+{
+	FIndex = &Index;
+	FStars = Stars;
+	constellation_grid_free(&FGrid);
+	// Boundary cells stay CONSTELL_IDX_NONE so lookups there are exact.
+	return constellation_grid_build(&FGrid, GridHeight, 0) == 0;
+}
+//---------------------------------------------------------------------------
+int StarPicker::ConstellationAt(float RA, float Dec) const
+{
+	if (!FGrid.cells)
+		return CONSTELL_IDX_NONE;
+	precess_positions(FToB1875, &RA, &Dec, &RA, &Dec, 1);
+	return constellation_grid_index_at(&FGrid, RA, Dec);
+}
+//---------------------------------------------------------------------------
+void StarPicker::PickNearest(const float* Ray, size_t K, float MaxAngle,
+	float MaxMagnitude, std::vector<SkyNeighbour>& Out) const
+{
+	if (!FIndex)
+	{
+		Out.clear();
+		return;
+	}
+	FIndex->QueryNearest(Ray[0], Ray[1], Ray[2], K, MaxAngle, MaxMagnitude,
+		FMagnitudeWeight, Out);
+}
+//---------------------------------------------------------------------------
+StarPick StarPicker::Pick(const float* Ray, float MaxAngle,
+	float MaxMagnitude) const
+{
+	StarPick Result{NoStar, 0.f, CONSTELL_IDX_NONE};
+	std::vector<SkyNeighbour> Found;
+	PickNearest(Ray, 1, MaxAngle, MaxMagnitude, Found);
+	if (!Found.empty() && Found[0].Record < FStars.size())
+	{
+		const StarRecord& Star = FStars[Found[0].Record];
+		Result.Record = Found[0].Record;
+		Result.Angle = Found[0].Angle;
+		Result.Constellation = ConstellationAt(Star.RADegrees(), Star.DecDegrees());
+		return Result;
+	}
+	// Nothing in reach: still say where the cursor is.
+	const double Length = std::sqrt(Ray[0] * Ray[0] + Ray[1] * Ray[1]
+		+ Ray[2] * Ray[2]);
+	if (Length == 0)
+		return Result;
+	const double RA = std::atan2(Ray[1], Ray[0]) * (180. / Pi);
+	const double Dec = std::asin(Ray[2] / Length) * (180. / Pi);
+	Result.Constellation = ConstellationAt(static_cast<float>(RA < 0 ? RA + 360. : RA),
+		static_cast<float>(Dec));
+	return Result;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,77 @@
+//---------------------------------------------------------------------------
+// The star under the cursor.
+//
+// The camera sits at the centre of the sky sphere, so a screen ray is only
+// a direction: GLSceneViewer->Buffer->ScreenToVector(x, y), taken into the
+// sky's frame with SkyDome->AbsoluteToLocal().  Pick() hands it to
+// SkyIndex::QueryNearest() and looks up the constellation the winner lies
+// in with constellation_grid_index_at(), which answers from a byte raster
+// except near a boundary.  Both are a few microseconds, so the picker can
+// run on every mouse move for hover tooltips, at any catalog depth.
+//---------------------------------------------------------------------------
+
+#ifndef uStarPickerH
+#define uStarPickerH
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "congrid.h"
+#include "uSkyIndex.h"
+#include "uStarCatalog.h"
+
+//---------------------------------------------------------------------------
+struct StarPick
+{
+	uint32_t Record;     // into the catalog, StarPicker::NoStar if none
+	float Angle;         // radians between the ray and the star
+	int Constellation;   // 0..87 as conbound.h, of the star or else of the
+	                     // ray itself; CONSTELL_IDX_NONE before Init()
+};
+
+//---------------------------------------------------------------------------
+class StarPicker
+{
+public:
+	static constexpr uint32_t NoStar = 0xffffffffu;
+
+	StarPicker();
+	~StarPicker();
+	StarPicker(const StarPicker&) = delete;
+	StarPicker& operator=(const StarPicker&) = delete;
+
+	// Index and Stars must outlive the picker.  Builds the constellation
+	// raster (GridHeight cells from pole to pole); false if out of memory.
+	bool Init(const SkyIndex& Index, std::span<const StarRecord> Stars,
+		int GridHeight = 360);
+
+	// Radians a star may be farther from the ray per magnitude it is
+	// brighter and still win; 0 picks by distance alone.  Negative weights
+	// (favouring faint stars) aren't supported and are taken as 0.
+	void SetMagnitudeWeight(float Weight)
+	{
+		FMagnitudeWeight = Weight > 0.f ? Weight : 0.f;
+	}
+	float MagnitudeWeight() const { return FMagnitudeWeight; }
+
+	// Ray is a direction in the catalog's J2000 frame (need not be unit
+	// length); MaxAngle in radians, typically a few pixels' worth.
+	StarPick Pick(const float* Ray, float MaxAngle, float MaxMagnitude) const;
+	// The K best candidates, best first, for cycling through close pairs.
+	void PickNearest(const float* Ray, size_t K, float MaxAngle,
+		float MaxMagnitude, std::vector<SkyNeighbour>& Out) const;
+
+	// Constellation at a J2000 position in degrees.
+	int ConstellationAt(float RA, float Dec) const;
+
+private:
+	const SkyIndex* FIndex = nullptr;
+	std::span<const StarRecord> FStars;
+	congrid_t FGrid;
+	double FToB1875[9];
+	float FMagnitudeWeight = 0.f;
+};
+
+//---------------------------------------------------------------------------
+#endif
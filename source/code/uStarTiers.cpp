@@ -0,0 +1,214 @@
+//---------------------------------------------------------------------------
+
+#include "uStarTiers.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+//---------------------------------------------------------------------------
+namespace
+{
+const char TierMagic[4] = {'S', 'T', 'T', '1'};
+const uint64_t TierAlignment = 4096;
+
+uint64_t AlignUp(uint64_t Offset)
+{
+	return (Offset + TierAlignment - 1) & ~(TierAlignment - 1);
+}
+
+bool SeekTo(FILE* File, uint64_t Offset)
+{
+#ifdef _WIN32
+	return _fseeki64(File, static_cast<__int64>(Offset), SEEK_SET) == 0;
+#else
+	return fseeko(File, static_cast<off_t>(Offset), SEEK_SET) == 0;
+#endif
+}
+} // namespace
+
+//---------------------------------------------------------------------------
+bool WriteStarTiers(const std::string& FileName,
+	std::span<const StarRecord> Stars, std::span<const float> Breaks)
+{
+	std::vector<StarRecord> Sorted(Stars.begin(), Stars.end());
+	std::stable_sort(Sorted.begin(), Sorted.end(),
+		[](const StarRecord& a, const StarRecord& b)
+		{ return a.VMagnitude < b.VMagnitude; });
+
+	std::vector<StarTierEntry> Entries;
+	uint64_t Offset = AlignUp(sizeof(StarTierHeader)
+		+ (Breaks.size() + 1) * sizeof(StarTierEntry));
+	size_t First = 0;
+	float Previous = -99.f;
+	for (size_t t = 0; t <= Breaks.size(); t++)
+	{
+		size_t Last = Sorted.size();
+		if (t < Breaks.size())
+			Last = std::upper_bound(Sorted.begin() + First, Sorted.end(),
+				Breaks[t], [](float m, const StarRecord& s)
+				{ return m < s.Magnitude(); }) - Sorted.begin();
+		if (Last == First)
+			continue;  // an empty band; nothing to stream
+		StarTierEntry e;
+		e.MinMagnitude = Previous;
+		e.MaxMagnitude = Sorted[Last - 1].Magnitude();
+		e.Offset = Offset;
+		e.Count = Last - First;
+		Entries.push_back(e);
+		Previous = e.MaxMagnitude;
+		Offset = AlignUp(Offset + e.Count * sizeof(StarRecord));
+		First = Last;
+	}
+
+	FILE* File = std::fopen(FileName.c_str(), "wb");
+	if (!File)
+		return false;
+	StarTierHeader Header;
+	std::memcpy(Header.Magic, TierMagic, sizeof(Header.Magic));
+	Header.TierCount = static_cast<uint32_t>(Entries.size());
+	Header.RecordSize = sizeof(StarRecord);
+	Header.Reserved = 0;
+	bool Ok = std::fwrite(&Header, sizeof(Header), 1, File) == 1
+		&& std::fwrite(Entries.data(), sizeof(StarTierEntry), Entries.size(),
+			File) == Entries.size();
+	First = 0;
+	for (size_t t = 0; Ok && t < Entries.size(); t++)
+	{
+		Ok = SeekTo(File, Entries[t].Offset)
+			&& std::fwrite(Sorted.data() + First, sizeof(StarRecord),
+				Entries[t].Count, File) == Entries[t].Count;
+		First += Entries[t].Count;
+	}
+	// Pad the last tier too, so every tier can be mapped as whole pages.
+	if (Ok && !Entries.empty())
+	{
+		const StarTierEntry& e = Entries.back();
+		const uint64_t End = e.Offset + e.Count * sizeof(StarRecord);
+		const char Zero = 0;
+		Ok = End == AlignUp(End) || (SeekTo(File, AlignUp(End) - 1)
+			&& std::fwrite(&Zero, 1, 1, File) == 1);
+	}
+	Ok = (std::fclose(File) == 0) && Ok;
+	return Ok;
+}
+
+//---------------------------------------------------------------------------
+bool StarTierStream::Open(const std::string& FileName)
+{
+	Close();
+	FFile = std::fopen(FileName.c_str(), "rb");
+	if (!FFile)
+		return false;
+
+	StarTierHeader Header;
+	bool Ok = std::fread(&Header, sizeof(Header), 1, FFile) == 1
+		&& !std::memcmp(Header.Magic, TierMagic, sizeof(Header.Magic))
+		&& Header.RecordSize == sizeof(StarRecord) && Header.TierCount > 0
+		&& Header.TierCount < 256;
+	if (Ok)
+	{
+		FEntries.resize(Header.TierCount);
+		Ok = std::fread(FEntries.data(), sizeof(StarTierEntry),
+			FEntries.size(), FFile) == FEntries.size();
+	}
+	FTiers.resize(FEntries.size());
+	FFailed.assign(FEntries.size(), false);
+	// The first tier is what a wide view shows, so Open waits for it.
+	if (Ok)
+	{
+		FTiers[0] = ReadTier(0);
+		Ok = FTiers[0].size() == FEntries[0].Count;
+	}
+	if (!Ok)
+	{
+		Close();
+		return false;
+	}
+	FResident = 1;
+	return true;
+}
+//---------------------------------------------------------------------------
+void StarTierStream::Close()
+{
+	if (FLoading.valid())
+		FLoading.wait();
+	FLoading = {};
+	if (FFile)
+		std::fclose(FFile);
+	FFile = nullptr;
+	FEntries.clear();
+	FTiers.clear();
+	FFailed.clear();
+	FResident = 0;
+}
+//---------------------------------------------------------------------------
+std::vector<StarRecord> StarTierStream::ReadTier(int Tier)
+{
+	const StarTierEntry& e = FEntries[Tier];
+	std::vector<StarRecord> Records(static_cast<size_t>(e.Count));
+	if (SeekTo(FFile, e.Offset) && std::fread(Records.data(),
+		sizeof(StarRecord), Records.size(), FFile) == Records.size())
+		return Records;
+	return {};  // short read: the caller checks the count
+}
+//---------------------------------------------------------------------------
+float StarTierStream::LimitingMagnitude(float FovDegrees) const
+{
+	FovDegrees = std::max(FovDegrees, 1e-3f);
+	return BaseMagnitude + MagnitudePerZoom * std::log2(BaseFov / FovDegrees);
+}
+//---------------------------------------------------------------------------
+bool StarTierStream::Update(float FovDegrees)
+{
+	if (!FFile)
+		return false;
+	const float Limit = LimitingMagnitude(FovDegrees);
+
+	// A finished read is taken in even if the view has zoomed out since;
+	// the eviction below drops it again if so.
+	bool Changed = false;
+	if (FLoading.valid())
+	{
+		if (FLoading.wait_for(std::chrono::seconds(0))
+			!= std::future_status::ready)
+			return false;
+		std::vector<StarRecord> Records = FLoading.get();
+		if (Records.size() == FEntries[FResident].Count)
+		{
+			FTiers[FResident++] = std::move(Records);
+			Changed = true;
+		}
+		else
+			FFailed[FResident] = true;
+	}
+
+	// Drop tiers (other than the first) that are now well below the limit.
+	while (FResident > 1
+		&& FEntries[FResident - 1].MinMagnitude > Limit + Hysteresis)
+	{
+		FResident--;
+		std::vector<StarRecord>().swap(FTiers[FResident]);
+		Changed = true;
+	}
+
+	// Start reading the next tier; one in flight at a time.
+	if (FResident < TierCount() && !FFailed[FResident]
+		&& FEntries[FResident].MinMagnitude < Limit)
+	{
+		const int Tier = FResident;
+		FLoading = std::async(std::launch::async,
+			[this, Tier] { return ReadTier(Tier); });
+	}
+	return Changed;
+}
+//---------------------------------------------------------------------------
+size_t StarTierStream::ResidentBytes() const
+{
+	size_t Bytes = 0;
+	for (int t = 0; t < FResident; t++)
+		Bytes += FTiers[t].size() * sizeof(StarRecord);
+	return Bytes;
+}
+//---------------------------------------------------------------------------
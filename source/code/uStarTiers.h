@@ -0,0 +1,111 @@
+//---------------------------------------------------------------------------
+// Magnitude-tiered star files and a zoom-driven loader for them.
+//
+// A tier file holds the same 6-byte StarRecords as a .stars file, cut
+// into magnitude bands, brightest band first, each starting on a 4 KB
+// boundary so it can be read (or mapped) on its own:
+//
+//   StarTierHeader
+//   StarTierEntry[TierCount]
+//   tier 0 records ... tier 1 records ... (each padded to 4 KB)
+//
+// StarTierStream keeps the bright tiers resident and pulls deeper ones
+// in as the field of view narrows, one tier at a time on a worker thread,
+// so a zoom never stalls the render thread on a large read; zooming back
+// out drops them again.  startiers.cpp writes tier files from a .stars
+// catalog.
+//---------------------------------------------------------------------------
+
+#ifndef uStarTiersH
+#define uStarTiersH
+
+#include <cstdint>
+#include <cstdio>
+#include <future>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "uStarCatalog.h"
+
+//---------------------------------------------------------------------------
+struct StarTierHeader
+{
+	char Magic[4];         // "STT1"
+	uint32_t TierCount;
+	uint32_t RecordSize;   // sizeof(StarRecord)
+	uint32_t Reserved;
+};
+
+struct StarTierEntry
+{
+	float MinMagnitude;    // faintest star of the previous tier
+	float MaxMagnitude;    // faintest star of this one
+	uint64_t Offset;       // bytes from the start of the file
+	uint64_t Count;        // records
+};
+
+//---------------------------------------------------------------------------
+// Splits Stars at the given magnitudes (ascending; stars fainter than the
+// last break go into a final tier) and writes a tier file.  Stars need
+// not be sorted.
+bool WriteStarTiers(const std::string& FileName,
+	std::span<const StarRecord> Stars, std::span<const float> Breaks);
+
+//---------------------------------------------------------------------------
+class StarTierStream
+{
+public:
+	// Limiting magnitude is BaseMagnitude at BaseFov degrees, and gains
+	// MagnitudePerZoom each time the field of view halves.  A resident
+	// tier is only dropped once the limit is Hysteresis brighter than
+	// the tier, so that small zoom jitter doesn't reload it.
+	float BaseMagnitude = 6.5f;
+	float BaseFov = 60.f;
+	float MagnitudePerZoom = 1.f;
+	float Hysteresis = 0.5f;
+
+	StarTierStream() = default;
+	~StarTierStream() { Close(); }
+	StarTierStream(const StarTierStream&) = delete;
+	StarTierStream& operator=(const StarTierStream&) = delete;
+
+	// Reads the tier table and the first tier.
+	bool Open(const std::string& FileName);
+	void Close();
+
+	float LimitingMagnitude(float FovDegrees) const;
+
+	// Evicts tiers no longer needed for a camera with this field of view,
+	// takes in a tier whose read has finished, or starts reading the next
+	// one in the background; never waits for the disk.  Returns true if
+	// the resident set changed (i.e. the renderer should rebuild what it
+	// draws).  A tier that fails to read is not tried again until Open.
+	bool Update(float FovDegrees);
+	// a tier is being read
+	bool Loading() const { return FLoading.valid(); }
+
+	int TierCount() const { return static_cast<int>(FEntries.size()); }
+	int ResidentTiers() const { return FResident; }
+	const StarTierEntry& Entry(int Tier) const { return FEntries[Tier]; }
+	// Empty unless the tier is resident.
+	std::span<const StarRecord> Tier(int Tier) const { return FTiers[Tier]; }
+	size_t ResidentBytes() const;
+
+	bool Failed(int Tier) const { return FFailed[Tier]; }
+
+private:
+	// Worker side: only touches FFile, which nothing else reads while a
+	// load is in flight.
+	std::vector<StarRecord> ReadTier(int Tier);
+
+	FILE* FFile = nullptr;
+	std::vector<StarTierEntry> FEntries;
+	std::vector<std::vector<StarRecord>> FTiers;
+	std::vector<bool> FFailed;
+	int FResident = 0;  // tiers [0, FResident) are loaded
+	std::future<std::vector<StarRecord>> FLoading;  // tier FResident
+};
+
+//---------------------------------------------------------------------------
+#endif
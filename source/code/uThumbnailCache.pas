@@ -0,0 +1,315 @@
+unit uThumbnailCache;
+//--------------------------------------------------
+// Decoded constellation art thumbnails for the tree views
+//--------------------------------------------------
+(*
+  Browsing the constellation trees shows each figure's art.  Decoding a
+  500 KB PNG on every click stalls the UI, so thumbnails are decoded and
+  scaled on the asset loader's threads and kept here, least recently used
+  first out once Budget bytes are taken.
+
+  TryGet never waits: on a miss it queues the file and returns False, and
+  OnReady fires (on the main thread, from TAssetLoader.Deliver) when the
+  thumbnail is in.  Prefetch queues the nodes around the selection at a
+  lower priority, so moving through the tree mostly hits.  Entries are
+  keyed by file name, so several skycultures share one budget.
+*)
+
+interface
+
+uses
+  System.Classes,
+  System.SysUtils,
+  System.Generics.Collections,
+  Vcl.Graphics,
+  uAssetLoader;
+
+const
+  ThumbnailPriority = 4; // the one the user is looking at
+  PrefetchPriority = 0;  // below everything else
+
+type
+  TThumbnailReadyEvent = procedure(Sender: TObject; const FileName: string;
+    Thumbnail: TBitmap) of object;
+
+  TThumbnailCache = class
+  private type
+    TEntry = class
+      FileName: string;
+      Bitmap: TBitmap;
+      Bytes: Int64;
+      Newer, Older: TEntry;
+    end;
+  private
+    FLoader: TAssetLoader;
+    FEntries: TDictionary<string, TEntry>;
+    FQueued: TDictionary<string, Boolean>;
+    FNewest, FOldest: TEntry;
+    FBudget: Int64;
+    FUsed: Int64;
+    FSize: Integer;
+    FHits: Int64;
+    FMisses: Int64;
+    FPrefetches: Int64;
+    FEvictions: Int64;
+    FOnReady: TThumbnailReadyEvent;
+    procedure Unlink(Entry: TEntry);
+    procedure LinkNewest(Entry: TEntry);
+    procedure Evict(Keep: TEntry);
+    procedure Queue(const FileName: string; Priority: Integer);
+    procedure SetBudget(Value: Int64);
+  public
+    // Size is the longest side of a thumbnail in pixels
+    constructor Create(Loader: TAssetLoader; Budget: Int64 = 16 * 1024 * 1024;
+      Size: Integer = 128);
+    destructor Destroy; override;
+    // The bitmap stays owned by the cache; Assign it to keep it.
+    function TryGet(const FileName: string; out Bitmap: TBitmap): Boolean;
+    procedure Prefetch(const FileName: string);
+    procedure Clear;
+    function StatsText: string;
+    property Budget: Int64 read FBudget write SetBudget;
+    property Used: Int64 read FUsed;
+    property Size: Integer read FSize;
+    property Hits: Int64 read FHits;
+    property Misses: Int64 read FMisses;
+    property Prefetches: Int64 read FPrefetches;
+    property Evictions: Int64 read FEvictions;
+    property OnReady: TThumbnailReadyEvent read FOnReady write FOnReady;
+  end;
+
+//==========================================================================
+implementation
+//==========================================================================
+
+uses
+  Winapi.Windows,
+  System.Types,
+  System.Math;
+
+type
+  // Handed from the worker to Apply, which takes the bitmap out
+  TThumbnail = class
+  public
+    Bitmap: TBitmap;
+    destructor Destroy; override;
+  end;
+
+destructor TThumbnail.Destroy;
+begin
+  Bitmap.Free;
+  inherited;
+end;
+
+//-----------------------------------------------------------------------
+
+function DecodeThumbnail(const FileName: string; Size: Integer): TThumbnail;
+var
+  Graphic: TGraphic;
+  Scale: Double;
+begin
+  Graphic := DecodePicture(FileName);
+  try
+    Result := TThumbnail.Create;
+    try
+      Result.Bitmap := TBitmap.Create;
+      Result.Bitmap.PixelFormat := pf24bit;
+      Scale := Min(1, Size / Max(Graphic.Width, Graphic.Height));
+      Result.Bitmap.SetSize(Max(1, Round(Graphic.Width * Scale)),
+        Max(1, Round(Graphic.Height * Scale)));
+      // A canvas used off the main thread has to stay locked meanwhile
+      Result.Bitmap.Canvas.Lock;
+      try
+        SetStretchBltMode(Result.Bitmap.Canvas.Handle, HALFTONE);
+        Result.Bitmap.Canvas.StretchDraw(Rect(0, 0, Result.Bitmap.Width,
+          Result.Bitmap.Height), Graphic);
+      finally
+        Result.Bitmap.Canvas.Unlock;
+      end;
+    except
+      Result.Free;
+      raise;
+    end;
+  finally
+    Graphic.Free;
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+constructor TThumbnailCache.Create(Loader: TAssetLoader; Budget: Int64;
+  Size: Integer);
+begin
+  inherited Create;
+  FLoader := Loader;
+  FBudget := Budget;
+  FSize := Size;
+  FEntries := TDictionary<string, TEntry>.Create;
+  FQueued := TDictionary<string, Boolean>.Create;
+end;
+
+//-----------------------------------------------------------------------
+
+destructor TThumbnailCache.Destroy;
+begin
+  Clear;
+  FEntries.Free;
+  FQueued.Free;
+  inherited;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TThumbnailCache.Unlink(Entry: TEntry);
+begin
+  if Entry.Newer <> nil then
+    Entry.Newer.Older := Entry.Older
+  else
+    FNewest := Entry.Older;
+  if Entry.Older <> nil then
+    Entry.Older.Newer := Entry.Newer
+  else
+    FOldest := Entry.Newer;
+  Entry.Newer := nil;
+  Entry.Older := nil;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TThumbnailCache.LinkNewest(Entry: TEntry);
+begin
+  Entry.Older := FNewest;
+  if FNewest <> nil then
+    FNewest.Newer := Entry
+  else
+    FOldest := Entry;
+  FNewest := Entry;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TThumbnailCache.Evict(Keep: TEntry);
+var
+  Entry: TEntry;
+begin
+  while (FUsed > FBudget) and (FOldest <> nil) and (FOldest <> Keep) do
+  begin
+    Entry := FOldest;
+    Unlink(Entry);
+    FEntries.Remove(Entry.FileName);
+    Dec(FUsed, Entry.Bytes);
+    Inc(FEvictions);
+    Entry.Bitmap.Free;
+    Entry.Free;
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TThumbnailCache.Queue(const FileName: string; Priority: Integer);
+var
+  ThumbSize: Integer;
+begin
+  if FQueued.ContainsKey(FileName) then
+    Exit;
+  FQueued.Add(FileName, True);
+  ThumbSize := FSize;
+  FLoader.Request(FileName, Priority,
+    function(const FileName: string): TObject
+    begin
+      Result := DecodeThumbnail(FileName, ThumbSize);
+    end,
+    procedure(Data: TObject)
+    var
+      Entry: TEntry;
+    begin
+      // Cleared (or queued twice) in the meantime: nothing to do
+      if not FQueued.ContainsKey(FileName) or FEntries.ContainsKey(FileName) then
+        Exit;
+      FQueued.Remove(FileName);
+      Entry := TEntry.Create;
+      Entry.FileName := FileName;
+      Entry.Bitmap := TThumbnail(Data).Bitmap;
+      TThumbnail(Data).Bitmap := nil;
+      Entry.Bytes := BytesPerScanline(Entry.Bitmap.Width, 24, 32) * Entry.Bitmap.Height;
+      FEntries.Add(FileName, Entry);
+      LinkNewest(Entry);
+      Inc(FUsed, Entry.Bytes);
+      Evict(Entry);
+      if Assigned(FOnReady) then
+        FOnReady(Self, FileName, Entry.Bitmap);
+    end);
+end;
+
+//-----------------------------------------------------------------------
+
+function TThumbnailCache.TryGet(const FileName: string; out Bitmap: TBitmap): Boolean;
+var
+  Entry: TEntry;
+begin
+  Result := FEntries.TryGetValue(FileName, Entry);
+  if Result then
+  begin
+    Inc(FHits);
+    if Entry <> FNewest then
+    begin
+      Unlink(Entry);
+      LinkNewest(Entry);
+    end;
+    Bitmap := Entry.Bitmap;
+  end
+  else
+  begin
+    Inc(FMisses);
+    Bitmap := nil;
+    Queue(FileName, ThumbnailPriority);
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TThumbnailCache.Prefetch(const FileName: string);
+begin
+  if not FEntries.ContainsKey(FileName) and not FQueued.ContainsKey(FileName) then
+  begin
+    Inc(FPrefetches);
+    Queue(FileName, PrefetchPriority);
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TThumbnailCache.Clear;
+var
+  Entry: TEntry;
+begin
+  for Entry in FEntries.Values do
+  begin
+    Entry.Bitmap.Free;
+    Entry.Free;
+  end;
+  FEntries.Clear;
+  // decodes still running are dropped when they arrive
+  FQueued.Clear;
+  FNewest := nil;
+  FOldest := nil;
+  FUsed := 0;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TThumbnailCache.SetBudget(Value: Int64);
+begin
+  FBudget := Value;
+  Evict(nil);
+end;
+
+//-----------------------------------------------------------------------
+
+function TThumbnailCache.StatsText: string;
+begin
+  Result := Format('thumbnails %d hits, %d misses, %.1f of %.1f MB',
+    [FHits, FMisses, FUsed / (1024 * 1024), FBudget / (1024 * 1024)]);
+end;
+
+end.
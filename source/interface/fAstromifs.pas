@@ -33,7 +33,12 @@ uses
   GLS.SimpleNavigation,
 
   fAbout,
+  fFindStar,
   uGlobals,
+  uFrameScheduler,
+  uAssetLoader,
+  uThumbnailCache,
+  uStarNames,
   GLS.VectorFileObjects;
 
 type
@@ -110,6 +115,7 @@ type
     ffPlanet: TGLFreeForm;
     ConstellationLines: TGLLines;
     ConstellationBorders: TGLLines;
+    imgArt: TImage;
     procedure miAboutClick(Sender: TObject);
     procedure Open1Click(Sender: TObject);
     procedure Save1Click(Sender: TObject);
@@ -118,7 +124,28 @@ type
     procedure GLCadencerProgress(Sender: TObject; const DeltaTime, NewTime: Double);
     procedure tvConstellationsClick(Sender: TObject);
     procedure Exit1Click(Sender: TObject);
+    procedure FormDestroy(Sender: TObject);
+    procedure tvConstellationsChange(Sender: TObject; Node: TTreeNode);
+    procedure Find1Click(Sender: TObject);
   private
+    FScheduler: TFrameScheduler;
+    FLoader: TAssetLoader;
+    FThumbnails: TThumbnailCache;
+    FArtCulture: TFileName; // skyculture the tree views show art from
+    FArtShown: string;
+    FStarNames: TStarNameIndex; // built on first use
+    FLastCameraMatrix: array [0 .. 15] of Single;
+    FLastFocalLength: Single;
+    FAssetText: string; // loader summary, shown after the frame stats
+    procedure CheckCamera;
+    procedure RequestStars(const FileName: TFileName);
+    procedure RequestPlanetMap(const FileName: TFileName);
+    function NodeArtFile(Index: Integer): string;
+    procedure ThumbnailReady(Sender: TObject; const FileName: string;
+      Thumbnail: TBitmap);
+    procedure LookAt(RA, Dec: Single);
+    procedure ViewerBeforeRender(Sender: TObject);
+    procedure ViewerAfterRender(Sender: TObject);
   public
     procedure HandleKeys(d: Double);
   end;
@@ -130,6 +157,34 @@ implementation
 
 {$R *.dfm}
 
+uses
+  System.Diagnostics,
+  System.Generics.Collections,
+  GLS.VectorTypes,
+  GLS.VectorGeometry,
+  GLS.Color,
+  GLS.StarRecord;
+
+const
+  // ms the cadencer sleeps per tick while nothing on screen changes
+  IdleSleepLength = 50;
+  // ms per tick spent handing loaded assets to the scene
+  AssetDeliveryBudget = 8;
+  // sky dome stars added between looks at the clock
+  StarsPerCheck = 1024;
+  // asset loading order, higher first
+  StarsPriority = 2;
+  PlanetMapPriority = 1;
+  // tree nodes either side of the selection whose art is prefetched
+  ThumbnailPrefetchRadius = 4;
+
+type
+  // A star of the catalog, converted off the main thread
+  TSkyStar = record
+    RA, Dec, Magnitude: Single;
+    Color: TColor;
+  end;
+
 //-----------------------------------------------------------------------
 
 procedure TFormAstromifs.Exit1Click(Sender: TObject);
@@ -141,6 +196,12 @@ procedure TFormAstromifs.FormCreate(Sender: TObject);
 var
   ConstNames, PlanetMap: TFileName;
 begin
+  FScheduler := TFrameScheduler.Create;
+  GLSceneViewer.BeforeRender := ViewerBeforeRender;
+  GLSceneViewer.AfterRender := ViewerAfterRender;
+  StatusBar1.SimplePanel := True;
+  StatusBar1.ShowHint := True;
+
   PathToData := GetCurrentDir() + '\data';
   CurrentPath := PathToData;
   SetCurrentDir(CurrentPath + '\cubemap');
@@ -149,22 +210,18 @@ begin
   SkyDome.Visible := True;
   SkyDome.Bands.Clear;
 
-  PlanetMap := CurrentPath + '\map\earth.jpg';
-
-  Planet.Material.Texture.Disabled := False;
-  Planet.Material.Texture.Image.LoadFromFile(PlanetMap);
-
-  //if FileExists(FileName) then
-//    SkyDome.Stars.LoadStarsFile(FileName);
+  // Everything slow to read is decoded on the loader's threads; the
+  // planet stays an untextured sphere and the sky empty until it arrives
+  FLoader := TAssetLoader.Create;
+  FThumbnails := TThumbnailCache.Create(FLoader);
+  FThumbnails.OnReady := ThumbnailReady;
+  FArtCulture := PathToData + '\constellation\hevelius';
   Catalog := PathToData + '\catalog\hipparcos.stars';
   if FileExists(Catalog) then
-  begin
-    SkyDome.Bands.Clear;
-    SkyDome.Stars.Clear;
-    SkyDome.Stars.LoadStarsFile(Catalog);
-    SkyDome.StructureChanged;
-  end;
-
+    RequestStars(Catalog);
+  PlanetMap := CurrentPath + '\map\earth.jpg';
+  Planet.Material.Texture.Disabled := True;
+  RequestPlanetMap(PlanetMap);
 
   ConstNames := CurrentPath + '\constellation\ConstNames.dat';
     tvConstellations.LoadFromFile(ConstNames);
@@ -177,18 +234,125 @@ end;
 
 //-----------------------------------------------------------------------
 
+procedure TFormAstromifs.FormDestroy(Sender: TObject);
+begin
+  FreeAndNil(FLoader);
+  FreeAndNil(FThumbnails);
+  FreeAndNil(FStarNames);
+  FreeAndNil(FScheduler);
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TFormAstromifs.RequestStars(const FileName: TFileName);
+var
+  Next: Integer; // first star not yet on the sky dome
+begin
+  Next := 0;
+  FLoader.RequestInSteps(FileName, StarsPriority,
+    function(const FileName: string): TObject
+    var
+      Stream: TFileStream;
+      Records: TArray<TGLStarRecord>;
+      Stars: TList<TSkyStar>;
+      Star: TSkyStar;
+      I: Integer;
+    begin
+      // Same conversion as TGLSkyDomeStars.LoadStarsFile
+      Stream := TFileStream.Create(FileName, fmOpenRead or fmShareDenyWrite);
+      try
+        SetLength(Records, Stream.Size div SizeOf(TGLStarRecord));
+        if Length(Records) > 0 then
+          Stream.ReadBuffer(Records[0], Length(Records) * SizeOf(TGLStarRecord));
+      finally
+        Stream.Free;
+      end;
+      Stars := TList<TSkyStar>.Create;
+      Stars.Capacity := Length(Records);
+      for I := 0 to High(Records) do
+      begin
+        Star.RA := Records[I].RA * 0.01;
+        Star.Dec := Records[I].DEC * 0.01;
+        Star.Magnitude := Records[I].VMagnitude * 0.1;
+        Star.Color := ConvertColorVector(StarRecordColor(Records[I], 3));
+        Stars.Add(Star);
+      end;
+      Result := Stars;
+    end,
+    // Some 87,000 stars, so they go onto the sky dome a budget at a time
+    function(Data: TObject; BudgetMs: Double): Boolean
+    var
+      Stars: TList<TSkyStar>;
+      Watch: TStopwatch;
+      I, Last: Integer;
+    begin
+      Stars := TList<TSkyStar>(Data);
+      Watch := TStopwatch.StartNew;
+      SkyDome.Stars.BeginUpdate;
+      try
+        if Next = 0 then
+        begin
+          SkyDome.Bands.Clear;
+          SkyDome.Stars.Clear;
+        end;
+        repeat
+          Last := Next + StarsPerCheck;
+          if Last > Stars.Count then
+            Last := Stars.Count;
+          for I := Next to Last - 1 do
+            with SkyDome.Stars.Add do
+            begin
+              RA := Stars[I].RA;
+              Dec := Stars[I].Dec;
+              Magnitude := Stars[I].Magnitude;
+              Color := Stars[I].Color;
+            end;
+          Next := Last;
+        until (Next = Stars.Count) or (Watch.Elapsed.TotalMilliseconds >= BudgetMs);
+      finally
+        SkyDome.Stars.EndUpdate;
+      end;
+      SkyDome.StructureChanged;
+      Result := Next = Stars.Count;
+    end);
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TFormAstromifs.RequestPlanetMap(const FileName: TFileName);
+begin
+  FLoader.Request(FileName, PlanetMapPriority,
+    function(const FileName: string): TObject
+    begin
+      Result := DecodePicture(FileName);
+    end,
+    procedure(Data: TObject)
+    begin
+      Planet.Material.Texture.Image.Assign(TGraphic(Data));
+      Planet.Material.Texture.Disabled := False;
+      ffPlanet.Assign(Planet);
+    end);
+end;
+
+//-----------------------------------------------------------------------
+
 procedure TFormAstromifs.Open1Click(Sender: TObject);
 begin
   // Load next skyculture for constellations ...
-  OpenDialog.Filter := 'Constellation (*.dat)|*.dat';
+  OpenDialog.Filter := 'Constellation (*.dat)|*.dat|Skyculture art (info.ini)|info.ini';
   OpenDialog.InitialDir := PathToData;
   OpenDialog.DefaultExt := '*.dat';
   if OpenDialog.Execute then
   begin
-    tvConstellations.LoadFromFile(OpenDialog.FileName);
     CurrentPath := ExtractFilePath(OpenDialog.FileName);
-    tvConstellations.Select(tvConstellations.Items[0]);  // goto to new mif
-    tvConstellationsClick(Sender);
+    if FileExists(CurrentPath + 'info.ini') then
+      FArtCulture := ExcludeTrailingPathDelimiter(CurrentPath);
+    if SameText(ExtractFileExt(OpenDialog.FileName), '.dat') then
+    begin
+      tvConstellations.LoadFromFile(OpenDialog.FileName);
+      tvConstellations.Select(tvConstellations.Items[0]);  // goto to new mif
+      tvConstellationsClick(Sender);
+    end;
   end;
 end;
 
@@ -197,6 +361,67 @@ end;
 procedure TFormAstromifs.tvConstellationsClick(Sender: TObject);
 begin
   //
+  FScheduler.MarkDirty(drSelection);
+end;
+
+//-----------------------------------------------------------------------
+
+function TFormAstromifs.NodeArtFile(Index: Integer): string;
+var
+  Abbr, Name, Dir: string;
+begin
+  // ConstNames.dat and ConstShortNames.dat list the same constellations
+  // in the same order
+  if (Index < 0) or (Index >= tvConstellations.Items.Count) then
+    Exit('');
+  Name := tvConstellations.Items[Index].Text;
+  if Index < tvCurrent.Items.Count then
+    Abbr := tvCurrent.Items[Index].Text;
+  // Skycultures name the PNGs by abbreviation or by Latin name
+  Dir := IncludeTrailingPathDelimiter(FArtCulture);
+  Result := Dir + Abbr + '.png';
+  if (Abbr <> '') and FileExists(Result) then
+    Exit;
+  Result := Dir + LowerCase(StringReplace(Trim(Name), ' ', '-', [rfReplaceAll])) + '.png';
+  if (Name = '') or not FileExists(Result) then
+    Result := '';
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TFormAstromifs.tvConstellationsChange(Sender: TObject; Node: TTreeNode);
+var
+  Thumbnail: TBitmap;
+  Neighbour: string;
+  I, Side: Integer;
+begin
+  if Node = nil then
+    Exit;
+  FArtShown := NodeArtFile(Node.AbsoluteIndex);
+  if FArtShown = '' then
+    imgArt.Picture.Assign(nil)
+  else if FThumbnails.TryGet(FArtShown, Thumbnail) then
+    imgArt.Picture.Assign(Thumbnail);
+  // else the old picture stays up until ThumbnailReady
+
+  // Neighbours nearest first: the loader keeps requests of one priority in order
+  for I := 1 to ThumbnailPrefetchRadius do
+    for Side := -1 to 1 do
+      if Side <> 0 then
+      begin
+        Neighbour := NodeArtFile(Node.AbsoluteIndex + Side * I);
+        if Neighbour <> '' then
+          FThumbnails.Prefetch(Neighbour);
+      end;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TFormAstromifs.ThumbnailReady(Sender: TObject; const FileName: string;
+  Thumbnail: TBitmap);
+begin
+  if SameFileName(FileName, FArtShown) then
+    imgArt.Picture.Assign(Thumbnail);
 end;
 
 //-----------------------------------------------------------------------
@@ -215,6 +440,49 @@ end;
 
 //-----------------------------------------------------------------------
 
+procedure TFormAstromifs.Find1Click(Sender: TObject);
+var
+  Dialog: TfrmFindStar;
+  Star: TStarName;
+begin
+  // Parsed once, then read back from starnames.idx until a list changes
+  if FStarNames = nil then
+  begin
+    FStarNames := TStarNameIndex.Create;
+    FStarNames.LoadOrBuild(PathToData + '\star\starnames.idx',
+      PathToData + '\star\IAU-CSN.txt',
+      PathToData + '\constellation\StarsNames.dat',
+      PathToData + '\star\starnames.wiki');
+  end;
+  Dialog := TfrmFindStar.Create(Self);
+  try
+    Dialog.StarNames := FStarNames;
+    if (Dialog.ShowModal = mrOk) and (Dialog.SelectedStar >= 0) then
+    begin
+      Star := FStarNames[Dialog.SelectedStar];
+      if Star.HasPosition then
+        LookAt(Star.RA, Star.Dec);
+    end;
+  finally
+    Dialog.Free;
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TFormAstromifs.LookAt(RA, Dec: Single);
+var
+  SinRA, CosRA, SinDec, CosDec: Single;
+  Direction: TGLVector;
+begin
+  // J2000 degrees to a direction on the sky dome, z to the north pole;
+  // CheckCamera sees the turn and schedules the frame
+  SinCosine(DegToRadian(RA), SinRA, CosRA);
+  SinCosine(DegToRadian(Dec), SinDec, CosDec);
+  Direction := SkyDome.LocalToAbsolute(VectorMake(CosDec * CosRA, CosDec * SinRA,
+    SinDec, 0));
+  Camera.PointTo(VectorAdd(Camera.AbsolutePosition, Direction), Camera.AbsoluteUp);
+end;
 
 //-----------------------------------------------------------------------
 
@@ -224,8 +492,55 @@ begin
   HandleKeys(deltaTime);
   GLUserInterface1.Mouselook;
   GLUserInterface1.MouseUpdate;
-  GLSceneViewer.Invalidate;
+  CheckCamera;
+  if (FLoader.Pending > 0) and (FLoader.Deliver(AssetDeliveryBudget) > 0) then
+  begin
+    FScheduler.MarkDirty(drAssets);
+    if FLoader.Pending = 0 then
+    begin
+      FAssetText := FLoader.SummaryText;
+      StatusBar1.Hint := Trim(FLoader.TimingText); // per asset, on hover
+    end;
+  end;
+  if FScheduler.ShouldRender then
+    GLSceneViewer.Invalidate;
+
+  // Keep polling input while idle, but stop spinning a core on it
+  if FScheduler.Idle then
+    GLCadencer.SleepLength := IdleSleepLength
+  else
+    GLCadencer.SleepLength := -1;
+end;
+
+//-----------------------------------------------------------------------
 
+procedure TFormAstromifs.CheckCamera;
+begin
+  // Keys, mouselook and the navigator all end up in the camera matrix
+  if not CompareMem(Camera.AbsoluteMatrixAsAddress, @FLastCameraMatrix,
+    SizeOf(FLastCameraMatrix)) or (Camera.FocalLength <> FLastFocalLength) then
+  begin
+    Move(Camera.AbsoluteMatrixAsAddress^, FLastCameraMatrix, SizeOf(FLastCameraMatrix));
+    FLastFocalLength := Camera.FocalLength;
+    FScheduler.MarkDirty(drCamera);
+  end;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TFormAstromifs.ViewerBeforeRender(Sender: TObject);
+begin
+  FScheduler.BeginFrame;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TFormAstromifs.ViewerAfterRender(Sender: TObject);
+begin
+  FScheduler.EndFrame;
+  StatusBar1.SimpleText := FScheduler.StatusText + ', ' + FThumbnails.StatsText;
+  if FAssetText <> '' then
+    StatusBar1.SimpleText := StatusBar1.SimpleText + ', ' + FAssetText;
 end;
 
 //-----------------------------------------------------------------------
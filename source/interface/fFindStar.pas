@@ -0,0 +1,160 @@
+unit fFindStar;
+//--------------------------------------------------
+// Find a star by name or designation and go to it
+//--------------------------------------------------
+
+interface
+
+uses
+  Winapi.Windows,
+  Winapi.Messages,
+  System.SysUtils,
+  System.Variants,
+  System.Classes,
+  Vcl.Graphics,
+  Vcl.Controls,
+  Vcl.Forms,
+  Vcl.Dialogs,
+  Vcl.StdCtrls,
+  Vcl.ExtCtrls,
+  //
+  uStarNames;
+
+type
+  TfrmFindStar = class(TForm)
+    PanelTop: TPanel;
+    edQuery: TEdit;
+    lbResults: TListBox;
+    PanelBottom: TPanel;
+    lblStatus: TLabel;
+    ButtonGoTo: TButton;
+    ButtonCancel: TButton;
+    procedure edQueryChange(Sender: TObject);
+    procedure edQueryKeyDown(Sender: TObject; var Key: Word; Shift: TShiftState);
+    procedure lbResultsClick(Sender: TObject);
+    procedure lbResultsDblClick(Sender: TObject);
+  private
+    FStarNames: TStarNameIndex;
+    FMatches: TArray<TStarNameMatch>;
+    function GetSelectedStar: Integer;
+    procedure SetStarNames(Value: TStarNameIndex);
+  public
+    property StarNames: TStarNameIndex read FStarNames write SetStarNames;
+    // into StarNames.Stars, -1 when nothing is selected
+    property SelectedStar: Integer read GetSelectedStar;
+  end;
+
+var
+  frmFindStar: TfrmFindStar;
+
+implementation
+
+{$R *.dfm}
+
+uses
+  System.Math,
+  System.Diagnostics;
+
+const
+  // rows the list shows for one query
+  MaxMatches = 50;
+
+//-----------------------------------------------------------------------
+
+function StarText(const Star: TStarName): string;
+begin
+  Result := Star.Name;
+  if Star.Aliases <> '' then
+    Result := Result + ' (' + Star.Aliases + ')';
+  if Star.Bayer <> '' then
+    Result := Result + '   ' + Star.Bayer;
+  if Star.Designation <> '' then
+    Result := Result + '   ' + Star.Designation;
+  if Star.HIP > 0 then
+    Result := Result + '   HIP ' + IntToStr(Star.HIP);
+  if not IsNan(Star.Magnitude) then
+    Result := Result + Format('   %.2f mag', [Star.Magnitude]);
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TfrmFindStar.SetStarNames(Value: TStarNameIndex);
+begin
+  FStarNames := Value;
+  edQueryChange(nil);
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TfrmFindStar.edQueryChange(Sender: TObject);
+var
+  Stopwatch: TStopwatch;
+  Match: TStarNameMatch;
+begin
+  lbResults.Items.BeginUpdate;
+  try
+    lbResults.Items.Clear;
+    FMatches := nil;
+    if FStarNames = nil then
+      Exit;
+    Stopwatch := TStopwatch.StartNew;
+    FMatches := FStarNames.Search(edQuery.Text, MaxMatches);
+    Stopwatch.Stop;
+    for Match in FMatches do
+      lbResults.Items.Add(StarText(FStarNames[Match.Star]));
+    if Length(FMatches) > 0 then
+      lbResults.ItemIndex := 0;
+    lblStatus.Caption := Format('%d stars, %d names: %d found in %.0f '#$B5's',
+      [FStarNames.StarCount, FStarNames.KeyCount, Length(FMatches),
+      Stopwatch.Elapsed.TotalMilliseconds * 1000]);
+  finally
+    lbResults.Items.EndUpdate;
+  end;
+  lbResultsClick(nil);
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TfrmFindStar.edQueryKeyDown(Sender: TObject; var Key: Word;
+  Shift: TShiftState);
+begin
+  // browse the results without leaving the edit box
+  case Key of
+    VK_DOWN:
+      lbResults.ItemIndex := Min(lbResults.ItemIndex + 1, lbResults.Count - 1);
+    VK_UP:
+      lbResults.ItemIndex := Max(lbResults.ItemIndex - 1, 0);
+  else
+    Exit;
+  end;
+  Key := 0;
+  lbResultsClick(nil);
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TfrmFindStar.lbResultsClick(Sender: TObject);
+begin
+  // stars known only by name and HIP number have nowhere to go yet
+  ButtonGoTo.Enabled := (SelectedStar >= 0) and FStarNames[SelectedStar].HasPosition;
+end;
+
+//-----------------------------------------------------------------------
+
+procedure TfrmFindStar.lbResultsDblClick(Sender: TObject);
+begin
+  if ButtonGoTo.Enabled then
+    ModalResult := mrOk;
+end;
+
+//-----------------------------------------------------------------------
+
+function TfrmFindStar.GetSelectedStar: Integer;
+begin
+  if (lbResults.ItemIndex >= 0) and (lbResults.ItemIndex < Length(FMatches)) then
+    Result := FMatches[lbResults.ItemIndex].Star
+  else
+    Result := -1;
+end;
+
+end.